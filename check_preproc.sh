@@ -0,0 +1,53 @@
+#!/bin/bash
+# Checks that tools/preproc still produces the same output as the preproc at
+# another revision (HEAD by default) for the data sources and the text-heavy C
+# sources. Run it through `make check-preproc`, which passes in CPP and
+# CPPFLAGS, before committing a change to preproc that shouldn't change what
+# it outputs.
+#
+# usage: check_preproc.sh [BASE_REVISION]
+
+set -e
+
+base="${1:-HEAD}"
+work=build/check_preproc
+preproc=tools/preproc/preproc
+
+# C sources with a lot of text and no INCBINs, which preproc can only expand
+# once the graphics they point to have been built.
+c_srcs="src/strings.c src/battle_message.c src/item.c src/battle_tower.c"
+
+rm -rf "$work"
+mkdir -p "$work/base_tree" "$work/base" "$work/new" "$work/new_cached" "$work/i"
+
+# preproc includes gflib/characters.h for the braille table.
+git archive "$base" tools/preproc gflib/characters.h | tar -x -C "$work/base_tree"
+make -s -C "$work/base_tree/tools/preproc"
+base_preproc="$work/base_tree/tools/preproc/preproc"
+
+# The build preprocesses the data sources in one batch, with a charmap cache.
+# Running the new preproc twice checks both a cold and a warm cache.
+"$base_preproc" -batch charmap.txt "$work/base" data/*.s
+"$preproc" -batch charmap.txt "$work/new" -cache "$work/charmap.cache" data/*.s
+"$preproc" -batch charmap.txt "$work/new_cached" -cache "$work/charmap.cache" data/*.s
+
+for src in $c_srcs
+do
+    name="$(basename "$src" .c)"
+    $CPP $CPPFLAGS "$src" -o "$work/i/$name.i"
+    "$base_preproc" "$work/i/$name.i" charmap.txt > "$work/base/$name.c"
+    "$preproc" "$work/i/$name.i" charmap.txt > "$work/new/$name.c"
+    cp "$work/new/$name.c" "$work/new_cached/$name.c"
+done
+
+status=0
+diff -r "$work/base" "$work/new" > "$work/diff.txt" || status=1
+diff -r "$work/base" "$work/new_cached" >> "$work/diff.txt" || status=1
+
+if [ $status -ne 0 ]
+then
+    echo "preproc's output differs from $base's, see $work/diff.txt"
+    exit 1
+fi
+
+echo "preproc's output matches $base's"
@@ -28,21 +28,36 @@ struct BgConfig2
 {
     u32 baseTile:10;
     u32 basePalette:4;
+    // Whether every write to the tilemap buffer goes through this file, so
+    // dirtyBands can be trusted.
+    u32 trackDirty:1;
 
     void *tilemap;
     s32 bg_x;
     s32 bg_y;
+    // The tilemap buffer is split into 32 equal bands (one tile row for a
+    // 256x256 text BG). A set bit means that band differs from VRAM.
+    u32 dirtyBands;
 };
 
+#define TILEMAP_BAND_COUNT 32
+#define TILEMAP_ALL_BANDS_DIRTY 0xFFFFFFFF
+
 static struct BgControl sGpuBgConfigs;
 static struct BgConfig2 sGpuBgConfigs2[NUM_BACKGROUNDS];
 static u32 sDmaBusyBitfield[NUM_BACKGROUNDS];
+// BGs whose dirty bands CopyPendingBgTilemapBandsToVram has to queue at the
+// end of the frame, so writes made later in the frame are copied too.
+static u32 sPendingBandCopies;
+static struct BgTilemapCopyStats sTilemapCopyStats;
 
 u32 gWindowTileAutoAllocEnabled;
 
 static const struct BgConfig sZeroedBgControlStruct = { 0 };
 
 static u32 GetBgType(u32 bg);
+static u32 GetTilemapBufferSize(u32 bg);
+static void MarkTilemapBufferDirty(u32 bg, u32 offset, u32 size);
 
 void ResetBgs(void)
 {
@@ -70,6 +85,7 @@ void ResetBgControlStructs(void)
     {
         sGpuBgConfigs.configs[i] = sZeroedBgControlStruct;
     }
+    sPendingBandCopies = 0;
 }
 
 void Unused_ResetBgControlStruct(u32 bg)
@@ -328,6 +344,7 @@ void InitBgsFromTemplates(u32 bgMode, const struct BgTemplate *templates, u8 num
             sGpuBgConfigs2[bg].basePalette = 0;
 
             sGpuBgConfigs2[bg].tilemap = NULL;
+            sGpuBgConfigs2[bg].trackDirty = FALSE;
             sGpuBgConfigs2[bg].bg_x = 0;
             sGpuBgConfigs2[bg].bg_y = 0;
         }
@@ -353,6 +370,8 @@ void InitBgFromTemplate(const struct BgTemplate *template)
         sGpuBgConfigs2[bg].basePalette = 0;
 
         sGpuBgConfigs2[bg].tilemap = NULL;
+        sGpuBgConfigs2[bg].trackDirty = FALSE;
+        sPendingBandCopies &= ~(1 << bg);
         sGpuBgConfigs2[bg].bg_x = 0;
         sGpuBgConfigs2[bg].bg_y = 0;
     }
@@ -399,6 +418,10 @@ u16 LoadBgTilemap(u32 bg, const void *src, u16 size, u16 destOffset)
 {
     u8 cursor = LoadBgVram(bg, src, size, destOffset * 2, DISPCNT_MODE_2);
 
+    // VRAM no longer matches the tilemap buffer.
+    if (!IsInvalidBg(bg))
+        sGpuBgConfigs2[bg].dirtyBands = TILEMAP_ALL_BANDS_DIRTY;
+
     if (cursor == 0xFF)
     {
         return -1;
@@ -476,9 +499,11 @@ void SetBgAttribute(u32 bg, u32 attributeId, u8 value)
         break;
     case BG_ATTR_MAPBASEINDEX:
         SetBgControlAttributes(bg, 0xFF, value, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF);
+        MarkBgTilemapBufferDirty(bg);
         break;
     case BG_ATTR_SCREENSIZE:
         SetBgControlAttributes(bg, 0xFF, 0xFF, value, 0xFF, 0xFF, 0xFF, 0xFF);
+        MarkBgTilemapBufferDirty(bg);
         break;
     case BG_ATTR_PALETTEMODE:
         SetBgControlAttributes(bg, 0xFF, 0xFF, 0xFF, value, 0xFF, 0xFF, 0xFF);
@@ -514,15 +539,7 @@ u16 GetBgAttribute(u32 bg, u32 attributeId)
     case BG_ATTR_WRAPAROUND:
         return GetBgControlAttribute(bg, BG_CTRL_ATTR_WRAPAROUND);
     case BG_ATTR_METRIC:
-        switch (GetBgType(bg))
-        {
-        case BG_TYPE_NORMAL:
-            return GetBgMetricTextMode(bg, 0) * 0x800;
-        case BG_TYPE_AFFINE:
-            return GetBgMetricAffineMode(bg, 0) * 0x100;
-        default:
-            return 0;
-        }
+        return GetTilemapBufferSize(bg);
     case BG_ATTR_TYPE:
         return GetBgType(bg);
     case BG_ATTR_BASETILE:
@@ -844,6 +861,9 @@ void SetBgTilemapBuffer(u32 bg, void *tilemap)
     if (!IsInvalidBg(bg) && GetBgControlAttribute(bg, BG_CTRL_ATTR_VISIBLE))
     {
         sGpuBgConfigs2[bg].tilemap = tilemap;
+        // The caller owns the buffer and may write to it directly.
+        sGpuBgConfigs2[bg].trackDirty = FALSE;
+        sGpuBgConfigs2[bg].dirtyBands = TILEMAP_ALL_BANDS_DIRTY;
     }
 }
 
@@ -852,6 +872,7 @@ void UnsetBgTilemapBuffer(u32 bg)
     if (!IsInvalidBg(bg) && GetBgControlAttribute(bg, BG_CTRL_ATTR_VISIBLE))
     {
         sGpuBgConfigs2[bg].tilemap = NULL;
+        sGpuBgConfigs2[bg].trackDirty = FALSE;
     }
 }
 
@@ -861,8 +882,151 @@ void *GetBgTilemapBuffer(u32 bg)
         return NULL;
     else if (!GetBgControlAttribute(bg, BG_CTRL_ATTR_VISIBLE))
         return NULL;
-    else
-        return sGpuBgConfigs2[bg].tilemap;
+
+    // The caller may write to the buffer behind our back, so go back to
+    // copying the whole tilemap.
+    sGpuBgConfigs2[bg].trackDirty = FALSE;
+    return sGpuBgConfigs2[bg].tilemap;
+}
+
+// Only for buffers that are never written to outside of this file (e.g. the
+// ones window.c allocates). CopyBgTilemapBufferToVram then only copies the
+// bands that changed since the last copy, once they're known at the end of
+// the frame.
+void EnableBgTilemapBufferDirtyTracking(u32 bg)
+{
+    if (!IsInvalidBg(bg) && !IsTileMapOutsideWram(bg))
+    {
+        sGpuBgConfigs2[bg].trackDirty = TRUE;
+        sGpuBgConfigs2[bg].dirtyBands = TILEMAP_ALL_BANDS_DIRTY;
+    }
+}
+
+// Forces the next CopyBgTilemapBufferToVram to copy the whole tilemap, e.g.
+// after VRAM was overwritten by other means.
+void MarkBgTilemapBufferDirty(u32 bg)
+{
+    if (!IsInvalidBg(bg))
+        sGpuBgConfigs2[bg].dirtyBands = TILEMAP_ALL_BANDS_DIRTY;
+}
+
+static u32 GetTilemapBufferSize(u32 bg)
+{
+    switch (GetBgType(bg))
+    {
+    case BG_TYPE_NORMAL:
+        return GetBgMetricTextMode(bg, 0) * 0x800;
+    case BG_TYPE_AFFINE:
+        return GetBgMetricAffineMode(bg, 0) * 0x100;
+    default:
+        return 0;
+    }
+}
+
+static u32 GetTilemapBandShift(u32 size)
+{
+    u32 shift = 0;
+
+    while ((TILEMAP_BAND_COUNT << shift) < size)
+        shift++;
+    return shift;
+}
+
+// offset and size are in bytes.
+static void MarkTilemapBufferDirty(u32 bg, u32 offset, u32 size)
+{
+    u32 shift, first, last;
+
+    if (!sGpuBgConfigs2[bg].trackDirty || size == 0)
+        return;
+
+    shift = GetTilemapBandShift(GetTilemapBufferSize(bg));
+    first = offset >> shift;
+    last = (offset + size - 1) >> shift;
+    if (first >= TILEMAP_BAND_COUNT)
+        return;
+    if (last >= TILEMAP_BAND_COUNT)
+        last = TILEMAP_BAND_COUNT - 1;
+
+    sGpuBgConfigs2[bg].dirtyBands |= ((2u << last) - 1) & ~((1u << first) - 1);
+}
+
+// Returns FALSE if the DMA queue filled up before every dirty band was queued.
+static bool32 CopyDirtyTilemapBandsToVram(u32 bg, u32 size)
+{
+    u32 shift = GetTilemapBandShift(size);
+    u32 dirty = sGpuBgConfigs2[bg].dirtyBands;
+    u32 band = 0, start, offset, runSize, runMask;
+    bool32 queuedAll = TRUE;
+
+    sGpuBgConfigs2[bg].dirtyBands = 0;
+
+    while (dirty != 0)
+    {
+        while (!(dirty & (1u << band)))
+            band++;
+        start = band;
+        while (band < TILEMAP_BAND_COUNT && (dirty & (1u << band)))
+            band++;
+
+        runMask = ((band < TILEMAP_BAND_COUNT) ? (1u << band) : 0) - (1u << start);
+        dirty &= ~runMask;
+
+        offset = start << shift;
+        runSize = (band - start) << shift;
+        if (LoadBgVram(bg, sGpuBgConfigs2[bg].tilemap + offset, runSize, offset, 2) == 0xFF)
+        {
+            sGpuBgConfigs2[bg].dirtyBands |= runMask; // the DMA queue is full, retry next time
+            queuedAll = FALSE;
+        }
+        else
+        {
+            sTilemapCopyStats.copiedBytes += runSize;
+        }
+    }
+    return queuedAll;
+}
+
+// Called by the main loop once the frame's callbacks have run, right before it
+// waits for VBlank. Like a full copy, whose DMA only reads the buffer at
+// VBlank, this picks up writes made after CopyBgTilemapBufferToVram in the
+// same frame. It has to run on the main thread, since the DMA request queue
+// can't be added to from an interrupt.
+void CopyPendingBgTilemapBandsToVram(void)
+{
+    u32 bg;
+
+    for (bg = 0; bg < NUM_BACKGROUNDS; bg++)
+    {
+        if (!(sPendingBandCopies & (1 << bg)))
+            continue;
+        sPendingBandCopies &= ~(1 << bg);
+        if (IsTileMapOutsideWram(bg))
+            continue;
+
+        if (!sGpuBgConfigs2[bg].trackDirty)
+        {
+            // The buffer was handed out since the copy was requested.
+            LoadBgVram(bg, sGpuBgConfigs2[bg].tilemap, GetTilemapBufferSize(bg), 0, 2);
+            sGpuBgConfigs2[bg].dirtyBands = 0;
+            sTilemapCopyStats.copiedBytes += GetTilemapBufferSize(bg);
+        }
+        else if (!CopyDirtyTilemapBandsToVram(bg, GetTilemapBufferSize(bg)))
+        {
+            sPendingBandCopies |= 1 << bg;
+        }
+    }
+}
+
+const struct BgTilemapCopyStats *GetBgTilemapCopyStats(void)
+{
+    return &sTilemapCopyStats;
+}
+
+void ResetBgTilemapCopyStats(void)
+{
+    sTilemapCopyStats.requestedBytes = 0;
+    sTilemapCopyStats.copiedBytes = 0;
 }
 
 void CopyToBgTilemapBuffer(u32 bg, const void *src, u16 mode, u16 destOffset)
@@ -873,6 +1037,8 @@ void CopyToBgTilemapBuffer(u32 bg, const void *src, u16 mode, u16 destOffset)
             CpuCopy16(src, (void *)(sGpuBgConfigs2[bg].tilemap + (destOffset * 2)), mode);
         else
             LZ77UnCompWram(src, (void *)(sGpuBgConfigs2[bg].tilemap + (destOffset * 2)));
+        // The decompressed size isn't known up front.
+        MarkTilemapBufferDirty(bg, destOffset * 2, (mode != 0) ? mode : GetTilemapBufferSize(bg));
     }
 }
 
@@ -882,19 +1048,19 @@ void CopyBgTilemapBufferToVram(u32 bg)
 
     if (!IsInvalidBg(bg) && !IsTileMapOutsideWram(bg))
     {
-        switch (GetBgType(bg))
+        sizeToLoad = GetTilemapBufferSize(bg);
+        sTilemapCopyStats.requestedBytes += sizeToLoad;
+        if (sGpuBgConfigs2[bg].trackDirty)
         {
-        case BG_TYPE_NORMAL:
-            sizeToLoad = GetBgMetricTextMode(bg, 0) * 0x800;
-            break;
-        case BG_TYPE_AFFINE:
-            sizeToLoad = GetBgMetricAffineMode(bg, 0) * 0x100;
-            break;
-        default:
-            sizeToLoad = 0;
-            break;
+            sPendingBandCopies |= 1 << bg;
+        }
+        else
+        {
+            LoadBgVram(bg, sGpuBgConfigs2[bg].tilemap, sizeToLoad, 0, 2);
+            sGpuBgConfigs2[bg].dirtyBands = 0;
+            sPendingBandCopies &= ~(1 << bg);
+            sTilemapCopyStats.copiedBytes += sizeToLoad;
         }
-        LoadBgVram(bg, sGpuBgConfigs2[bg].tilemap, sizeToLoad, 0, 2);
     }
 }
 
@@ -918,6 +1084,7 @@ void CopyToBgTilemapBufferRect(u32 bg, const void *src, u8 destX, u8 destY, u8 w
                     ((u16 *)sGpuBgConfigs2[bg].tilemap)[((destY16 * 0x20) + destX16)] = *srcCopy++;
                 }
             }
+            MarkTilemapBufferDirty(bg, ((destY * 0x20) + destX) * 2, ((height - 1) * 0x20 + width) * 2);
             break;
         }
         case BG_TYPE_AFFINE:
@@ -931,6 +1098,7 @@ void CopyToBgTilemapBufferRect(u32 bg, const void *src, u8 destX, u8 destY, u8 w
                     ((u8 *)sGpuBgConfigs2[bg].tilemap)[((destY16 * mode) + destX16)] = *srcCopy++;
                 }
             }
+            MarkTilemapBufferDirty(bg, (destY * mode) + destX, (height - 1) * mode + width);
             break;
         }
         }
@@ -960,6 +1128,9 @@ void CopyRectToBgTilemapBufferRect(u32 bg, const void *src, u8 srcX, u8 srcY, u8
             srcPtr = src + ((srcY * srcWidth) + srcX) * 2;
             for (i = destY; i < (destY + rectHeight); i++)
             {
+                // A row can wrap into the next screenblock, so mark both ends.
+                MarkTilemapBufferDirty(bg, GetTileMapIndexFromCoords(destX, i, screenSize, screenWidth, screenHeight) * 2, 2);
+                MarkTilemapBufferDirty(bg, GetTileMapIndexFromCoords(destX + rectWidth - 1, i, screenSize, screenWidth, screenHeight) * 2, 2);
                 for (j = destX; j < (destX + rectWidth); j++)
                 {
                     u16 index = GetTileMapIndexFromCoords(j, i, screenSize, screenWidth, screenHeight);
@@ -981,6 +1152,7 @@ void CopyRectToBgTilemapBufferRect(u32 bg, const void *src, u8 srcX, u8 srcY, u8
                 }
                 srcPtr += (srcWidth - rectWidth);
             }
+            MarkTilemapBufferDirty(bg, (var * destY) + destX, (rectHeight - 1) * var + rectWidth);
             break;
         }
     }
@@ -1004,6 +1176,7 @@ void FillBgTilemapBufferRect_Palette0(u32 bg, u16 tileNum, u8 x, u8 y, u8 width,
                     ((u16 *)sGpuBgConfigs2[bg].tilemap)[((y16 * 0x20) + x16)] = tileNum;
                 }
             }
+            MarkTilemapBufferDirty(bg, ((y * 0x20) + x) * 2, ((height - 1) * 0x20 + width) * 2);
             break;
         case BG_TYPE_AFFINE:
             mode = GetBgMetricAffineMode(bg, 0x1);
@@ -1014,6 +1187,7 @@ void FillBgTilemapBufferRect_Palette0(u32 bg, u16 tileNum, u8 x, u8 y, u8 width,
                     ((u8 *)sGpuBgConfigs2[bg].tilemap)[((y16 * mode) + x16)] = tileNum;
                 }
             }
+            MarkTilemapBufferDirty(bg, (y * mode) + x, (height - 1) * mode + width);
             break;
         }
     }
@@ -1042,6 +1216,9 @@ void WriteSequenceToBgTilemapBuffer(u32 bg, u16 firstTileNum, u8 x, u8 y, u8 wid
         case BG_TYPE_NORMAL:
             for (y16 = y; y16 < (y + height); y16++)
             {
+                // A row can wrap into the next screenblock, so mark both ends.
+                MarkTilemapBufferDirty(bg, GetTileMapIndexFromCoords(x, y16, attribute, mode, mode2) * 2, 2);
+                MarkTilemapBufferDirty(bg, GetTileMapIndexFromCoords(x + width - 1, y16, attribute, mode, mode2) * 2, 2);
                 for (x16 = x; x16 < (x + width); x16++)
                 {
                     CopyTileMapEntry(&firstTileNum, &((u16 *)sGpuBgConfigs2[bg].tilemap)[(u16)GetTileMapIndexFromCoords(x16, y16, attribute, mode, mode2)], paletteSlot, 0, 0);
@@ -1059,6 +1236,7 @@ void WriteSequenceToBgTilemapBuffer(u32 bg, u16 firstTileNum, u8 x, u8 y, u8 wid
                     firstTileNum = (firstTileNum & 0xFC00) + ((firstTileNum + tileNumDelta) & 0x3FF);
                 }
             }
+            MarkTilemapBufferDirty(bg, (y * mode3) + x, (height - 1) * mode3 + width);
             break;
         }
     }
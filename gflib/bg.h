@@ -39,6 +39,15 @@ enum {
     BG_MOSAIC_SUB_V,
 };
 
+// Bytes CopyBgTilemapBufferToVram was asked to copy versus bytes actually
+// queued after skipping unchanged bands of dirty-tracked tilemaps. Those bands
+// are only queued at the end of the frame, by CopyPendingBgTilemapBandsToVram.
+struct BgTilemapCopyStats
+{
+    u32 requestedBytes;
+    u32 copiedBytes;
+};
+
 struct BgTemplate
 {
     u16 bg:2;                   // 0x1, 0x2 -> 0x3
@@ -80,8 +89,13 @@ u8 Unused_AdjustBgMosaic(u8 val, u32 mode);
 void SetBgTilemapBuffer(u32 bg, void *tilemap);
 void UnsetBgTilemapBuffer(u32 bg);
 void *GetBgTilemapBuffer(u32 bg);
+void EnableBgTilemapBufferDirtyTracking(u32 bg);
+void MarkBgTilemapBufferDirty(u32 bg);
+const struct BgTilemapCopyStats *GetBgTilemapCopyStats(void);
+void ResetBgTilemapCopyStats(void);
 void CopyToBgTilemapBuffer(u32 bg, const void *src, u16 mode, u16 destOffset);
 void CopyBgTilemapBufferToVram(u32 bg);
+void CopyPendingBgTilemapBandsToVram(void);
 void CopyToBgTilemapBufferRect(u32 bg, const void *src, u8 destX, u8 destY, u8 width, u8 height);
 void CopyToBgTilemapBufferRect_ChangePalette(u32 bg, const void *src, u8 destX, u8 destY, u8 rectWidth, u8 rectHeight, u8 palette);
 void CopyRectToBgTilemapBufferRect(u32 bg, const void *src, u8 srcX, u8 srcY, u8 srcWidth, u8 srcHeight, u8 destX, u8 destY, u8 rectWidth, u8 rectHeight, u8 palette1, s16 tileOffset, s16 palette2);
@@ -46,10 +46,26 @@
 #define Dma3FillLarge16_(value, dest, size) Dma3FillLarge_(value, dest, size, 16)
 #define Dma3FillLarge32_(value, dest, size) Dma3FillLarge_(value, dest, size, 32)
 
+// Statistics about ProcessDma3Requests, used to find screens whose VBlank
+// transfers don't fit in VBlank.
+struct Dma3Stats
+{
+    u32 lastFrameBytes;    // Bytes sent during the most recent VBlank.
+    u32 lastFrameBudget;   // Bytes the most recent VBlank had room for.
+    u16 lastFrameRequests; // Requests sent during the most recent VBlank.
+    u16 lastFrameDeferred; // Requests left queued for the next VBlank.
+    u16 peakDeferred;      // Most requests ever left queued after a VBlank.
+    u16 deferredFrames;    // VBlanks that left at least one request queued.
+    u32 merged;            // Requests merged into an adjacent queued request.
+    u32 totalBytes;
+};
+
 void ClearDma3Requests(void);
 void ProcessDma3Requests(void);
 s16 RequestDma3Copy(const void *src, void *dest, u16 size, u32 mode);
 s16 RequestDma3Fill(s32 value, void *dest, u16 size, u32 mode);
 s16 CheckForSpaceForDma3Request(s16 index);
+const struct Dma3Stats *GetDma3Stats(void);
+void ResetDma3Stats(void);
 
 #endif // GUARD_DMA3_H
@@ -17,10 +17,22 @@ struct Dma3Request
     u32 value;
 };
 
+// VBlank ends after line 227; stop a few lines early to leave time for the
+// rest of the VBlank handler.
+#define DMA3_LAST_VBLANK_LINE 224
+
+// Roughly the old flat 40 KiB cap spread over the VBlank lines.
+#define DMA3_BYTES_PER_SCANLINE 600
+
+// Adjacent requests are merged up to this size. Keeping it well under a full
+// VBlank's budget means a merged request can't hog a frame.
+#define DMA3_MAX_MERGED_SIZE 0x2000
+
 static struct Dma3Request sDma3Requests[MAX_DMA_REQUESTS];
 
 static vbool8 sDma3ManagerLocked;
 static u8 sDma3RequestCursor;
+static struct Dma3Stats sDma3Stats;
 
 void ClearDma3Requests(void)
 {
@@ -39,24 +51,47 @@ void ClearDma3Requests(void)
     sDma3ManagerLocked = FALSE;
 }
 
+// Returns how many bytes can still be sent this VBlank, assuming roughly
+// DMA3_BYTES_PER_SCANLINE per remaining line before DMA3_LAST_VBLANK_LINE.
+static u32 GetDma3VBlankBudget(void)
+{
+    u32 vcount = REG_VCOUNT & 0xFF;
+
+    // Called outside of VBlank (e.g. a lag frame); allow a full VBlank's worth.
+    if (vcount < DISPLAY_HEIGHT)
+        vcount = DISPLAY_HEIGHT;
+    if (vcount > DMA3_LAST_VBLANK_LINE)
+        return 0;
+    return (DMA3_LAST_VBLANK_LINE - vcount + 1) * DMA3_BYTES_PER_SCANLINE;
+}
+
 void ProcessDma3Requests(void)
 {
-    u16 bytesTransferred;
+    u32 bytesTransferred;
+    u32 budget;
+    u32 transferred;
+    u32 deferred;
+    int i;
 
     if (sDma3ManagerLocked)
         return;
 
     bytesTransferred = 0;
+    transferred = 0;
+    budget = GetDma3VBlankBudget();
 
     // as long as there are DMA requests to process (unless size or vblank is an issue), do not exit
     while (sDma3Requests[sDma3RequestCursor].size != 0)
     {
-        bytesTransferred += sDma3Requests[sDma3RequestCursor].size;
+        // Always let the first request through so that a request bigger than
+        // the budget can't stall the queue forever.
+        if (bytesTransferred != 0 && bytesTransferred + sDma3Requests[sDma3RequestCursor].size > budget)
+            break; // out of VBlank time for this frame
+        if (*(u8 *)REG_ADDR_VCOUNT > DMA3_LAST_VBLANK_LINE)
+            break; // we're about to leave vblank, stop
 
-        if (bytesTransferred > 40 * 1024)
-            return; // don't transfer more than 40 KiB
-        if (*(u8 *)REG_ADDR_VCOUNT > 224)
-            return; // we're about to leave vblank, stop
+        bytesTransferred += sDma3Requests[sDma3RequestCursor].size;
+        transferred++;
 
         switch (sDma3Requests[sDma3RequestCursor].mode)
         {
@@ -93,12 +128,66 @@ void ProcessDma3Requests(void)
         if (sDma3RequestCursor >= MAX_DMA_REQUESTS) // loop back to the first DMA request
             sDma3RequestCursor = 0;
     }
+
+    // Whatever is left in the queue is deferred to the next frame.
+    deferred = 0;
+    for (i = sDma3RequestCursor; sDma3Requests[i].size != 0 && deferred < MAX_DMA_REQUESTS; i = (i + 1) % MAX_DMA_REQUESTS)
+        deferred++;
+
+    sDma3Stats.lastFrameBytes = bytesTransferred;
+    sDma3Stats.lastFrameBudget = budget;
+    sDma3Stats.lastFrameRequests = transferred;
+    sDma3Stats.lastFrameDeferred = deferred;
+    sDma3Stats.totalBytes += bytesTransferred;
+    if (deferred != 0)
+        sDma3Stats.deferredFrames++;
+    if (deferred > sDma3Stats.peakDeferred)
+        sDma3Stats.peakDeferred = deferred;
+}
+
+// Tries to extend the most recently queued request so that it also covers
+// [dest, dest + size). Only requests that haven't started yet are touched,
+// since the manager is locked while requests are queued.
+static s16 TryMergeDma3Request(int cursor, const void *src, void *dest, u16 size, u16 mode, u32 value)
+{
+    struct Dma3Request *prev;
+
+    if (--cursor < 0)
+        cursor = MAX_DMA_REQUESTS - 1;
+    prev = &sDma3Requests[cursor];
+
+    if (prev->size == 0 || prev->mode != mode || (prev->size & 3))
+        return -1;
+    if (prev->size + size > DMA3_MAX_MERGED_SIZE)
+        return -1;
+    if (prev->dest + prev->size != dest)
+        return -1;
+
+    switch (mode)
+    {
+    case DMA_REQUEST_COPY32:
+    case DMA_REQUEST_COPY16:
+        if (prev->src + prev->size != src)
+            return -1;
+        break;
+    case DMA_REQUEST_FILL32:
+    case DMA_REQUEST_FILL16:
+        if (prev->value != value)
+            return -1;
+        break;
+    }
+
+    prev->size += size;
+    sDma3Stats.merged++;
+    return cursor;
 }
 
 s16 RequestDma3Copy(const void *src, void *dest, u16 size, u32 mode)
 {
     int cursor;
     int i = 0;
+    u16 requestMode = (mode == 1) ? DMA_REQUEST_COPY32 : DMA_REQUEST_COPY16;
+    s16 merged;
 
     sDma3ManagerLocked = TRUE;
     cursor = sDma3RequestCursor;
@@ -107,14 +196,17 @@ s16 RequestDma3Copy(const void *src, void *dest, u16 size, u32 mode)
     {
         if (sDma3Requests[cursor].size == 0) // an empty request was found.
         {
+            // Contiguous with the previous request, just extend it.
+            if ((merged = TryMergeDma3Request(cursor, src, dest, size, requestMode, 0)) != -1)
+            {
+                sDma3ManagerLocked = FALSE;
+                return merged;
+            }
+
             sDma3Requests[cursor].src = src;
             sDma3Requests[cursor].dest = dest;
             sDma3Requests[cursor].size = size;
-
-            if (mode == 1)
-                sDma3Requests[cursor].mode = DMA_REQUEST_COPY32;
-            else
-                sDma3Requests[cursor].mode = DMA_REQUEST_COPY16;
+            sDma3Requests[cursor].mode = requestMode;
 
             sDma3ManagerLocked = FALSE;
             return cursor;
@@ -131,6 +223,8 @@ s16 RequestDma3Fill(s32 value, void *dest, u16 size, u32 mode)
 {
     int cursor;
     int i = 0;
+    u16 requestMode = (mode == 1) ? DMA_REQUEST_FILL32 : DMA_REQUEST_FILL16;
+    s16 merged;
 
     cursor = sDma3RequestCursor;
     sDma3ManagerLocked = TRUE;
@@ -139,16 +233,18 @@ s16 RequestDma3Fill(s32 value, void *dest, u16 size, u32 mode)
     {
         if (sDma3Requests[cursor].size == 0) // an empty request was found.
         {
+            // Contiguous with the previous fill of the same value, just extend it.
+            if ((merged = TryMergeDma3Request(cursor, NULL, dest, size, requestMode, value)) != -1)
+            {
+                sDma3ManagerLocked = FALSE;
+                return merged;
+            }
+
             sDma3Requests[cursor].dest = dest;
             sDma3Requests[cursor].size = size;
-            sDma3Requests[cursor].mode = mode;
+            sDma3Requests[cursor].mode = requestMode;
             sDma3Requests[cursor].value = value;
 
-            if(mode == 1)
-                sDma3Requests[cursor].mode = DMA_REQUEST_FILL32;
-            else
-                sDma3Requests[cursor].mode = DMA_REQUEST_FILL16;
-
             sDma3ManagerLocked = FALSE;
             return cursor;
         }
@@ -181,3 +277,13 @@ s16 CheckForSpaceForDma3Request(s16 index)
         return 0;
     }
 }
+
+const struct Dma3Stats *GetDma3Stats(void)
+{
+    return &sDma3Stats;
+}
+
+void ResetDma3Stats(void)
+{
+    CpuFill32(0, &sDma3Stats, sizeof(sDma3Stats));
+}
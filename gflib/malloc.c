@@ -6,6 +6,7 @@
 
 static void *sHeapStart;
 static u32 sHeapSize;
+static struct Arena *sArenaTop;
 
 ALIGNED(4) EWRAM_DATA u8 gHeap[HEAP_SIZE] = {0};
 
@@ -193,6 +194,7 @@ void InitHeap(void *heapStart, u32 heapSize)
 {
     sHeapStart = heapStart;
     sHeapSize = heapSize;
+    sArenaTop = NULL;
     PutFirstMemBlockHeader(heapStart, heapSize);
 }
 
@@ -229,6 +231,122 @@ bool32 CheckHeap()
     return TRUE;
 }
 
+bool32 ArenaOpen_(struct Arena *arena, u32 size, const char *location)
+{
+    if (size & 3)
+        size = 4 * ((size / 4) + 1);
+
+    arena->base = AllocInternal(sHeapStart, size, location);
+    arena->size = 0;
+    arena->used = 0;
+    arena->parent = NULL;
+    arena->location = location;
+
+    if (arena->base == NULL)
+        return FALSE;
+
+    arena->size = size;
+    arena->parent = sArenaTop;
+    sArenaTop = arena;
+    return TRUE;
+}
+
+void *ArenaAlloc(struct Arena *arena, u32 size)
+{
+    void *mem;
+
+    if (arena->base == NULL)
+    {
+#if TESTING
+        Test_ExitWithResult(TEST_RESULT_ERROR, "Allocating %d bytes from a closed arena", size);
+#endif
+        return NULL;
+    }
+
+    if (size & 3)
+        size = 4 * ((size / 4) + 1);
+
+    if (size > arena->size - arena->used)
+    {
+#if TESTING
+        Test_ExitWithResult(TEST_RESULT_ERROR, "%s: arena OOM allocating %d bytes (%d/%d used)", arena->location, size, arena->used, arena->size);
+#endif
+        return NULL;
+    }
+
+    mem = arena->base + arena->used;
+    arena->used += size;
+    return mem;
+}
+
+void *ArenaAllocZeroed(struct Arena *arena, u32 size)
+{
+    void *mem = ArenaAlloc(arena, size);
+
+    if (mem != NULL)
+    {
+        if (size & 3)
+            size = 4 * ((size / 4) + 1);
+
+        CpuFill32(0, mem, size);
+    }
+
+    return mem;
+}
+
+// Returns a position that ArenaRewind can later return the arena to, which
+// releases everything allocated in between. Used for scratch buffers.
+u32 ArenaMark(const struct Arena *arena)
+{
+    return arena->used;
+}
+
+void ArenaRewind(struct Arena *arena, u32 mark)
+{
+#if TESTING
+    if (mark > arena->used)
+        Test_ExitWithResult(TEST_RESULT_ERROR, "%s: rewinding arena forwards (%d > %d)", arena->location, mark, arena->used);
+#endif
+    arena->used = mark;
+}
+
+void ArenaClose(struct Arena *arena)
+{
+    struct Arena **link;
+
+    if (arena->base == NULL)
+        return;
+
+#if TESTING
+    // Closing an arena while one opened after it is still alive means the
+    // inner arena's allocations outlive the screen that owns them.
+    if (sArenaTop != arena)
+        Test_ExitWithResult(TEST_RESULT_ERROR, "%s: arena closed before inner arena %s", arena->location, sArenaTop ? sArenaTop->location : "<none>");
+    if (!CheckMemBlockInternal(sHeapStart, arena->base))
+        Test_ExitWithResult(TEST_RESULT_ERROR, "%s: arena heap block corrupted", arena->location);
+#endif
+
+    for (link = &sArenaTop; *link != NULL; link = &(*link)->parent)
+    {
+        if (*link == arena)
+        {
+            *link = arena->parent;
+            break;
+        }
+    }
+
+    FreeInternal(sHeapStart, arena->base);
+    arena->base = NULL;
+    arena->size = 0;
+    arena->used = 0;
+    arena->parent = NULL;
+}
+
+bool32 ArenaIsOpen(const struct Arena *arena)
+{
+    return arena->base != NULL;
+}
+
 const struct MemBlock *HeapHead(void)
 {
     return (const struct MemBlock *)sHeapStart;
@@ -41,6 +41,19 @@ struct MemBlock
     u8 data[0];
 };
 
+// A bump allocator carved out of a single heap block. Screens open one on
+// entry, allocate their state from it, and close it on exit, which returns
+// every allocation to the heap at once.
+struct Arena
+{
+    u8 *base;
+    u32 size;
+    u32 used;
+    // The arena that was innermost when this one was opened.
+    struct Arena *parent;
+    const char *location;
+};
+
 #define HEAP_SIZE 0x1C000
 extern u8 gHeap[HEAP_SIZE];
 
@@ -48,11 +61,13 @@ extern u8 gHeap[HEAP_SIZE];
 
 #define Alloc(size) Alloc_(size, __FILE__ ":" STR(__LINE__))
 #define AllocZeroed(size) AllocZeroed_(size, __FILE__ ":" STR(__LINE__))
+#define ArenaOpen(arena, size) ArenaOpen_(arena, size, __FILE__ ":" STR(__LINE__))
 
 #else
 
 #define Alloc(size) Alloc_(size, NULL)
 #define AllocZeroed(size) AllocZeroed_(size, NULL)
+#define ArenaOpen(arena, size) ArenaOpen_(arena, size, NULL)
 
 #endif
 
@@ -61,6 +76,14 @@ void *AllocZeroed_(u32 size, const char *location);
 void Free(void *pointer);
 void InitHeap(void *pointer, u32 size);
 
+bool32 ArenaOpen_(struct Arena *arena, u32 size, const char *location);
+void *ArenaAlloc(struct Arena *arena, u32 size);
+void *ArenaAllocZeroed(struct Arena *arena, u32 size);
+u32 ArenaMark(const struct Arena *arena);
+void ArenaRewind(struct Arena *arena, u32 mark);
+void ArenaClose(struct Arena *arena);
+bool32 ArenaIsOpen(const struct Arena *arena);
+
 const struct MemBlock *HeapHead(void);
 const char *MemBlockLocation(const struct MemBlock *block);
 
@@ -267,6 +267,7 @@ EWRAM_DATA struct Sprite gSprites[MAX_SPRITES + 1] = {0};
 EWRAM_DATA static u8 sSpriteOrder[MAX_SPRITES] = {0};
 EWRAM_DATA static bool8 sShouldProcessSpriteCopyRequests = 0;
 EWRAM_DATA static u8 sSpriteCopyRequestCount = 0;
+EWRAM_DATA static bool8 sSkipSpriteFrameImageCopies = FALSE;
 EWRAM_DATA static struct SpriteCopyRequest sSpriteCopyRequests[MAX_SPRITES] = {0};
 EWRAM_DATA u8 gOamLimit = 0;
 static EWRAM_DATA u8 sOamDummyIndex = 0;
@@ -737,6 +738,9 @@ void ProcessSpriteCopyRequests(void)
 
 void RequestSpriteFrameImageCopy(u16 index, u16 tileNum, const struct SpriteFrameImage *images)
 {
+    if (sSkipSpriteFrameImageCopies)
+        return;
+
     if (sSpriteCopyRequestCount < MAX_SPRITE_COPY_REQUESTS)
     {
         if (!images[0].relativeFrames)
@@ -850,6 +854,38 @@ void AnimateSprite(struct Sprite *sprite)
         sAffineAnimFuncs[sprite->affineAnimBeginning](sprite);
 }
 
+// Advances a sprite's anim as if AnimateSprite had been called that many
+// times, but only copies the image of the frame it ends up on. Whole loops of
+// the anim are skipped. Affine anims aren't advanced.
+void AdvanceSpriteAnim(struct Sprite *sprite, u32 frames)
+{
+    u32 i;
+    u8 cmdIndex = sprite->animCmdIndex;
+    u8 delayCounter = sprite->animDelayCounter;
+    u8 loopCounter = sprite->animLoopCounter;
+    bool32 canSkipLoops = !sprite->animBeginning;
+
+    sSkipSpriteFrameImageCopies = TRUE;
+    for (i = 0; i < frames && !sprite->animEnded; i++)
+    {
+        sAnimFuncs[sprite->animBeginning](sprite);
+
+        if (canSkipLoops
+         && sprite->animCmdIndex == cmdIndex
+         && sprite->animDelayCounter == delayCounter
+         && sprite->animLoopCounter == loopCounter)
+        {
+            // The anim is back where it started, so it repeats every i + 1 frames.
+            frames = i + 1 + (frames - i - 1) % (i + 1);
+            canSkipLoops = FALSE;
+        }
+    }
+    sSkipSpriteFrameImageCopies = FALSE;
+
+    if (!sprite->usingSheet && sprite->anims[sprite->animNum][sprite->animCmdIndex].frame.imageValue != -1)
+        RequestSpriteFrameImageCopy(sprite->anims[sprite->animNum][sprite->animCmdIndex].frame.imageValue, sprite->oam.tileNum, sprite->images);
+}
+
 void BeginAnim(struct Sprite *sprite)
 {
     s16 imageValue;
@@ -53,6 +53,27 @@ static u16 sLastTextBgColor;
 static u16 sLastTextFgColor;
 static u16 sLastTextShadowColor;
 
+// Already-colored glyphs, so that dialogue and menus that reuse the same few
+// dozen glyphs don't decompress them again. Only glyphs up to 8 pixels wide
+// are cached, which is nearly all of the Latin glyphs.
+#define GLYPH_CACHE_SETS 8
+#define GLYPH_CACHE_WAYS 4
+#define GLYPH_CACHE_VALID (1u << 31)
+
+struct CachedGlyph
+{
+    u32 key;
+    u16 colors;
+    u16 lastUsed;
+    u8 width;
+    u8 height;
+    u32 top[8];
+    u32 bottom[8];
+};
+
+static EWRAM_DATA struct CachedGlyph sGlyphCache[GLYPH_CACHE_SETS][GLYPH_CACHE_WAYS] = {0};
+static EWRAM_DATA u16 sGlyphCacheTick = 0;
+
 const struct FontInfo *gFonts;
 bool8 gDisableTextPrinters;
 struct TextGlyph gCurGlyph;
@@ -612,6 +633,69 @@ void DecompressGlyphTile(const void *src_, void *dest_)
     *(dest++) = ((sFontHalfRowLookupTable[sFontHalfRowOffsets[temp & 0xFF]]) << 16) | (sFontHalfRowLookupTable[sFontHalfRowOffsets[temp >> 8]]);
 }
 
+void ResetGlyphCache(void)
+{
+    CpuFill32(0, sGlyphCache, sizeof(sGlyphCache));
+    sGlyphCacheTick = 0;
+}
+
+static inline u32 GetGlyphCacheKey(u32 fontId, u32 glyphId, bool32 isJapanese)
+{
+    return GLYPH_CACHE_VALID | glyphId | (fontId << 16) | (isJapanese ? (1 << 24) : 0);
+}
+
+static inline u32 GetGlyphCacheColors(void)
+{
+    return sLastTextFgColor | (sLastTextBgColor << 4) | (sLastTextShadowColor << 8);
+}
+
+// Loads the glyph into gCurGlyph if it's cached with the current colors.
+static bool32 LoadCachedGlyph(u32 fontId, u32 glyphId, bool32 isJapanese)
+{
+    u32 i;
+    u32 key = GetGlyphCacheKey(fontId, glyphId, isJapanese);
+    u32 colors = GetGlyphCacheColors();
+    struct CachedGlyph *set = sGlyphCache[glyphId % GLYPH_CACHE_SETS];
+
+    for (i = 0; i < GLYPH_CACHE_WAYS; i++)
+    {
+        if (set[i].key == key && set[i].colors == colors)
+        {
+            set[i].lastUsed = ++sGlyphCacheTick;
+            CpuFastCopy(set[i].top, gCurGlyph.gfxBufferTop, sizeof(set[i].top));
+            CpuFastCopy(set[i].bottom, gCurGlyph.gfxBufferBottom, sizeof(set[i].bottom));
+            gCurGlyph.width = set[i].width;
+            gCurGlyph.height = set[i].height;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+// Stores gCurGlyph in place of the least recently used glyph in its set.
+static void StoreCachedGlyph(u32 fontId, u32 glyphId, bool32 isJapanese)
+{
+    u32 i, oldest = 0;
+    struct CachedGlyph *set = sGlyphCache[glyphId % GLYPH_CACHE_SETS];
+
+    if (gCurGlyph.width > 8)
+        return;
+
+    for (i = 1; i < GLYPH_CACHE_WAYS; i++)
+    {
+        if ((u16)(sGlyphCacheTick - set[i].lastUsed) > (u16)(sGlyphCacheTick - set[oldest].lastUsed))
+            oldest = i;
+    }
+
+    set[oldest].key = GetGlyphCacheKey(fontId, glyphId, isJapanese);
+    set[oldest].colors = GetGlyphCacheColors();
+    set[oldest].lastUsed = ++sGlyphCacheTick;
+    set[oldest].width = gCurGlyph.width;
+    set[oldest].height = gCurGlyph.height;
+    CpuFastCopy(gCurGlyph.gfxBufferTop, set[oldest].top, sizeof(set[oldest].top));
+    CpuFastCopy(gCurGlyph.gfxBufferBottom, set[oldest].bottom, sizeof(set[oldest].bottom));
+}
+
 static u8 UNUSED GetLastTextColor(u8 colorType)
 {
     switch (colorType)
@@ -627,26 +711,38 @@ static u8 UNUSED GetLastTextColor(u8 colorType)
     }
 }
 
+// Copies one row of up to 8 glyph pixels at a time. Each row is a whole
+// 4bpp tile row, so it's merged into the window with a 32-bit mask of its
+// non-transparent pixels, split across two tiles when j isn't tile-aligned.
 inline static void GLYPH_COPY(u8 *windowTiles, u32 widthOffset, u32 j, u32 i, u32 *glyphPixels, s32 width, s32 height)
 {
-    u32 xAdd, yAdd, pixelData, bits, toOrr, dummyX;
-    u8 *dst;
+    u32 yAdd, pixelData, mask, widthMask, shift;
+    u32 *dst;
 
-    xAdd = j + width;
+    if (width <= 0 || height <= 0)
+        return;
+
+    widthMask = (width >= 8) ? 0xFFFFFFFF : ((1u << (width * 4)) - 1);
+    shift = (j % 8) * 4;
+    windowTiles += (j / 8) * 32;
     yAdd = i + height;
-    dummyX = j;
     for (; i < yAdd; i++)
     {
-        pixelData = *glyphPixels++;
-        for (j = dummyX; j < xAdd; j++)
+        pixelData = *glyphPixels++ & widthMask;
+        if (pixelData == 0)
+            continue;
+
+        // Set every bit of each non-zero pixel.
+        mask = pixelData | (pixelData >> 1);
+        mask |= mask >> 2;
+        mask = (mask & 0x11111111) * 0xF;
+
+        dst = (u32 *)(windowTiles + ((i / 8) * widthOffset) + ((i % 8) * 4));
+        *dst = (*dst & ~(mask << shift)) | (pixelData << shift);
+        if (shift != 0 && (mask >> (32 - shift)) != 0)
         {
-            if ((toOrr = pixelData & 0xF))
-            {
-                dst = windowTiles + ((j / 8) * 32) + ((j % 8) / 2) + ((i / 8) * widthOffset) + ((i % 8) * 4);
-                bits = ((j & 1) * 4);
-                *dst = (toOrr << bits) | (*dst & (0xF0 >> bits));
-            }
-            pixelData >>= 4;
+            dst += 8; // next tile
+            *dst = (*dst & ~(mask >> (32 - shift))) | (pixelData >> (32 - shift));
         }
     }
 }
@@ -1228,38 +1324,43 @@ static u16 RenderText(struct TextPrinter *textPrinter)
             return RENDER_FINISH;
         }
 
-        switch (subStruct->fontId)
+        // Braille and bold don't decompress a glyph here.
+        if (subStruct->fontId != FONT_BRAILLE
+         && subStruct->fontId != FONT_BOLD
+         && !LoadCachedGlyph(subStruct->fontId, currChar, textPrinter->japanese))
         {
-        case FONT_SMALL:
-            DecompressGlyph_Small(currChar, textPrinter->japanese);
-            break;
-        case FONT_NORMAL:
-            DecompressGlyph_Normal(currChar, textPrinter->japanese);
-            break;
-        case FONT_SHORT:
-        case FONT_SHORT_COPY_1:
-        case FONT_SHORT_COPY_2:
-        case FONT_SHORT_COPY_3:
-        case FONT_BW_SUMMARY_SCREEN:
-            DecompressGlyph_Short(currChar, textPrinter->japanese);
-            break;
-        case FONT_NARROW:
-            DecompressGlyph_Narrow(currChar, textPrinter->japanese);
-            break;
-        case FONT_SMALL_NARROW:
-            DecompressGlyph_SmallNarrow(currChar, textPrinter->japanese);
-            break;
-        case FONT_NARROWER:
-            DecompressGlyph_Narrower(currChar, textPrinter->japanese);
-            break;
-        case FONT_SMALL_NARROWER:
-            DecompressGlyph_SmallNarrower(currChar, textPrinter->japanese);
-            break;
-        case FONT_SHORT_NARROW:
-            DecompressGlyph_ShortNarrow(currChar, textPrinter->japanese);
-            break;
-        case FONT_BRAILLE:
-            break;
+            switch (subStruct->fontId)
+            {
+            case FONT_SMALL:
+                DecompressGlyph_Small(currChar, textPrinter->japanese);
+                break;
+            case FONT_NORMAL:
+                DecompressGlyph_Normal(currChar, textPrinter->japanese);
+                break;
+            case FONT_SHORT:
+            case FONT_SHORT_COPY_1:
+            case FONT_SHORT_COPY_2:
+            case FONT_SHORT_COPY_3:
+            case FONT_BW_SUMMARY_SCREEN:
+                DecompressGlyph_Short(currChar, textPrinter->japanese);
+                break;
+            case FONT_NARROW:
+                DecompressGlyph_Narrow(currChar, textPrinter->japanese);
+                break;
+            case FONT_SMALL_NARROW:
+                DecompressGlyph_SmallNarrow(currChar, textPrinter->japanese);
+                break;
+            case FONT_NARROWER:
+                DecompressGlyph_Narrower(currChar, textPrinter->japanese);
+                break;
+            case FONT_SMALL_NARROWER:
+                DecompressGlyph_SmallNarrower(currChar, textPrinter->japanese);
+                break;
+            case FONT_SHORT_NARROW:
+                DecompressGlyph_ShortNarrow(currChar, textPrinter->japanese);
+                break;
+            }
+            StoreCachedGlyph(subStruct->fontId, currChar, textPrinter->japanese);
         }
 
         CopyGlyphToWindow(textPrinter);
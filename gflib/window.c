@@ -76,6 +76,7 @@ bool32 InitWindows(const struct WindowTemplate *templates)
 
                 gWindowBgTilemapBuffers[bgLayer] = allocatedTilemapBuffer;
                 SetBgTilemapBuffer(bgLayer, allocatedTilemapBuffer);
+                EnableBgTilemapBufferDirtyTracking(bgLayer);
             }
         }
 
@@ -151,6 +152,7 @@ u32 AddWindow(const struct WindowTemplate *template)
 
             gWindowBgTilemapBuffers[bgLayer] = allocatedTilemapBuffer;
             SetBgTilemapBuffer(bgLayer, allocatedTilemapBuffer);
+            EnableBgTilemapBufferDirtyTracking(bgLayer);
         }
     }
 
@@ -624,6 +626,7 @@ u32 AddWindow8Bit(const struct WindowTemplate *template)
                 memAddress[i] = 0;
             gWindowBgTilemapBuffers[bgLayer] = memAddress;
             SetBgTilemapBuffer(bgLayer, memAddress);
+            EnableBgTilemapBufferDirtyTracking(bgLayer);
         }
     }
     memAddress = Alloc((u16)(64 * (template->width * template->height)));
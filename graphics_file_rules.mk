@@ -26,6 +26,15 @@ SPINDAGFXDIR := graphics/pokemon/spinda/spots
 types := none normal fight flying poison ground rock bug ghost steel mystery fire water grass electric psychic ice dragon dark fairy stellar
 contest_types := cool beauty cute smart tough
 
+### Compression ###
+
+# These are decompressed while the player waits, so they use gbagfx's fast LZ
+# instead of LZ77. It's about 10-15% bigger but decompresses several times
+# faster. The loaders in src/decompress.c read the format from the header, so
+# any other .lz file can be switched the same way.
+graphics/pokemon/%front.4bpp.lz graphics/pokemon/%frontf.4bpp.lz: LZFLAGS += -fast
+$(TILESETGFXDIR)/%/tiles.4bpp.lz: LZFLAGS += -fast
+
 ### Tilesets ###
 
 $(TILESETGFXDIR)/secondary/petalburg/tiles.4bpp: %.4bpp: %.png
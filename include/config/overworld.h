@@ -40,11 +40,15 @@
 #define LARGE_OW_SUPPORT               TRUE       // If true, adds a small amount of overhead to OW code so that large (48x48, 64x64) OWs will display correctly under bridges, etc.
 #define OW_FOLLOWERS_SHARE_PALETTE     FALSE      // [WIP!! NOT ALL PALETTES HAVE BEEN ADJUSTED FOR THIS!!] If TRUE, follower palettes are taken from battle sprites.
 #define OW_MON_POKEBALLS               TRUE       // Followers will emerge from the pokeball they are stored in, instead of a normal pokeball
+#define OW_MON_PALETTE_CACHE_SIZE      8          // How many decompressed overworld Pokémon palettes are kept, so spawning another of the same species doesn't decompress its palette again.
 #define OW_GFX_COMPRESS                TRUE       // Adds support for compressed OW graphics, (Also compresses pokemon follower graphics).
                                                   // Compressed gfx are incompatible with non-power-of-two sprite sizes:
                                                   // (You should not use 48x48 sprites/tables for compressed gfx)
                                                   // 16x32, 32x32, 64x64 etc are fine
 
+// Object events
+#define OW_OBJECT_SLEEP_MARGIN         4          // Object events that are only idling (looking around, walking in place, etc.) stop updating and animating while they're more than this many tiles offscreen. Set to 0 to always update them.
+
 // Out-of-battle Ability effects
 #define OW_SYNCHRONIZE_NATURE       GEN_LATEST // In Gen8+, if a Pokémon with Synchronize leads the party, wild Pokémon will always have their same Nature as opposed to the 50% chance in previous games. Gift Pokémon excluded.
                                                // In USUM (here GEN_7), if a Pokémon with Synchronize leads the party, gift Pokémon will always have their same Nature regardless of their Egg Group.
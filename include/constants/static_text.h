@@ -0,0 +1,42 @@
+#ifndef GUARD_CONSTANTS_STATIC_TEXT_H
+#define GUARD_CONSTANTS_STATIC_TEXT_H
+
+//
+// DO NOT MODIFY THIS FILE! It is auto-generated from src/data/text/static_text.txt
+//
+
+#define STATIC_TEXT_SUMMARY_PKMN_INFO     0
+#define STATIC_TEXT_SUMMARY_PKMN_SKILLS   1
+#define STATIC_TEXT_SUMMARY_BATTLE_MOVES  2
+#define STATIC_TEXT_SUMMARY_CONTEST_MOVES 3
+#define STATIC_TEXT_SUMMARY_CANCEL        4
+#define STATIC_TEXT_SUMMARY_INFO          5
+#define STATIC_TEXT_SUMMARY_SWITCH        6
+#define STATIC_TEXT_SUMMARY_RENTAL_PKMN   7
+#define STATIC_TEXT_SUMMARY_TYPE          8
+#define STATIC_TEXT_SUMMARY_HP            9
+#define STATIC_TEXT_SUMMARY_ATTACK        10
+#define STATIC_TEXT_SUMMARY_DEFENSE       11
+#define STATIC_TEXT_SUMMARY_SP_ATK        12
+#define STATIC_TEXT_SUMMARY_SP_DEF        13
+#define STATIC_TEXT_SUMMARY_SPEED         14
+#define STATIC_TEXT_SUMMARY_EXP_POINTS    15
+#define STATIC_TEXT_SUMMARY_NEXT_LV       16
+#define STATIC_TEXT_SUMMARY_STATUS        17
+#define STATIC_TEXT_SUMMARY_POWER         18
+#define STATIC_TEXT_SUMMARY_ACCURACY      19
+#define STATIC_TEXT_SUMMARY_APPEAL        20
+#define STATIC_TEXT_SUMMARY_JAM           21
+#define STATIC_TEXT_START_MENU_POKEDEX    22
+#define STATIC_TEXT_START_MENU_POKEMON    23
+#define STATIC_TEXT_START_MENU_BAG        24
+#define STATIC_TEXT_START_MENU_POKENAV    25
+#define STATIC_TEXT_START_MENU_SAVE       26
+#define STATIC_TEXT_START_MENU_OPTION     27
+#define STATIC_TEXT_START_MENU_EXIT       28
+#define STATIC_TEXT_START_MENU_RETIRE     29
+#define STATIC_TEXT_START_MENU_REST       30
+
+#define STATIC_TEXT_COUNT                 31
+
+#endif // GUARD_CONSTANTS_STATIC_TEXT_H
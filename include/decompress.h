@@ -5,8 +5,17 @@
 
 extern u8 ALIGNED(4) gDecompressionBuffer[0x4000];
 
+// The first byte of data compressed with gbagfx's -fast option, in place of
+// LZ77's 0x10. LZDecompressWram, LZDecompressVram and the loaders below
+// check for it, so a file can switch formats in graphics_file_rules.mk
+// without changing the code that loads it.
+#define FAST_LZ_TAG 0x50
+
+#define IsFastLZData(src) (*(const u8 *)(src) == FAST_LZ_TAG)
+
 void LZDecompressWram(const u32 *src, void *dest);
 void LZDecompressVram(const u32 *src, void *dest);
+IWRAM_CODE void FastLZDecompress(const u32 *src, void *dest);
 
 u32 IsLZ77Data(const void *ptr, u32 minSize, u32 maxSize);
 
@@ -103,6 +103,15 @@ struct LockedAnimObjectEvents
     u8 count;
 };
 
+// How LoadDynamicFollowerPalette found the overworld Pokémon palettes it was asked for.
+struct MonPaletteCacheStats
+{
+    u16 requests;
+    u16 slotHits; // already loaded in a sprite palette slot
+    u16 cacheHits; // decompressed earlier, only copied to a slot
+    u16 decompressions;
+};
+
 extern const struct OamData gObjectEventBaseOam_32x8;
 extern const struct OamData gObjectEventBaseOam_32x32;
 extern const struct OamData gObjectEventBaseOam_64x64;
@@ -111,6 +120,7 @@ extern const struct SubspriteTable sOamTables_64x64[];
 extern const union AnimCmd *const sAnimTable_Following[];
 extern const struct SpriteTemplate *const gFieldEffectObjectTemplatePointers[];
 extern const u8 gReflectionEffectPaletteMap[];
+extern struct MonPaletteCacheStats gMonPaletteCacheStats;
 
 extern const struct SpriteFrameImage *const gBerryTreePicTablePointers[];
 extern const u8 *const gBerryTreePaletteSlotTablePointers[];
@@ -120,6 +130,7 @@ u8 GetMoveDirectionAnimNum(u8 direction);
 u8 GetObjectEventIdByLocalIdAndMap(u8 localId, u8 mapNum, u8 mapGroupId);
 bool8 TryGetObjectEventIdByLocalIdAndMap(u8 localId, u8 mapNum, u8 mapGroupId, u8 *objectEventId);
 u8 GetObjectEventIdByXY(s16 x, s16 y);
+void RebuildObjectEventTileBuckets(void);
 void SetObjectEventDirection(struct ObjectEvent *objectEvent, u8 direction);
 u8 GetFirstInactiveObjectEventId(void);
 void RemoveObjectEventByLocalIdAndMap(u8 localId, u8 mapNum, u8 mapGroup);
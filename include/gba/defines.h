@@ -10,6 +10,15 @@
 #define EWRAM_DATA __attribute__((section(".sbss")))
 #define IWRAM_INIT __attribute__((section(".iwram")))
 #define EWRAM_INIT __attribute__((section(".ewram")))
+// Code that's copied to IWRAM at boot. Its file should be compiled as ARM (see
+// decompress_fast.o in the Makefile). Callers in ROM need a long call, since
+// IWRAM is out of bl's range. agbcc has no long_call, so under it they have to
+// call through a function pointer instead (see LZDecompressWram).
+#if MODERN
+#define IWRAM_CODE __attribute__((section(".iwram.code"), long_call))
+#else
+#define IWRAM_CODE __attribute__((section(".iwram.code")))
+#endif
 #define UNUSED __attribute__((unused))
 
 #if MODERN
@@ -52,7 +52,17 @@ struct PaletteFadeControl
     u8 deltaY:4; // rate of change of blend coefficient
 };
 
+// How much TransferPlttBuffer and TransferDirtyPlttBuffer copy to palette RAM.
+struct PlttTransferStats
+{
+    u32 transfers;
+    u32 totalBytes;
+    u16 lastBytes; // copied by the most recent transfer
+    u16 peakBytes;
+};
+
 extern struct PaletteFadeControl gPaletteFade;
+extern struct PlttTransferStats gPlttTransferStats;
 extern u32 gPlttBufferTransferPending;
 extern u8 ALIGNED(4) gPaletteDecompressionBuffer[];
 extern u16 ALIGNED(4) gPlttBufferUnfaded[PLTT_BUFFER_SIZE];
@@ -61,10 +71,13 @@ extern u16 ALIGNED(4) gPlttBufferFaded[PLTT_BUFFER_SIZE];
 void LoadCompressedPalette(const u32 *src, u16 offset, u16 size);
 void LoadPalette(const void *src, u16 offset, u16 size);
 void FillPalette(u16 value, u16 offset, u16 size);
+void MarkPlttBufferDirty(u16 offset, u16 size);
 void TransferPlttBuffer(void);
+void TransferDirtyPlttBuffer(void);
 u8 UpdatePaletteFade(void);
 void ResetPaletteFade(void);
 bool8 BeginNormalPaletteFade(u32 selectedPalettes, s8 delay, u8 startY, u8 targetY, u16 blendColor);
+bool8 BeginBrightnessPaletteFade(u32 selectedPalettes, s8 delay, u8 startY, u8 targetY, u16 blendColor);
 void PaletteStruct_ResetById(u16 id);
 void ResetPaletteFadeControl(void);
 void InvertPlttBuffer(u32 selectedPalettes);
@@ -72,6 +85,7 @@ void TintPlttBuffer(u32 selectedPalettes, s8 r, s8 g, s8 b);
 void UnfadePlttBuffer(u32 selectedPalettes);
 void BeginFastPaletteFade(u8 submode);
 void BeginHardwarePaletteFade(u8 blendCnt, u8 delay, u8 y, u8 targetY, u8 shouldResetBlendRegisters);
+bool8 IsBrightnessPaletteFadeActive(void);
 void BlendPalettes(u32 selectedPalettes, u8 coeff, u16 color);
 void BlendPalettesUnfaded(u32 selectedPalettes, u8 coeff, u16 color);
 void BlendPalettesGradually(u32 selectedPalettes, s8 delay, u8 coeff, u8 coeffTarget, u16 color, u8 priority, u8 id);
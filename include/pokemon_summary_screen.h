@@ -3,6 +3,10 @@
 
 #include "main.h"
 
+// Both summary screens hold their state in an arena with this much room left
+// over for short-lived scratch buffers.
+#define SUMMARY_SCRATCH_SIZE 256
+
 extern u8 gLastViewedMonIndex;
 
 extern const u8 gNotDoneYetDescription[];
@@ -0,0 +1,28 @@
+#ifndef GUARD_STATIC_TEXT_H
+#define GUARD_STATIC_TEXT_H
+
+#include "constants/static_text.h"
+
+// For tables where some strings aren't prerendered.
+#define STATIC_TEXT_NONE 0xFF
+
+// A string prerendered at build time with a fixed font and colors. The tiles
+// are laid out like a window's tile buffer, and transparent pixels are 0.
+struct StaticText
+{
+    const u32 *tiles;
+    const u8 *text;
+    u8 fontId;
+    u8 bgColor;
+    u8 fgColor;
+    u8 shadowColor;
+    u8 width;
+    u8 height;
+};
+
+extern const struct StaticText gStaticTexts[];
+
+void BlitStaticTextToWindow(u32 windowId, u32 staticTextId, u32 x, u32 y);
+u32 GetStaticTextWidth(u32 staticTextId);
+
+#endif // GUARD_STATIC_TEXT_H
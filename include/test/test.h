@@ -3,7 +3,8 @@
 
 #include "test_runner.h"
 
-#define MAX_PROCESSES 32 // See also tools/mgba-rom-test-hydra/main.c
+#define MAX_PROCESSES 128 // See also MAX_SHARDS in tools/mgba-rom-test-hydra/main.c
+#define MAX_TEST_ASSIGNMENTS 8192 // See also tools/mgba-rom-test-hydra/main.c
 
 enum TestResult
 {
@@ -35,13 +36,28 @@ struct Test
     void *data;
 };
 
+struct ProcessCost
+{
+    u32 cost;
+    u32 process;
+};
+
+// A test that Hydra assigned to a process from its timings. Sorted by
+// nameHash.
+struct TestAssignment
+{
+    u32 nameHash;
+    u32 process;
+};
+
 struct TestRunnerState
 {
     u8 state;
     u8 exitCode;
     const char *skipFilename;
     const struct Test *test;
-    u32 processCosts[MAX_PROCESSES];
+    struct ProcessCost processCosts[MAX_PROCESSES]; // Min heap.
+    u32 processCount;
 
     u8 result;
     u8 expectedResult;
@@ -53,7 +69,12 @@ struct TestRunnerState
 
 extern const u8 gTestRunnerN;
 extern const u8 gTestRunnerI;
+extern const u16 gTestRunnerResume;
 extern const char gTestRunnerArgv[256];
+extern const u32 gTestRunnerAssignmentsCount;
+extern const u32 gTestRunnerDefaultCost;
+extern const u32 gTestRunnerProcessCosts[MAX_PROCESSES];
+extern const struct TestAssignment gTestRunnerAssignments[MAX_TEST_ASSIGNMENTS];
 
 extern const struct TestRunner gAssumptionsRunner;
 
@@ -1,14 +1,22 @@
 # JSON files are run through jsonproc, which is a tool that converts JSON data to an output file
 # based on an Inja template. https://github.com/pantor/inja
 
-AUTO_GEN_TARGETS += $(DATA_SRC_SUBDIR)/wild_encounters.h
-$(DATA_SRC_SUBDIR)/wild_encounters.h: $(DATA_SRC_SUBDIR)/wild_encounters.json $(DATA_SRC_SUBDIR)/wild_encounters.json.txt
-	$(JSONPROC) $^ $@
+# Every output comes from one jsonproc run, which reads this list of
+# <json> <template> <output> triples as its manifest. It only rewrites the
+# outputs whose text changed, so the C files that include them aren't
+# recompiled for edits that don't change the output. jsonproc.stamp records
+# when it last ran.
+JSONPROC_JOBS := \
+	$(DATA_SRC_SUBDIR)/wild_encounters.json $(DATA_SRC_SUBDIR)/wild_encounters.json.txt $(DATA_SRC_SUBDIR)/wild_encounters.h \
+	$(DATA_SRC_SUBDIR)/region_map/region_map_sections.json $(DATA_SRC_SUBDIR)/region_map/region_map_sections.json.txt $(DATA_SRC_SUBDIR)/region_map/region_map_entries.h
+JSONPROC_OUTS := $(DATA_SRC_SUBDIR)/wild_encounters.h $(DATA_SRC_SUBDIR)/region_map/region_map_entries.h
+JSONPROC_STAMP := $(DATA_SRC_SUBDIR)/jsonproc.stamp
 
-$(C_BUILDDIR)/wild_encounter.o: c_dep += $(DATA_SRC_SUBDIR)/wild_encounters.h
-
-AUTO_GEN_TARGETS += $(DATA_SRC_SUBDIR)/region_map/region_map_entries.h
-$(DATA_SRC_SUBDIR)/region_map/region_map_entries.h: $(DATA_SRC_SUBDIR)/region_map/region_map_sections.json $(DATA_SRC_SUBDIR)/region_map/region_map_sections.json.txt
-	$(JSONPROC) $^ $@
+AUTO_GEN_TARGETS += $(JSONPROC_OUTS) $(JSONPROC_STAMP)
+$(JSONPROC_STAMP): $(filter-out $(JSONPROC_OUTS),$(JSONPROC_JOBS))
+	printf '%s %s %s\n' $(JSONPROC_JOBS) | $(JSONPROC) -manifest -
+	@touch $@
+$(JSONPROC_OUTS): $(JSONPROC_STAMP) ;
 
+$(C_BUILDDIR)/wild_encounter.o: c_dep += $(DATA_SRC_SUBDIR)/wild_encounters.h
 $(C_BUILDDIR)/region_map.o: c_dep += $(DATA_SRC_SUBDIR)/region_map/region_map_entries.h
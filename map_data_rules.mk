@@ -3,20 +3,26 @@
 MAPS_DIR = $(DATA_ASM_SUBDIR)/maps
 LAYOUTS_DIR = $(DATA_ASM_SUBDIR)/layouts
 
-MAP_DIRS := $(dir $(wildcard $(MAPS_DIR)/*/map.json))
+MAP_JSONS := $(wildcard $(MAPS_DIR)/*/map.json)
+MAP_DIRS := $(dir $(MAP_JSONS))
 MAP_CONNECTIONS := $(patsubst $(MAPS_DIR)/%/,$(MAPS_DIR)/%/connections.inc,$(MAP_DIRS))
 MAP_EVENTS := $(patsubst $(MAPS_DIR)/%/,$(MAPS_DIR)/%/events.inc,$(MAP_DIRS))
 MAP_HEADERS := $(patsubst $(MAPS_DIR)/%/,$(MAPS_DIR)/%/header.inc,$(MAP_DIRS))
 
-$(DATA_ASM_BUILDDIR)/maps.o: $(DATA_ASM_SUBDIR)/maps.s $(LAYOUTS_DIR)/layouts.inc $(LAYOUTS_DIR)/layouts_table.inc $(MAPS_DIR)/headers.inc $(MAPS_DIR)/groups.inc $(MAPS_DIR)/connections.inc $(MAP_CONNECTIONS) $(MAP_HEADERS)
-	$(PREPROC) $< charmap.txt | $(CPP) -I include - | $(AS) $(ASFLAGS) -o $@
-$(DATA_ASM_BUILDDIR)/map_events.o: $(DATA_ASM_SUBDIR)/map_events.s $(MAPS_DIR)/events.inc $(MAP_EVENTS)
-	$(PREPROC) $< charmap.txt | $(CPP) -I include - | $(AS) $(ASFLAGS) -o $@
+# maps.s and map_events.s are preprocessed with the rest of data/*.s.
+$(DATA_ASM_PREPROC_STAMP): $(LAYOUTS_DIR)/layouts.inc $(LAYOUTS_DIR)/layouts_table.inc $(MAPS_DIR)/headers.inc $(MAPS_DIR)/groups.inc $(MAPS_DIR)/connections.inc $(MAP_CONNECTIONS) $(MAP_HEADERS)
+$(DATA_ASM_PREPROC_STAMP): $(MAPS_DIR)/events.inc $(MAP_EVENTS)
 
-$(MAPS_DIR)/%/header.inc: $(MAPS_DIR)/%/map.json
-	$(MAPJSON) map emerald $< $(LAYOUTS_DIR)/layouts.json
-$(MAPS_DIR)/%/events.inc: $(MAPS_DIR)/%/header.inc ;
-$(MAPS_DIR)/%/connections.inc: $(MAPS_DIR)/%/events.inc ;
+# Every map's header.inc, events.inc and connections.inc come from one mapjson
+# run. It only rewrites the files whose text changed, so maps.o and
+# map_events.o aren't reassembled for edits that don't change the output.
+# maps.stamp records when it last ran.
+MAPS_STAMP := $(MAPS_DIR)/maps.stamp
+
+$(MAPS_STAMP): $(MAP_JSONS) $(LAYOUTS_DIR)/layouts.json
+	$(MAPJSON) maps emerald $(LAYOUTS_DIR)/layouts.json $(MAP_JSONS)
+	@touch $@
+$(MAP_HEADERS) $(MAP_EVENTS) $(MAP_CONNECTIONS): $(MAPS_STAMP) ;
 
 $(MAPS_DIR)/groups.inc: $(MAPS_DIR)/map_groups.json
 	$(MAPJSON) groups emerald $<
@@ -3993,7 +3993,10 @@ static bool8 TransitionIntro_FadeToGray(struct Task *task)
         task->tBldCntSaved = GetGpuReg(REG_OFFSET_BLDCNT);
         SetGpuReg(REG_OFFSET_BLDCNT, task->tBldCntSaved & ~BLDCNT_TGT2_BG_ALL);
         if (paletteNum < 16)
+        {
             gPlttBufferFaded[index] = RGB(11, 11, 11);
+            MarkPlttBufferDirty(index, PLTT_SIZEOF(1));
+        }
         task->tState++;
         task->tDelayTimer = task->tFadeFromGrayDelay;
     }
@@ -4015,6 +4018,7 @@ static bool8 TransitionIntro_FadeFromGray(struct Task *task)
         if (paletteNum < 16) {
             u16 index = (paletteNum+16)*16+9; // SHADOW_COLOR_INDEX
             gPlttBufferFaded[index] = task->tShadowColor;
+            MarkPlttBufferDirty(index, PLTT_SIZEOF(1));
         }
     }
     if (task->tBlend == 0)
@@ -4506,6 +4510,7 @@ static bool8 FrontierSquares_Shrink(struct Task *task)
                 gPlttBufferUnfaded[i] = RGB_BLACK;
                 gPlttBufferFaded[i] = RGB_BLACK;
             }
+            MarkPlttBufferDirty(BG_PLTT_ID(15) + 10, PLTT_SIZEOF(5));
             break;
         case 1:
             BlendPalettes(PALETTES_ALL & ~(1 << 15), 16, RGB_BLACK);
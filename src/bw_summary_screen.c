@@ -220,6 +220,8 @@ static EWRAM_DATA struct PokemonSummaryScreenData
     u8 unk_filler4[6];
 } *sMonSummaryScreen = NULL;
 
+static EWRAM_DATA struct Arena sSummaryArena = {0};
+
 static EWRAM_DATA u8 sMoveSlotToReplace = 0;
 ALIGNED(4) static EWRAM_DATA u8 sAnimDelayTaskId = 0;
 static EWRAM_DATA u8 sStringVar5[0x4] = {0};
@@ -1486,7 +1488,15 @@ static const struct SpriteTemplate sSpriteTemplate_PokerusCuredIcon =
 // code
 void ShowPokemonSummaryScreen_BW(u8 mode, void *mons, u8 monIndex, u8 maxMonIndex, void (*callback)(void))
 {
-    sMonSummaryScreen = AllocZeroed(sizeof(*sMonSummaryScreen));
+    if (!ArenaOpen(&sSummaryArena, sizeof(*sMonSummaryScreen) + SUMMARY_SCRATCH_SIZE))
+    {
+        // Alloc failed, exit as if the player had backed out
+        sMonSummaryScreen = NULL;
+        sMoveSlotToReplace = MAX_MON_MOVES;
+        SetMainCallback2(callback);
+        return;
+    }
+    sMonSummaryScreen = ArenaAllocZeroed(&sSummaryArena, sizeof(*sMonSummaryScreen));
     sMonSummaryScreen->mode = mode;
     sMonSummaryScreen->monList.mons = mons;
     sMonSummaryScreen->curMonIndex = monIndex;
@@ -1529,13 +1539,15 @@ void ShowPokemonSummaryScreen_BW(u8 mode, void *mons, u8 monIndex, u8 maxMonInde
 void ShowSelectMovePokemonSummaryScreen_BW(struct Pokemon *mons, u8 monIndex, u8 maxMonIndex, void (*callback)(void), u16 newMove)
 {
     ShowPokemonSummaryScreen_BW(BW_SUMMARY_MODE_SELECT_MOVE, mons, monIndex, maxMonIndex, callback);
-    sMonSummaryScreen->newMove = newMove;
+    if (sMonSummaryScreen != NULL)
+        sMonSummaryScreen->newMove = newMove;
 }
 
 void ShowPokemonSummaryScreenHandleDeoxys_BW(u8 mode, struct BoxPokemon *mons, u8 monIndex, u8 maxMonIndex, void (*callback)(void))
 {
     ShowPokemonSummaryScreen_BW(mode, mons, monIndex, maxMonIndex, callback);
-    sMonSummaryScreen->handleDeoxys = TRUE;
+    if (sMonSummaryScreen != NULL)
+        sMonSummaryScreen->handleDeoxys = TRUE;
 }
 
 static void MainCB2(void)
@@ -2004,7 +2016,7 @@ static void RestoreSummaryPageDisplay(void)
 static void FreeSummaryScreen(void)
 {
     FreeAllWindowBuffers();
-    Free(sMonSummaryScreen);
+    ArenaClose(&sSummaryArena);
 }
 
 static void BeginCloseSummaryScreen(u8 taskId)
@@ -3773,8 +3785,9 @@ static void BufferMonTrainerMemo(void)
     }
     else
     {
-        u8 *metLevelString = Alloc(32);
-        u8 *metLocationString = Alloc(32);
+        u32 scratch = ArenaMark(&sSummaryArena);
+        u8 *metLevelString = ArenaAlloc(&sSummaryArena, 32);
+        u8 *metLocationString = ArenaAlloc(&sSummaryArena, 32);
         GetMetLevelString(metLevelString);
 
         if (locationFound)
@@ -3807,8 +3820,7 @@ static void BufferMonTrainerMemo(void)
 
         DynamicPlaceholderTextUtil_ExpandPlaceholders(gStringVar4, text);
 
-        Free(metLevelString);
-        Free(metLocationString);
+        ArenaRewind(&sSummaryArena, scratch);
     }
 }
 
@@ -4077,8 +4089,9 @@ static void PopulateNatureMod(s8 *dest, u32 nature)
 static void BufferAndPrintStats_HandleState(u8 mode)
 {
     u16 hp, hp2, atk, def, spA, spD, spe;
-    u8 *currentHPString = Alloc(20);
-    u8 *maxHPString = Alloc(20);
+    u32 scratch = ArenaMark(&sSummaryArena);
+    u8 *currentHPString = ArenaAlloc(&sSummaryArena, 20);
+    u8 *maxHPString = ArenaAlloc(&sSummaryArena, 20);
 
     switch (mode)
     {
@@ -4150,14 +4163,14 @@ static void BufferAndPrintStats_HandleState(u8 mode)
         PrintNonHPStats();
     }
 
-    Free(currentHPString); 
-    Free(maxHPString); 
+    ArenaRewind(&sSummaryArena, scratch);
 }
 
 static void BufferHPStats(void)
 {
-    u8 *currentHPString = Alloc(8);
-    u8 *maxHPString = Alloc(8);
+    u32 scratch = ArenaMark(&sSummaryArena);
+    u8 *currentHPString = ArenaAlloc(&sSummaryArena, 8);
+    u8 *maxHPString = ArenaAlloc(&sSummaryArena, 8);
 
     ConvertIntToDecimalStringN(currentHPString, sMonSummaryScreen->summary.currentHP, STR_CONV_MODE_RIGHT_ALIGN, 3);
     ConvertIntToDecimalStringN(maxHPString, sMonSummaryScreen->summary.maxHP, STR_CONV_MODE_RIGHT_ALIGN, 3);
@@ -4167,8 +4180,7 @@ static void BufferHPStats(void)
     DynamicPlaceholderTextUtil_SetPlaceholderPtr(1, maxHPString);
     DynamicPlaceholderTextUtil_ExpandPlaceholders(gStringVar4, sStatsHPLayout);
 
-    Free(currentHPString);
-    Free(maxHPString);
+    ArenaRewind(&sSummaryArena, scratch);
 }
 
 static void PrintHPStats(u8 mode)
@@ -8,17 +8,33 @@
 
 EWRAM_DATA ALIGNED(4) u8 gDecompressionBuffer[0x4000] = {0};
 
+#if MODERN
+#define CallFastLZDecompress FastLZDecompress
+#else
+// agbcc can't make a long call, so IWRAM is reached through a pointer, like
+// librfu's fastCopyPtr. It isn't const, so that agbcc can't fold it back into
+// a bl.
+void (*gFastLZDecompressFunc)(const u32 *src, void *dest) = FastLZDecompress;
+#define CallFastLZDecompress gFastLZDecompressFunc
+#endif
+
 void LZDecompressWram(const u32 *src, void *dest)
 {
-    LZ77UnCompWram(src, dest);
+    if (IsFastLZData(src))
+        CallFastLZDecompress(src, dest);
+    else
+        LZ77UnCompWram(src, dest);
 }
 
 void LZDecompressVram(const u32 *src, void *dest)
 {
-    LZ77UnCompVram(src, dest);
+    if (IsFastLZData(src))
+        CallFastLZDecompress(src, dest);
+    else
+        LZ77UnCompVram(src, dest);
 }
 
-// Checks if `ptr` is likely LZ77 data
+// Checks if `ptr` is likely LZ77 or fast LZ data
 // Checks word-alignment, min/max size, and header byte
 // Returns uncompressed size if true, 0 otherwise
 u32 IsLZ77Data(const void *ptr, u32 minSize, u32 maxSize)
@@ -30,7 +46,7 @@ u32 IsLZ77Data(const void *ptr, u32 minSize, u32 maxSize)
         return 0;
     // Check LZ77 header byte
     // See https://problemkaputt.de/gbatek.htm#biosdecompressionfunctions
-    if (data[0] != 0x10)
+    if (data[0] != 0x10 && data[0] != FAST_LZ_TAG)
         return 0;
 
     // Read 24-bit uncompressed size
@@ -44,7 +60,7 @@ u16 LoadCompressedSpriteSheet(const struct CompressedSpriteSheet *src)
 {
     struct SpriteSheet dest;
 
-    LZ77UnCompWram(src->data, gDecompressionBuffer);
+    LZDecompressWram(src->data, gDecompressionBuffer);
     dest.data = gDecompressionBuffer;
     dest.size = src->size;
     dest.tag = src->tag;
@@ -62,7 +78,7 @@ u16 LoadCompressedSpriteSheetByTemplate(const struct SpriteTemplate *template, s
     if ((size = IsLZ77Data(template->images->data, TILE_SIZE_4BPP, sizeof(gDecompressionBuffer))) == 0)
         return LoadSpriteSheetByTemplate(template, 0, offset);
 
-    LZ77UnCompWram(template->images->data, gDecompressionBuffer);
+    LZDecompressWram(template->images->data, gDecompressionBuffer);
     myImage.data = gDecompressionBuffer;
     myImage.size = size + offset;
     myTemplate.images = &myImage;
@@ -75,7 +91,7 @@ void LoadCompressedSpriteSheetOverrideBuffer(const struct CompressedSpriteSheet
 {
     struct SpriteSheet dest;
 
-    LZ77UnCompWram(src->data, buffer);
+    LZDecompressWram(src->data, buffer);
     dest.data = buffer;
     dest.size = src->size;
     dest.tag = src->tag;
@@ -86,7 +102,7 @@ void LoadCompressedSpritePalette(const struct CompressedSpritePalette *src)
 {
     struct SpritePalette dest;
 
-    LZ77UnCompWram(src->data, gDecompressionBuffer);
+    LZDecompressWram(src->data, gDecompressionBuffer);
     dest.data = (void *) gDecompressionBuffer;
     dest.tag = src->tag;
     LoadSpritePalette(&dest);
@@ -96,7 +112,7 @@ void LoadCompressedSpritePaletteWithTag(const u32 *pal, u16 tag)
 {
     struct SpritePalette dest;
 
-    LZ77UnCompWram(pal, gDecompressionBuffer);
+    LZDecompressWram(pal, gDecompressionBuffer);
     dest.data = (void *) gDecompressionBuffer;
     dest.tag = tag;
     LoadSpritePalette(&dest);
@@ -106,7 +122,7 @@ void LoadCompressedSpritePaletteOverrideBuffer(const struct CompressedSpritePale
 {
     struct SpritePalette dest;
 
-    LZ77UnCompWram(src->data, buffer);
+    LZDecompressWram(src->data, buffer);
     dest.data = buffer;
     dest.tag = src->tag;
     LoadSpritePalette(&dest);
@@ -114,7 +130,7 @@ void LoadCompressedSpritePaletteOverrideBuffer(const struct CompressedSpritePale
 
 void DecompressPicFromTable(const struct CompressedSpriteSheet *src, void *buffer)
 {
-    LZ77UnCompWram(src->data, buffer);
+    LZDecompressWram(src->data, buffer);
 }
 
 void HandleLoadSpecialPokePic(bool32 isFrontPic, void *dest, s32 species, u32 personality)
@@ -131,20 +147,20 @@ void LoadSpecialPokePic(void *dest, s32 species, u32 personality, bool8 isFrontP
     if (isFrontPic)
     {
         if (gSpeciesInfo[species].frontPicFemale != NULL && IsPersonalityFemale(species, personality))
-            LZ77UnCompWram(gSpeciesInfo[species].frontPicFemale, dest);
+            LZDecompressWram(gSpeciesInfo[species].frontPicFemale, dest);
         else if (gSpeciesInfo[species].frontPic != NULL)
-            LZ77UnCompWram(gSpeciesInfo[species].frontPic, dest);
+            LZDecompressWram(gSpeciesInfo[species].frontPic, dest);
         else
-            LZ77UnCompWram(gSpeciesInfo[SPECIES_NONE].frontPic, dest);
+            LZDecompressWram(gSpeciesInfo[SPECIES_NONE].frontPic, dest);
     }
     else
     {
         if (gSpeciesInfo[species].backPicFemale != NULL && IsPersonalityFemale(species, personality))
-            LZ77UnCompWram(gSpeciesInfo[species].backPicFemale, dest);
+            LZDecompressWram(gSpeciesInfo[species].backPicFemale, dest);
         else if (gSpeciesInfo[species].backPic != NULL)
-            LZ77UnCompWram(gSpeciesInfo[species].backPic, dest);
+            LZDecompressWram(gSpeciesInfo[species].backPic, dest);
         else
-            LZ77UnCompWram(gSpeciesInfo[SPECIES_NONE].backPic, dest);
+            LZDecompressWram(gSpeciesInfo[SPECIES_NONE].backPic, dest);
     }
 
     if (species == SPECIES_SPINDA && isFrontPic)
@@ -156,7 +172,7 @@ void LoadSpecialPokePic(void *dest, s32 species, u32 personality, bool8 isFrontP
 
 void Unused_LZDecompressWramIndirect(const void **src, void *dest)
 {
-    LZ77UnCompWram(*src, dest);
+    LZDecompressWram(*src, dest);
 }
 
 static void UNUSED StitchObjectsOn8x8Canvas(s32 object_size, s32 object_count, u8 *src_tiles, u8 *dest_tiles)
@@ -320,7 +336,7 @@ bool8 LoadCompressedSpriteSheetUsingHeap(const struct CompressedSpriteSheet *src
     void *buffer;
 
     buffer = AllocZeroed(src->data[0] >> 8);
-    LZ77UnCompWram(src->data, buffer);
+    LZDecompressWram(src->data, buffer);
 
     dest.data = buffer;
     dest.size = src->size;
@@ -337,7 +353,7 @@ bool8 LoadCompressedSpritePaletteUsingHeap(const struct CompressedSpritePalette
     void *buffer;
 
     buffer = AllocZeroed(src->data[0] >> 8);
-    LZ77UnCompWram(src->data, buffer);
+    LZDecompressWram(src->data, buffer);
     dest.data = buffer;
     dest.tag = src->tag;
 
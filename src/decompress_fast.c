@@ -0,0 +1,61 @@
+#include "global.h"
+#include "decompress.h"
+
+// Decompresses data made with gbagfx's -fast option. The format is described
+// in tools/gbagfx/fastlz.c. This file is compiled as ARM, and the function is
+// copied to IWRAM at boot, where it doesn't wait on the ROM bus for its own
+// instructions. Every copy is a whole word, so the destination can be VRAM.
+IWRAM_CODE void FastLZDecompress(const u32 *src, void *dest)
+{
+    const u8 *tokens = (const u8 *)(src + 3);
+    const u16 *distances = (const u16 *)((const u8 *)src + src[1]);
+    const u32 *literals = (const u32 *)((const u8 *)src + src[2]);
+    const u32 *match;
+    u32 *out = dest;
+    u32 *end = out + (src[0] >> 10);
+    u32 token, count, extra;
+
+    while (out < end)
+    {
+        token = *tokens++;
+
+        count = token >> 4;
+        if (count == 15)
+        {
+            do
+            {
+                extra = *tokens++;
+                count += extra;
+            } while (extra == 255);
+        }
+
+        for (; count >= 4; count -= 4)
+        {
+            out[0] = literals[0];
+            out[1] = literals[1];
+            out[2] = literals[2];
+            out[3] = literals[3];
+            out += 4;
+            literals += 4;
+        }
+        for (; count != 0; count--)
+            *out++ = *literals++;
+
+        count = token & 0xF;
+        if (count == 0)
+            continue;
+        if (count == 15)
+        {
+            do
+            {
+                extra = *tokens++;
+                count += extra;
+            } while (extra == 255);
+        }
+
+        // Matches can overlap the words they produce, so copy one at a time.
+        match = out - *distances++;
+        for (; count != 0; count--)
+            *out++ = *match++;
+    }
+}
@@ -112,6 +112,45 @@ static EWRAM_DATA u8 sCurrentReflectionType = 0;
 static EWRAM_DATA u16 sCurrentSpecialObjectPaletteTag = 0;
 static EWRAM_DATA struct LockedAnimObjectEvents *sLockedAnimObjectEvents = {0};
 
+// Object events by tile, for finding the ones at a position without checking
+// every slot. Each bucket is a mask of the object events whose current or
+// previous coords hash to it. Masks can have stale bits (objects that have
+// since moved or been removed), so lookups still check the coords.
+#define OBJECT_EVENT_TILE_BUCKET_BITS 3
+#define OBJECT_EVENT_TILE_BUCKET_MASK ((1 << OBJECT_EVENT_TILE_BUCKET_BITS) - 1)
+#define OBJECT_EVENT_TILE_BUCKET(x, y) (((x) & OBJECT_EVENT_TILE_BUCKET_MASK) | (((y) & OBJECT_EVENT_TILE_BUCKET_MASK) << OBJECT_EVENT_TILE_BUCKET_BITS))
+
+static EWRAM_DATA u16 sObjectEventTileBuckets[1 << (OBJECT_EVENT_TILE_BUCKET_BITS * 2)] = {0};
+STATIC_ASSERT(OBJECT_EVENTS_COUNT <= 16, ObjectEventTileBucketsTooSmall)
+
+// Object events that are asleep, see OW_OBJECT_SLEEP_MARGIN. Their sprites'
+// anims are paused while they sleep and caught up when they wake.
+struct ObjectEventSleep
+{
+    u32 frames;
+    u8 spriteId;
+    bool8 animPaused;
+};
+
+static EWRAM_DATA u16 sSleepingObjectEvents = 0;
+static EWRAM_DATA struct ObjectEventSleep sObjectEventSleep[OBJECT_EVENTS_COUNT] = {0};
+
+// Palettes of overworld Pokémon, keyed by their tag (species and shininess).
+// Decompressed palettes are kept in a small LRU cache, so spawning a species
+// again only has to copy its colors to a free slot. The slots themselves are
+// freed as soon as no sprite uses them, like every other object event palette.
+
+struct MonPaletteCacheEntry
+{
+    u32 lastUsed; // 0 if empty
+    u16 tag;
+    u16 colors[16];
+};
+
+EWRAM_DATA struct MonPaletteCacheStats gMonPaletteCacheStats = {0};
+static EWRAM_DATA u32 sMonPaletteClock = 0;
+static EWRAM_DATA struct MonPaletteCacheEntry sMonPaletteCache[OW_MON_PALETTE_CACHE_SIZE] = {0};
+
 static void MoveCoordsInDirection(u32, s16 *, s16 *, s16, s16);
 static bool8 ObjectEventExecSingleMovementAction(struct ObjectEvent *, struct Sprite *);
 static void SetMovementDelay(struct Sprite *, s16);
@@ -123,7 +162,11 @@ static void UpdateObjectEventSpriteAnimPause(struct ObjectEvent *, struct Sprite
 static bool8 IsCoordOutsideObjectEventMovementRange(struct ObjectEvent *, s16, s16);
 static bool8 IsMetatileDirectionallyImpassable(struct ObjectEvent *, s16, s16, u8);
 static bool8 DoesObjectCollideWithObjectAt(struct ObjectEvent *, s16, s16);
+static void AddObjectEventToTileBuckets(struct ObjectEvent *);
+static void RemoveObjectEventFromTileBuckets(struct ObjectEvent *);
 static void UpdateObjectEventOffscreen(struct ObjectEvent *, struct Sprite *);
+static bool32 IsObjectEventSpriteOutsideView(struct ObjectEvent *, struct Sprite *, s32);
+static bool32 UpdateObjectEventSleep(struct ObjectEvent *, struct Sprite *);
 static void UpdateObjectEventSpriteVisibility(struct ObjectEvent *, struct Sprite *);
 static void ObjectEventUpdateMetatileBehaviors(struct ObjectEvent *);
 static void GetGroundEffectFlags_Reflection(struct ObjectEvent *, u32 *);
@@ -380,6 +423,46 @@ static const bool8 sMovementTypeHasRange[NUM_MOVEMENT_TYPES] = {
     [MOVEMENT_TYPE_COPY_PLAYER_CLOCKWISE_IN_GRASS] = TRUE,
 };
 
+// Movement types that only change which way the object event faces or how it
+// animates, so it doesn't matter if they pause while it's far offscreen.
+static const bool8 sMovementTypeIsIdle[NUM_MOVEMENT_TYPES] = {
+    [MOVEMENT_TYPE_NONE] = TRUE,
+    [MOVEMENT_TYPE_LOOK_AROUND] = TRUE,
+    [MOVEMENT_TYPE_FACE_UP] = TRUE,
+    [MOVEMENT_TYPE_FACE_DOWN] = TRUE,
+    [MOVEMENT_TYPE_FACE_LEFT] = TRUE,
+    [MOVEMENT_TYPE_FACE_RIGHT] = TRUE,
+    [MOVEMENT_TYPE_FACE_DOWN_AND_UP] = TRUE,
+    [MOVEMENT_TYPE_FACE_LEFT_AND_RIGHT] = TRUE,
+    [MOVEMENT_TYPE_FACE_UP_AND_LEFT] = TRUE,
+    [MOVEMENT_TYPE_FACE_UP_AND_RIGHT] = TRUE,
+    [MOVEMENT_TYPE_FACE_DOWN_AND_LEFT] = TRUE,
+    [MOVEMENT_TYPE_FACE_DOWN_AND_RIGHT] = TRUE,
+    [MOVEMENT_TYPE_FACE_DOWN_UP_AND_LEFT] = TRUE,
+    [MOVEMENT_TYPE_FACE_DOWN_UP_AND_RIGHT] = TRUE,
+    [MOVEMENT_TYPE_FACE_UP_LEFT_AND_RIGHT] = TRUE,
+    [MOVEMENT_TYPE_FACE_DOWN_LEFT_AND_RIGHT] = TRUE,
+    [MOVEMENT_TYPE_ROTATE_COUNTERCLOCKWISE] = TRUE,
+    [MOVEMENT_TYPE_ROTATE_CLOCKWISE] = TRUE,
+    [MOVEMENT_TYPE_WALK_IN_PLACE_DOWN] = TRUE,
+    [MOVEMENT_TYPE_WALK_IN_PLACE_UP] = TRUE,
+    [MOVEMENT_TYPE_WALK_IN_PLACE_LEFT] = TRUE,
+    [MOVEMENT_TYPE_WALK_IN_PLACE_RIGHT] = TRUE,
+    [MOVEMENT_TYPE_JOG_IN_PLACE_DOWN] = TRUE,
+    [MOVEMENT_TYPE_JOG_IN_PLACE_UP] = TRUE,
+    [MOVEMENT_TYPE_JOG_IN_PLACE_LEFT] = TRUE,
+    [MOVEMENT_TYPE_JOG_IN_PLACE_RIGHT] = TRUE,
+    [MOVEMENT_TYPE_RUN_IN_PLACE_DOWN] = TRUE,
+    [MOVEMENT_TYPE_RUN_IN_PLACE_UP] = TRUE,
+    [MOVEMENT_TYPE_RUN_IN_PLACE_LEFT] = TRUE,
+    [MOVEMENT_TYPE_RUN_IN_PLACE_RIGHT] = TRUE,
+    [MOVEMENT_TYPE_INVISIBLE] = TRUE,
+    [MOVEMENT_TYPE_WALK_SLOWLY_IN_PLACE_DOWN] = TRUE,
+    [MOVEMENT_TYPE_WALK_SLOWLY_IN_PLACE_UP] = TRUE,
+    [MOVEMENT_TYPE_WALK_SLOWLY_IN_PLACE_LEFT] = TRUE,
+    [MOVEMENT_TYPE_WALK_SLOWLY_IN_PLACE_RIGHT] = TRUE,
+};
+
 const u8 gInitialMovementTypeFacingDirections[] = {
     [MOVEMENT_TYPE_NONE] = DIR_SOUTH,
     [MOVEMENT_TYPE_LOOK_AROUND] = DIR_SOUTH,
@@ -1212,6 +1295,7 @@ static const u8 sPlayerDirectionToCopyDirection[][4] = {
 
 static void ClearObjectEvent(struct ObjectEvent *objectEvent)
 {
+    sSleepingObjectEvents &= ~(1 << (objectEvent - gObjectEvents));
     *objectEvent = (struct ObjectEvent){};
     objectEvent->localId = OBJ_EVENT_ID_PLAYER;
     objectEvent->mapNum = MAP_NUM(UNDEFINED);
@@ -1225,6 +1309,7 @@ static void ClearAllObjectEvents(void)
 
     for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
         ClearObjectEvent(&gObjectEvents[i]);
+    RebuildObjectEventTileBuckets();
 }
 
 void ResetObjectEvents(void)
@@ -1282,13 +1367,15 @@ bool8 TryGetObjectEventIdByLocalIdAndMap(u8 localId, u8 mapNum, u8 mapGroupId, u
 u8 GetObjectEventIdByXY(s16 x, s16 y)
 {
     u8 i;
-    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    u32 bucket = sObjectEventTileBuckets[OBJECT_EVENT_TILE_BUCKET(x, y)];
+
+    for (i = 0; bucket != 0; i++, bucket >>= 1)
     {
-        if (gObjectEvents[i].active && gObjectEvents[i].currentCoords.x == x && gObjectEvents[i].currentCoords.y == y)
-            break;
+        if ((bucket & 1) && gObjectEvents[i].active && gObjectEvents[i].currentCoords.x == x && gObjectEvents[i].currentCoords.y == y)
+            return i;
     }
 
-    return i;
+    return OBJECT_EVENTS_COUNT;
 }
 
 static u8 GetObjectEventIdByLocalIdAndMapInternal(u8 localId, u8 mapNum, u8 mapGroupId)
@@ -1349,6 +1436,7 @@ static u8 InitObjectEventStateFromTemplate(const struct ObjectEventTemplate *tem
     objectEvent->currentCoords.y = y;
     objectEvent->previousCoords.x = x;
     objectEvent->previousCoords.y = y;
+    AddObjectEventToTileBuckets(objectEvent);
     objectEvent->currentElevation = template->elevation;
     objectEvent->previousElevation = template->elevation;
     objectEvent->rangeX = template->movementRangeX;
@@ -1903,50 +1991,74 @@ static const struct ObjectEventGraphicsInfo *SpeciesToGraphicsInfo(u16 species,
     return graphicsInfo;
 }
 
+// Returns the decompressed colors of an overworld Pokémon palette,
+// only decompressing it if it isn't in the cache.
+static const u16 *GetCachedMonPalette(const u32 *palette, u16 palTag)
+{
+    u32 i, oldest = 0;
+
+    for (i = 0; i < OW_MON_PALETTE_CACHE_SIZE; i++)
+    {
+        if (sMonPaletteCache[i].lastUsed != 0 && sMonPaletteCache[i].tag == palTag)
+        {
+            sMonPaletteCache[i].lastUsed = sMonPaletteClock;
+            gMonPaletteCacheStats.cacheHits++;
+            return sMonPaletteCache[i].colors;
+        }
+        if (sMonPaletteCache[i].lastUsed < sMonPaletteCache[oldest].lastUsed)
+            oldest = i;
+    }
+
+    LZDecompressWram(palette, gDecompressionBuffer);
+    CpuCopy16(gDecompressionBuffer, sMonPaletteCache[oldest].colors, PLTT_SIZE_4BPP);
+    sMonPaletteCache[oldest].tag = palTag;
+    sMonPaletteCache[oldest].lastUsed = sMonPaletteClock;
+    gMonPaletteCacheStats.decompressions++;
+    return sMonPaletteCache[oldest].colors;
+}
+
 // Find, or load, the palette for the specified pokemon info
 static u8 LoadDynamicFollowerPalette(u16 species, u8 form, bool32 shiny)
 {
+    struct SpritePalette spritePalette;
     u32 paletteNum;
+
+    gMonPaletteCacheStats.requests++;
+    sMonPaletteClock++;
     // Use standalone palette, unless entry is OOB or NULL (fallback to front-sprite-based)
 #if OW_FOLLOWERS_ENABLED == TRUE && OW_FOLLOWERS_SHARE_PALETTE == FALSE
     if ((shiny && gSpeciesInfo[species].followerPalette)
     || (!shiny && gSpeciesInfo[species].followerShinyPalette))
     {
-        struct SpritePalette spritePalette;
-        u16 palTag = shiny ? (species + SPECIES_SHINY_TAG + OBJ_EVENT_PAL_TAG_DYNAMIC) : (species + OBJ_EVENT_PAL_TAG_DYNAMIC);
-        // palette already loaded
-        if ((paletteNum = IndexOfSpritePaletteTag(palTag)) < 16)
-            return paletteNum;
-        spritePalette.tag = palTag;
+        spritePalette.tag = shiny ? (species + SPECIES_SHINY_TAG + OBJ_EVENT_PAL_TAG_DYNAMIC) : (species + OBJ_EVENT_PAL_TAG_DYNAMIC);
         if (shiny)
             spritePalette.data = gSpeciesInfo[species].followerShinyPalette;
         else
             spritePalette.data = gSpeciesInfo[species].followerPalette;
-        
-        // Check if pal data must be decompressed
-        if (IsLZ77Data(spritePalette.data, PLTT_SIZE_4BPP, PLTT_SIZE_4BPP))
-        {
-            // IsLZ77Data guarantees word-alignment, so casting this is safe
-            LZ77UnCompWram((u32*)spritePalette.data, gDecompressionBuffer);
-            spritePalette.data = (void*)gDecompressionBuffer;
-        }
-        paletteNum = LoadSpritePalette(&spritePalette);
     }
     else
 #endif //OW_FOLLOWERS_SHARE_PALETTE
     {
+        // Use matching front sprite's normal/shiny palettes
         // Note that the shiny palette tag is `species + SPECIES_SHINY_TAG`, which must be increased with more pokemon
         // so that palette tags do not overlap
-        const u32 *palette = GetMonSpritePalFromSpecies(species, shiny, FALSE); //ETODO
-        // palette already loaded
-        if ((paletteNum = IndexOfSpritePaletteTag(species)) < 16)
-            return paletteNum;
-        // Use matching front sprite's normal/shiny palettes
-        // Load compressed palette
-        LoadCompressedSpritePaletteWithTag(palette, species);
-        paletteNum = IndexOfSpritePaletteTag(species); // Tag is always present
+        spritePalette.tag = shiny ? species + SPECIES_SHINY_TAG : species;
+        spritePalette.data = (const u16 *)GetMonSpritePalFromSpecies(species, shiny, FALSE); //ETODO
+    }
+
+    // palette already loaded
+    if ((paletteNum = IndexOfSpritePaletteTag(spritePalette.tag)) < 16)
+    {
+        gMonPaletteCacheStats.slotHits++;
+        return paletteNum;
     }
 
+    // Check if pal data must be decompressed
+    // IsLZ77Data guarantees word-alignment, so casting this is safe
+    if (IsLZ77Data(spritePalette.data, PLTT_SIZE_4BPP, PLTT_SIZE_4BPP))
+        spritePalette.data = GetCachedMonPalette((const u32 *)spritePalette.data, spritePalette.tag);
+    paletteNum = LoadSpritePalette(&spritePalette);
+
     if (gWeatherPtr->currWeather != WEATHER_FOG_HORIZONTAL) // don't want to weather blend in fog
         UpdateSpritePaletteWithWeather(paletteNum);
     return paletteNum;
@@ -2527,6 +2639,7 @@ void SpawnObjectEventsOnReturnToField(s16 x, s16 y)
     u32 i;
 
     ClearPlayerAvatarInfo();
+    sSleepingObjectEvents = 0;
     for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
     {
         if (gObjectEvents[i].active)
@@ -2960,28 +3073,70 @@ void LoadSpecialObjectReflectionPalette(u16 tag, u8 slot)
     }
 }
 
+static void AddObjectEventToTileBuckets(struct ObjectEvent *objectEvent)
+{
+    u32 objectEventId = objectEvent - gObjectEvents;
+
+    if (objectEventId < OBJECT_EVENTS_COUNT)
+    {
+        sObjectEventTileBuckets[OBJECT_EVENT_TILE_BUCKET(objectEvent->currentCoords.x, objectEvent->currentCoords.y)] |= 1 << objectEventId;
+        sObjectEventTileBuckets[OBJECT_EVENT_TILE_BUCKET(objectEvent->previousCoords.x, objectEvent->previousCoords.y)] |= 1 << objectEventId;
+    }
+}
+
+static void RemoveObjectEventFromTileBuckets(struct ObjectEvent *objectEvent)
+{
+    u32 objectEventId = objectEvent - gObjectEvents;
+
+    if (objectEventId < OBJECT_EVENTS_COUNT)
+    {
+        sObjectEventTileBuckets[OBJECT_EVENT_TILE_BUCKET(objectEvent->currentCoords.x, objectEvent->currentCoords.y)] &= ~(1 << objectEventId);
+        sObjectEventTileBuckets[OBJECT_EVENT_TILE_BUCKET(objectEvent->previousCoords.x, objectEvent->previousCoords.y)] &= ~(1 << objectEventId);
+    }
+}
+
+// Must be called after changing object events' coords other than through the
+// functions below.
+void RebuildObjectEventTileBuckets(void)
+{
+    u32 i;
+
+    CpuFill16(0, sObjectEventTileBuckets, sizeof(sObjectEventTileBuckets));
+    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    {
+        if (gObjectEvents[i].active)
+            AddObjectEventToTileBuckets(&gObjectEvents[i]);
+    }
+}
+
 static void UNUSED IncrementObjectEventCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
 {
+    RemoveObjectEventFromTileBuckets(objectEvent);
     objectEvent->previousCoords.x = objectEvent->currentCoords.x;
     objectEvent->previousCoords.y = objectEvent->currentCoords.y;
     objectEvent->currentCoords.x += x;
     objectEvent->currentCoords.y += y;
+    AddObjectEventToTileBuckets(objectEvent);
 }
 
 void ShiftObjectEventCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
 {
+    RemoveObjectEventFromTileBuckets(objectEvent);
     objectEvent->previousCoords.x = objectEvent->currentCoords.x;
     objectEvent->previousCoords.y = objectEvent->currentCoords.y;
     objectEvent->currentCoords.x = x;
     objectEvent->currentCoords.y = y;
+    AddObjectEventToTileBuckets(objectEvent);
 }
 
 static void SetObjectEventCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
 {
+    RemoveObjectEventFromTileBuckets(objectEvent);
     objectEvent->previousCoords.x = x;
     objectEvent->previousCoords.y = y;
     objectEvent->currentCoords.x = x;
     objectEvent->currentCoords.y = y;
+    AddObjectEventToTileBuckets(objectEvent);
 }
 
 void MoveObjectEventToMapCoords(struct ObjectEvent *objectEvent, s16 x, s16 y)
@@ -3040,16 +3195,18 @@ void UpdateObjectEventCoordsForCameraUpdate(void)
                 gObjectEvents[i].previousCoords.y -= dy;
             }
         }
+        RebuildObjectEventTileBuckets();
     }
 }
 
 u8 GetObjectEventIdByPosition(u16 x, u16 y, u8 elevation)
 {
     u8 i;
+    u32 bucket = sObjectEventTileBuckets[OBJECT_EVENT_TILE_BUCKET(x, y)];
 
-    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    for (i = 0; bucket != 0; i++, bucket >>= 1)
     {
-        if (gObjectEvents[i].active)
+        if ((bucket & 1) && gObjectEvents[i].active)
         {
             if (gObjectEvents[i].currentCoords.x == x
              && gObjectEvents[i].currentCoords.y == y
@@ -6151,15 +6308,17 @@ static bool8 IsMetatileDirectionallyImpassable(struct ObjectEvent *objectEvent,
 static bool8 DoesObjectCollideWithObjectAt(struct ObjectEvent *objectEvent, s16 x, s16 y)
 {
     u8 i;
+    u32 bucket;
     struct ObjectEvent *curObject;
 
     if (objectEvent->localId == OBJ_EVENT_ID_FOLLOWER)
         return FALSE; // follower cannot collide with other objects, but they can collide with it
 
-    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    bucket = sObjectEventTileBuckets[OBJECT_EVENT_TILE_BUCKET(x, y)];
+    for (i = 0; bucket != 0; i++, bucket >>= 1)
     {
         curObject = &gObjectEvents[i];
-        if (curObject->active && (curObject->movementType != MOVEMENT_TYPE_FOLLOW_PLAYER || objectEvent != &gObjectEvents[gPlayerAvatar.objectEventId]) && curObject != objectEvent)
+        if ((bucket & 1) && curObject->active && (curObject->movementType != MOVEMENT_TYPE_FOLLOW_PLAYER || objectEvent != &gObjectEvents[gPlayerAvatar.objectEventId]) && curObject != objectEvent)
         {
             if ((curObject->currentCoords.x == x && curObject->currentCoords.y == y) || (curObject->previousCoords.x == x && curObject->previousCoords.y == y))
             {
@@ -6358,6 +6517,9 @@ u8 ObjectEventGetHeldMovementActionId(struct ObjectEvent *objectEvent)
 
 void UpdateObjectEventCurrentMovement(struct ObjectEvent *objectEvent, struct Sprite *sprite, bool8 (*callback)(struct ObjectEvent *, struct Sprite *))
 {
+    if (OW_OBJECT_SLEEP_MARGIN != 0 && UpdateObjectEventSleep(objectEvent, sprite))
+        return;
+
     DoGroundEffects_OnSpawn(objectEvent, sprite);
     TryEnableObjectEventAnim(objectEvent, sprite);
 
@@ -8994,13 +9156,16 @@ static void UpdateObjectEventVisibility(struct ObjectEvent *objectEvent, struct
 }
 
 static void UpdateObjectEventOffscreen(struct ObjectEvent *objectEvent, struct Sprite *sprite)
+{
+    objectEvent->offScreen = IsObjectEventSpriteOutsideView(objectEvent, sprite, 16);
+}
+
+static bool32 IsObjectEventSpriteOutsideView(struct ObjectEvent *objectEvent, struct Sprite *sprite, s32 margin)
 {
     u16 x, y;
     u16 x2, y2;
     const struct ObjectEventGraphicsInfo *graphicsInfo;
 
-    objectEvent->offScreen = FALSE;
-
     graphicsInfo = GetObjectEventGraphicsInfo(objectEvent->graphicsId);
     if (sprite->coordOffsetEnabled)
     {
@@ -9017,11 +9182,61 @@ static void UpdateObjectEventOffscreen(struct ObjectEvent *objectEvent, struct S
     y2 = y;
     y2 += graphicsInfo->height;
 
-    if ((s16)x >= DISPLAY_WIDTH + 16 || (s16)x2 < -16)
-        objectEvent->offScreen = TRUE;
+    if ((s16)x >= DISPLAY_WIDTH + margin || (s16)x2 < -margin)
+        return TRUE;
+
+    if ((s16)y >= DISPLAY_HEIGHT + margin || (s16)y2 < -margin)
+        return TRUE;
+
+    return FALSE;
+}
+
+static bool32 CanObjectEventSleep(struct ObjectEvent *objectEvent, struct Sprite *sprite)
+{
+    return sMovementTypeIsIdle[objectEvent->movementType]
+        && !objectEvent->heldMovementActive
+        && !objectEvent->isPlayer
+        && !objectEvent->trackedByCamera
+        && IsObjectEventSpriteOutsideView(objectEvent, sprite, 16 + OW_OBJECT_SLEEP_MARGIN * 16);
+}
+
+// Returns TRUE if the object event is asleep and shouldn't be updated.
+static bool32 UpdateObjectEventSleep(struct ObjectEvent *objectEvent, struct Sprite *sprite)
+{
+    u32 objectEventId = objectEvent - gObjectEvents;
+    struct ObjectEventSleep *sleep = &sObjectEventSleep[objectEventId];
+    bool32 canSleep = CanObjectEventSleep(objectEvent, sprite);
 
-    if ((s16)y >= DISPLAY_HEIGHT + 16 || (s16)y2 < -16)
-        objectEvent->offScreen = TRUE;
+    if (sSleepingObjectEvents & (1 << objectEventId))
+    {
+        if (canSleep)
+        {
+            sleep->frames++;
+            return TRUE;
+        }
+
+        // Wake up, and catch the anim up to where it would have been.
+        sSleepingObjectEvents &= ~(1 << objectEventId);
+        if (sleep->spriteId == objectEvent->spriteId)
+        {
+            sprite->animPaused = sleep->animPaused;
+            if (!sprite->animPaused)
+                AdvanceSpriteAnim(sprite, sleep->frames);
+        }
+        return FALSE;
+    }
+
+    if (!canSleep)
+        return FALSE;
+
+    sSleepingObjectEvents |= 1 << objectEventId;
+    sleep->frames = 1;
+    sleep->spriteId = objectEvent->spriteId;
+    sleep->animPaused = sprite->animPaused;
+    sprite->animPaused = TRUE;
+    objectEvent->offScreen = TRUE;
+    sprite->invisible = TRUE;
+    return TRUE;
 }
 
 static void UpdateObjectEventSpriteVisibility(struct ObjectEvent *objectEvent, struct Sprite *sprite)
@@ -64,11 +64,13 @@ static const struct ScanlineEffectParams sFlashEffectParams =
 static void FillPalBufferWhite(void)
 {
     CpuFastFill16(RGB_WHITE, gPlttBufferFaded, PLTT_SIZE);
+    MarkPlttBufferDirty(0, PLTT_SIZE);
 }
 
 static void FillPalBufferBlack(void)
 {
     CpuFastFill16(RGB_BLACK, gPlttBufferFaded, PLTT_SIZE);
+    MarkPlttBufferDirty(0, PLTT_SIZE);
 }
 
 void WarpFadeInScreen(void)
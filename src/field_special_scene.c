@@ -265,6 +265,7 @@ void ExecuteTruckSequence(void)
     DrawWholeMapView();
     LockPlayerFieldControls();
     CpuFastFill(0, gPlttBufferFaded, PLTT_SIZE);
+    MarkPlttBufferDirty(0, PLTT_SIZE);
     CreateTask(Task_HandleTruckSequence, 0xA);
 }
 
@@ -467,6 +467,8 @@ static void ApplyColorMap(u8 startPalIndex, u8 numPalettes, s8 colorMapIndex)
     u8 *colorMap;
     u16 i;
 
+    MarkPlttBufferDirty(PLTT_ID(startPalIndex), numPalettes * PLTT_SIZE_4BPP);
+
     if (colorMapIndex > 0)
     {
         colorMapIndex--;
@@ -551,6 +553,7 @@ static void ApplyColorMapWithBlend(u8 startPalIndex, u8 numPalettes, s8 colorMap
     u8 gBlend = color.g;
     u8 bBlend = color.b;
 
+    MarkPlttBufferDirty(PLTT_ID(startPalIndex), numPalettes * PLTT_SIZE_4BPP);
     palOffset = PLTT_ID(startPalIndex);
     numPalettes += startPalIndex;
     colorMapIndex--;
@@ -607,6 +610,7 @@ static void ApplyDroughtColorMapWithBlend(s8 colorMapIndex, u8 blendCoeff, u32 b
     rBlend = color.r;
     gBlend = color.g;
     bBlend = color.b;
+    MarkPlttBufferDirty(0, PLTT_SIZE);
     palOffset = 0;
     for (curPalIndex = 0; curPalIndex < 32; curPalIndex++)
     {
@@ -656,6 +660,7 @@ static void ApplyFogBlend(u8 blendCoeff, u32 blendColor)
     u16 curPalIndex;
 
     BlendPalette(BG_PLTT_ID(0), 16 * 16, blendCoeff, blendColor);
+    MarkPlttBufferDirty(OBJ_PLTT_OFFSET, 16 * PLTT_SIZE_4BPP);
     color = *(struct RGBColor *)&blendColor;
     rBlend = color.r;
     gBlend = color.g;
@@ -818,19 +823,21 @@ void UpdateSpritePaletteWithWeather(u8 spritePaletteIndex)
     switch (gWeatherPtr->palProcessingState)
     {
     case WEATHER_PAL_STATE_SCREEN_FADING_IN:
-        if (gWeatherPtr->fadeInFirstFrame)
+        if (gWeatherPtr->fadeInFirstFrame && !IsBrightnessPaletteFadeActive())
         {
             if (gWeatherPtr->currWeather == WEATHER_FOG_HORIZONTAL)
                 MarkFogSpritePalToLighten(paletteIndex);
             paletteIndex = PLTT_ID(paletteIndex);
             for (i = 0; i < 16; i++)
                 gPlttBufferFaded[paletteIndex + i] = gWeatherPtr->fadeDestColor;
+            MarkPlttBufferDirty(paletteIndex, PLTT_SIZE_4BPP);
         }
         break;
     case WEATHER_PAL_STATE_SCREEN_FADING_OUT:
         paletteIndex = PLTT_ID(paletteIndex);
         CpuFastCopy(&gPlttBufferFaded[paletteIndex], &gPlttBufferUnfaded[paletteIndex], PLTT_SIZE_4BPP);
-        BlendPalette(paletteIndex, 16, gPaletteFade.y, gPaletteFade.blendColor);
+        if (!IsBrightnessPaletteFadeActive())
+            BlendPalette(paletteIndex, 16, gPaletteFade.y, gPaletteFade.blendColor);
         break;
     // WEATHER_PAL_STATE_CHANGING_WEATHER
     // WEATHER_PAL_STATE_CHANGING_IDLE
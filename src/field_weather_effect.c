@@ -1362,6 +1362,7 @@ u8 UpdateShadowColor(u16 color) {
   if (paletteNum != 0xFF) {
     u16 index = (paletteNum+16)*16+SHADOW_COLOR_INDEX;
     gPlttBufferUnfaded[index] = gPlttBufferFaded[index] = color;
+    MarkPlttBufferDirty(index, PLTT_SIZEOF(1));
   }
   return paletteNum;
 }
@@ -35,6 +35,12 @@ EWRAM_DATA struct Camera gCamera = {0};
 EWRAM_DATA static struct ConnectionFlags sMapConnectionFlags = {0};
 EWRAM_DATA static u32 UNUSED sFiller = 0; // without this, the next file won't align properly
 
+// The current layout's metatile behaviors and layer types, by metatile id.
+// They're looked up several times per step for every object event, so they're
+// split out of the tilesets' attributes whenever the layout changes.
+EWRAM_DATA static u8 sMetatileBehaviors[NUM_METATILES_TOTAL] = {0};
+EWRAM_DATA static u8 sMetatileLayerTypes[NUM_METATILES_TOTAL] = {0};
+
 struct BackupMapLayout gBackupMapLayout;
 
 static const struct ConnectionFlags sDummyConnectionFlags = {0};
@@ -414,14 +420,12 @@ u32 MapGridGetMetatileIdAt(int x, int y)
 
 u32 MapGridGetMetatileBehaviorAt(int x, int y)
 {
-    u16 metatile = MapGridGetMetatileIdAt(x, y);
-    return GetMetatileAttributesById(metatile) & METATILE_ATTR_BEHAVIOR_MASK;
+    return sMetatileBehaviors[MapGridGetMetatileIdAt(x, y)];
 }
 
 u8 MapGridGetMetatileLayerTypeAt(int x, int y)
 {
-    u16 metatile = MapGridGetMetatileIdAt(x, y);
-    return (GetMetatileAttributesById(metatile) & METATILE_ATTR_LAYER_MASK) >> METATILE_ATTR_LAYER_SHIFT;
+    return sMetatileLayerTypes[MapGridGetMetatileIdAt(x, y)];
 }
 
 void MapGridSetMetatileIdAt(int x, int y, u16 metatile)
@@ -463,6 +467,26 @@ u16 GetMetatileAttributesById(u16 metatile)
     }
 }
 
+static void LoadTilesetMetatileAttributes(struct Tileset const *tileset, u32 firstMetatile, u32 count)
+{
+    u32 i;
+    u16 attributes;
+
+    for (i = 0; i < count; i++)
+    {
+        attributes = tileset ? tileset->metatileAttributes[i] : 0;
+        sMetatileBehaviors[firstMetatile + i] = attributes & METATILE_ATTR_BEHAVIOR_MASK;
+        sMetatileLayerTypes[firstMetatile + i] = (attributes & METATILE_ATTR_LAYER_MASK) >> METATILE_ATTR_LAYER_SHIFT;
+    }
+}
+
+// Must be called whenever gMapHeader.mapLayout changes.
+void LoadMetatileAttributes(struct MapLayout const *mapLayout)
+{
+    LoadTilesetMetatileAttributes(mapLayout->primaryTileset, 0, NUM_METATILES_IN_PRIMARY);
+    LoadTilesetMetatileAttributes(mapLayout->secondaryTileset, NUM_METATILES_IN_PRIMARY, NUM_METATILES_TOTAL - NUM_METATILES_IN_PRIMARY);
+}
+
 void SaveMapView(void)
 {
     int i, j;
@@ -34,6 +34,7 @@
 #include "constants/event_objects.h"
 #include "constants/songs.h"
 
+EWRAM_DATA static struct Arena sFloorPreviewArena = {0};
 EWRAM_DATA static u32 * sMapPreviewTilemapPtr = NULL;
 EWRAM_DATA u8 gNumSpeciesInFloor = 0; // num unique species in the current floor
 EWRAM_DATA u16 gFloorSpeciesList[MAX_FLOOR_SPECIES] = {0};
@@ -143,7 +144,8 @@ void CB2_FloorPreview(void)
             gMain.state++;
             break;
         case 3:
-            sMapPreviewTilemapPtr = AllocZeroed(BG_SCREEN_SIZE);
+            ArenaOpen(&sFloorPreviewArena, BG_SCREEN_SIZE);
+            sMapPreviewTilemapPtr = ArenaAllocZeroed(&sFloorPreviewArena, BG_SCREEN_SIZE);
             ResetBgsAndClearDma3BusyFlags(0);
             InitBgsFromTemplates(0, sFloorPreviewBgTemplates, ARRAY_COUNT(sFloorPreviewBgTemplates));
             SetBgTilemapBuffer(2, sMapPreviewTilemapPtr);
@@ -186,7 +188,7 @@ void CB2_FloorPreview(void)
 static void Task_FloorPreviewExitAndWarp(u8 taskId)
 {
     TryWarpToRoom(STARTING_ROOM, 0);
-    Free(sMapPreviewTilemapPtr);
+    ArenaClose(&sFloorPreviewArena);
     sMapPreviewTilemapPtr = NULL;
     FreeAllWindowBuffers();
     ResetSpriteData();
@@ -1,6 +1,7 @@
 #include "global.h"
 #include "malloc.h"
 #include "berry_powder.h"
+#include "event_object_movement.h"
 #include "item.h"
 #include "load_save.h"
 #include "main.h"
@@ -238,6 +239,7 @@ void LoadObjectEvents(void)
             gObjectEvents[i].graphicsId >= OBJ_EVENT_GFX_MON_BASE)
             gObjectEvents[i].active = TRUE;
     }
+    RebuildObjectEventTileBuckets();
 }
 
 void CopyPartyAndObjectsToSave(void)
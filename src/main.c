@@ -167,6 +167,7 @@ void AgbMainLoop(void)
 
         PlayTimeCounter_Update();
         MapMusicMain();
+        CopyPendingBgTilemapBandsToVram();
         WaitForVBlank();
     }
 }
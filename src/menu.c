@@ -2,6 +2,7 @@
 #include "malloc.h"
 #include "bg.h"
 #include "blit.h"
+#include "decompress.h"
 #include "dma3.h"
 #include "event_data.h"
 #include "field_weather.h"
@@ -1845,7 +1846,7 @@ void *malloc_and_decompress(const void *src, u32 *size)
 
     ptr = Alloc(*size);
     if (ptr)
-        LZ77UnCompWram(src, ptr);
+        LZDecompressWram(src, ptr);
     return ptr;
 }
 
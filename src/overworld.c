@@ -621,12 +621,14 @@ static void LoadCurrentMapData(void)
     gMapHeader = *Overworld_GetMapHeaderByGroupAndId(gSaveBlock1Ptr->location.mapGroup, gSaveBlock1Ptr->location.mapNum);
     gSaveBlock1Ptr->mapLayoutId = gMapHeader.mapLayoutId;
     gMapHeader.mapLayout = GetMapLayout(gMapHeader.mapLayoutId);
+    LoadMetatileAttributes(gMapHeader.mapLayout);
 }
 
 static void LoadSaveblockMapHeader(void)
 {
     gMapHeader = *Overworld_GetMapHeaderByGroupAndId(gSaveBlock1Ptr->location.mapGroup, gSaveBlock1Ptr->location.mapNum);
     gMapHeader.mapLayout = GetMapLayout(gMapHeader.mapLayoutId);
+    LoadMetatileAttributes(gMapHeader.mapLayout);
 }
 
 static void SetPlayerCoordsFromWarp(void)
@@ -1043,6 +1045,7 @@ void SetCurrentMapLayout(u16 mapLayoutId)
 {
     gSaveBlock1Ptr->mapLayoutId = mapLayoutId;
     gMapHeader.mapLayout = GetMapLayout(mapLayoutId);
+    LoadMetatileAttributes(gMapHeader.mapLayout);
 }
 
 void SetObjectEventLoadFlag(u8 flag)
@@ -1844,7 +1847,7 @@ static void VBlankCB_Field(void)
     ProcessSpriteCopyRequests();
     ScanlineEffect_InitHBlankDmaTransfer();
     FieldUpdateBgTilemapScroll();
-    TransferPlttBuffer();
+    TransferDirtyPlttBuffer();
     TransferTilesetAnimsBuffer();
 }
 
@@ -3022,6 +3025,7 @@ static void InitLinkPlayerObjectEventPos(struct ObjectEvent *objEvent, s16 x, s1
     objEvent->currentCoords.y = y;
     objEvent->previousCoords.x = x;
     objEvent->previousCoords.y = y;
+    RebuildObjectEventTileBuckets();
     SetSpritePosToMapCoords(x, y, &objEvent->initialCoords.x, &objEvent->initialCoords.y);
     objEvent->initialCoords.x += 8;
     ObjectEventUpdateElevation(objEvent, NULL);
@@ -3,6 +3,7 @@
 #include "util.h"
 #include "decompress.h"
 #include "gpu_regs.h"
+#include "main.h"
 #include "task.h"
 #include "constants/rgb.h"
 
@@ -11,6 +12,7 @@ enum
     NORMAL_FADE,
     FAST_FADE,
     HARDWARE_FADE,
+    BRIGHTNESS_FADE,
 };
 
 // These are structs for some unused palette system.
@@ -53,6 +55,16 @@ static void BeginFastPaletteFadeInternal(u8);
 static u8 UpdateFastPaletteFade(void);
 static u8 UpdateHardwarePaletteFade(void);
 static void UpdateBlendRegisters(void);
+static bool8 BeginPaletteFadeInternal(u32 selectedPalettes, s8 delay, u8 startY, u8 targetY, u16 blendColor, bool32 useBrightness);
+static bool8 CanUseBrightnessFade(u32 selectedPalettes, u16 blendColor);
+static bool8 CanKeepBrightnessFade(void);
+static bool8 AreBrightnessFadeRegistersUnchanged(void);
+static void BeginBrightnessFade(void);
+static u8 UpdateBrightnessPaletteFade(void);
+static void EndBrightnessFade(void);
+static void RestoreBlendRegisters(void);
+static void StepPaletteFadeY(void);
+static void UpdateFadeRegisters(void);
 static bool8 IsSoftwarePaletteFadeFinishing(void);
 static void Task_BlendPalettesGradually(u8 taskId);
 
@@ -63,6 +75,17 @@ ALIGNED(4) EWRAM_DATA u16 gPlttBufferFaded[PLTT_BUFFER_SIZE] = {0};
 static EWRAM_DATA struct PaletteStruct sPaletteStructs[NUM_PALETTE_STRUCTS] = {0};
 EWRAM_DATA struct PaletteFadeControl gPaletteFade = {0};
 static EWRAM_DATA u32 sPlttBufferTransferPending = 0;
+static EWRAM_DATA u16 sBrightnessFadeBldCnt = 0;
+static EWRAM_DATA u16 sSavedBldCnt = 0;
+static EWRAM_DATA u16 sSavedBldY = 0;
+// What the brightness fade last wrote, to tell when something else changes
+// the registers.
+static EWRAM_DATA u16 sWrittenBldCnt = 0;
+static EWRAM_DATA u16 sWrittenBldY = 0;
+static EWRAM_DATA bool8 sBlendRegistersRestorePending = FALSE;
+static EWRAM_DATA u32 sPlttBufferDirtyBanks = 0;
+static EWRAM_DATA bool8 sPlttBufferDirtyTracked = FALSE;
+EWRAM_DATA struct PlttTransferStats gPlttTransferStats = {0};
 EWRAM_DATA u8 ALIGNED(2) gPaletteDecompressionBuffer[PLTT_SIZE] = {0};
 
 static const struct PaletteStructTemplate sDummyPaletteStructTemplate = {
@@ -85,18 +108,48 @@ void LoadCompressedPalette(const u32 *src, u16 offset, u16 size)
     LZDecompressWram(src, gPaletteDecompressionBuffer);
     CpuCopy16(gPaletteDecompressionBuffer, &gPlttBufferUnfaded[offset], size);
     CpuCopy16(gPaletteDecompressionBuffer, &gPlttBufferFaded[offset], size);
+    MarkPlttBufferDirty(offset, size);
 }
 
 void LoadPalette(const void *src, u16 offset, u16 size)
 {
     CpuCopy16(src, &gPlttBufferUnfaded[offset], size);
     CpuCopy16(src, &gPlttBufferFaded[offset], size);
+    MarkPlttBufferDirty(offset, size);
 }
 
 void FillPalette(u16 value, u16 offset, u16 size)
 {
     CpuFill16(value, &gPlttBufferUnfaded[offset], size);
     CpuFill16(value, &gPlttBufferFaded[offset], size);
+    MarkPlttBufferDirty(offset, size);
+}
+
+// Marks the 16-color banks that size bytes of colors at offset fall in, so
+// TransferDirtyPlttBuffer copies them. Anything that writes gPlttBufferFaded
+// itself, instead of through the functions here, has to call this.
+void MarkPlttBufferDirty(u16 offset, u16 size)
+{
+    u32 firstBank, lastBank;
+
+    if (size == 0 || offset >= PLTT_BUFFER_SIZE)
+        return;
+
+    firstBank = offset / 16;
+    lastBank = (offset + (size - 1) / 2) / 16;
+    if (lastBank > 31)
+        lastBank = 31;
+
+    sPlttBufferDirtyBanks |= (((u32)2 << lastBank) - 1) & ~(((u32)1 << firstBank) - 1);
+}
+
+static void RecordPlttTransfer(u32 size)
+{
+    gPlttTransferStats.transfers++;
+    gPlttTransferStats.totalBytes += size;
+    gPlttTransferStats.lastBytes = size;
+    if (gPlttTransferStats.peakBytes < size)
+        gPlttTransferStats.peakBytes = size;
 }
 
 void TransferPlttBuffer(void)
@@ -107,11 +160,78 @@ void TransferPlttBuffer(void)
         void *dest = (void *)PLTT;
         DmaCopy16(3, src, dest, PLTT_SIZE);
         sPlttBufferTransferPending = FALSE;
-        if (gPaletteFade.mode == HARDWARE_FADE && gPaletteFade.active)
-            UpdateBlendRegisters();
+        sPlttBufferDirtyBanks = 0;
+        sPlttBufferDirtyTracked = FALSE;
+        RecordPlttTransfer(PLTT_SIZE);
+        UpdateFadeRegisters();
     }
 }
 
+// Like TransferPlttBuffer, but only copies the banks marked dirty since the
+// last transfer, which leaves more of VBlank for other DMA. It's only for
+// screens where everything that writes gPlttBufferFaded marks what it
+// changed, like the overworld.
+void TransferDirtyPlttBuffer(void)
+{
+    if (!gPaletteFade.bufferTransferDisabled)
+    {
+        u32 dirtyBanks = sPlttBufferDirtyBanks;
+        u32 bank = 0;
+        u32 size = 0;
+
+        // Other screens' writes aren't marked, so the first transfer after
+        // a full one has to copy everything.
+        if (!sPlttBufferDirtyTracked)
+            dirtyBanks = PALETTES_ALL;
+
+        while (dirtyBanks != 0)
+        {
+            u32 count = 0;
+
+            while (!(dirtyBanks & 1))
+            {
+                dirtyBanks >>= 1;
+                bank++;
+            }
+            while (dirtyBanks & 1)
+            {
+                dirtyBanks >>= 1;
+                count++;
+            }
+
+            DmaCopy16(3, &gPlttBufferFaded[PLTT_ID(bank)], (u16 *)PLTT + PLTT_ID(bank), count * PLTT_SIZE_4BPP);
+            bank += count;
+            size += count * PLTT_SIZE_4BPP;
+        }
+
+        sPlttBufferTransferPending = FALSE;
+        sPlttBufferDirtyBanks = 0;
+        sPlttBufferDirtyTracked = TRUE;
+        RecordPlttTransfer(size);
+        UpdateFadeRegisters();
+    }
+}
+
+static void UpdateFadeRegisters(void)
+{
+    if (gPaletteFade.mode == HARDWARE_FADE && gPaletteFade.active)
+    {
+        UpdateBlendRegisters();
+    }
+    else if (gPaletteFade.mode == BRIGHTNESS_FADE && AreBrightnessFadeRegistersUnchanged())
+    {
+        // Otherwise the screen has set up its own blend, and
+        // UpdateBrightnessPaletteFade hands the fade over to software.
+        sWrittenBldCnt = sBrightnessFadeBldCnt;
+        sWrittenBldY = gPaletteFade.y;
+        SetGpuReg(REG_OFFSET_BLDCNT, sWrittenBldCnt);
+        SetGpuReg(REG_OFFSET_BLDY, sWrittenBldY);
+    }
+
+    if (sBlendRegistersRestorePending)
+        RestoreBlendRegisters();
+}
+
 u8 UpdatePaletteFade(void)
 {
     u8 result;
@@ -124,11 +244,18 @@ u8 UpdatePaletteFade(void)
         result = UpdateNormalPaletteFade();
     else if (gPaletteFade.mode == FAST_FADE)
         result = UpdateFastPaletteFade();
+    else if (gPaletteFade.mode == BRIGHTNESS_FADE)
+        result = UpdateBrightnessPaletteFade();
     else
         result = UpdateHardwarePaletteFade();
 
     sPlttBufferTransferPending = gPaletteFade.multipurpose1 | dummy;
 
+    // The final colors of a brightness fade have to be copied in the same
+    // VBlank that turns the brightness effect back off.
+    if (sBlendRegistersRestorePending)
+        sPlttBufferTransferPending = TRUE;
+
     return result;
 }
 
@@ -152,9 +279,24 @@ static void ReadPlttIntoBuffers(void)
         gPlttBufferUnfaded[i] = pltt[i];
         gPlttBufferFaded[i] = pltt[i];
     }
+    sPlttBufferDirtyBanks = PALETTES_ALL;
 }
 
 bool8 BeginNormalPaletteFade(u32 selectedPalettes, s8 delay, u8 startY, u8 targetY, u16 blendColor)
+{
+    return BeginPaletteFadeInternal(selectedPalettes, delay, startY, targetY, blendColor, FALSE);
+}
+
+// Like BeginNormalPaletteFade, but a fade of every palette to black or white
+// only changes BLDCNT/BLDY each step instead of blending all 512 colors. Only
+// for screens that don't set up blending, windows or semi-transparent sprites
+// while the fade runs. If they do anyway, the fade finishes in software.
+bool8 BeginBrightnessPaletteFade(u32 selectedPalettes, s8 delay, u8 startY, u8 targetY, u16 blendColor)
+{
+    return BeginPaletteFadeInternal(selectedPalettes, delay, startY, targetY, blendColor, TRUE);
+}
+
+static bool8 BeginPaletteFadeInternal(u32 selectedPalettes, s8 delay, u8 startY, u8 targetY, u16 blendColor, bool32 useBrightness)
 {
     u8 temp;
     u16 color = blendColor;
@@ -187,8 +329,16 @@ bool8 BeginNormalPaletteFade(u32 selectedPalettes, s8 delay, u8 startY, u8 targe
         else
             gPaletteFade.yDec = 1;
 
+        if (useBrightness && CanUseBrightnessFade(selectedPalettes, color))
+            BeginBrightnessFade();
+
         UpdatePaletteFade();
 
+        // The palettes and BLDY have to change in the same VBlank, or the
+        // unfaded colors would show for a frame, so TransferPlttBuffer does both.
+        if (gPaletteFade.mode == BRIGHTNESS_FADE)
+            return TRUE;
+
         temp = gPaletteFade.bufferTransferDisabled;
         gPaletteFade.bufferTransferDisabled = FALSE;
         CpuCopy32(gPlttBufferFaded, (void *)PLTT, PLTT_SIZE);
@@ -264,6 +414,7 @@ static void PaletteStruct_Copy(struct PaletteStruct *palStruct, u32 *unkFlags)
     }
 
     palStruct->destOffset = palStruct->baseDestOffset;
+    MarkPlttBufferDirty(palStruct->baseDestOffset, PLTT_SIZEOF(palStruct->template->size));
     palStruct->countdown1 = palStruct->template->time1;
     palStruct->srcIndex++;
 
@@ -306,6 +457,7 @@ static void PaletteStruct_Blend(struct PaletteStruct *palStruct, u32 *unkFlags)
 
                     for (i = 0; i < palStruct->template->size; i++)
                         gPlttBufferFaded[palStruct->baseDestOffset + i] = palStruct->template->src[srcOffset + i];
+                    MarkPlttBufferDirty(palStruct->baseDestOffset, PLTT_SIZEOF(palStruct->template->size));
                 }
             }
         }
@@ -361,6 +513,16 @@ static void PaletteStruct_Reset(u8 paletteNum)
 
 void ResetPaletteFadeControl(void)
 {
+    // A brightness fade that's stopped partway keeps its current brightness,
+    // blended into the palettes right away.
+    if (gPaletteFade.mode == BRIGHTNESS_FADE)
+        EndBrightnessFade();
+    if (sBlendRegistersRestorePending)
+    {
+        CpuCopy32(gPlttBufferFaded, (void *)PLTT, PLTT_SIZE);
+        RestoreBlendRegisters();
+    }
+
     gPaletteFade.multipurpose1 = 0;
     gPaletteFade.multipurpose2 = 0;
     gPaletteFade.delayCounter = 0;
@@ -463,24 +625,7 @@ static u8 UpdateNormalPaletteFade(void)
             }
             else
             {
-                s8 val;
-
-                if (!gPaletteFade.yDec)
-                {
-                    val = gPaletteFade.y;
-                    val += gPaletteFade.deltaY;
-                    if (val > gPaletteFade.targetY)
-                        val = gPaletteFade.targetY;
-                    gPaletteFade.y = val;
-                }
-                else
-                {
-                    val = gPaletteFade.y;
-                    val -= gPaletteFade.deltaY;
-                    if (val < gPaletteFade.targetY)
-                        val = gPaletteFade.targetY;
-                    gPaletteFade.y = val;
-                }
+                StepPaletteFadeY();
             }
         }
 
@@ -490,10 +635,166 @@ static u8 UpdateNormalPaletteFade(void)
     }
 }
 
+static void StepPaletteFadeY(void)
+{
+    s8 val;
+
+    if (!gPaletteFade.yDec)
+    {
+        val = gPaletteFade.y;
+        val += gPaletteFade.deltaY;
+        if (val > gPaletteFade.targetY)
+            val = gPaletteFade.targetY;
+        gPaletteFade.y = val;
+    }
+    else
+    {
+        val = gPaletteFade.y;
+        val -= gPaletteFade.deltaY;
+        if (val < gPaletteFade.targetY)
+            val = gPaletteFade.targetY;
+        gPaletteFade.y = val;
+    }
+}
+
+// A fade of every palette to black or white is the same as the brightness
+// effect, which the PPU applies for free. Anything that would keep the effect
+// from covering the whole screen rules it out.
+static bool8 CanUseBrightnessFade(u32 selectedPalettes, u16 blendColor)
+{
+    if (selectedPalettes != PALETTES_ALL)
+        return FALSE;
+
+    if (blendColor != RGB_BLACK && blendColor != RGB_WHITE)
+        return FALSE;
+
+    // The screen's own blend effect would be replaced.
+    if (GetGpuReg(REG_OFFSET_BLDCNT) & BLDCNT_EFFECT_DARKEN)
+        return FALSE;
+
+    return CanKeepBrightnessFade();
+}
+
+// Checked again on every step, since the screen can change while it fades.
+static bool8 CanKeepBrightnessFade(void)
+{
+    u32 i;
+
+    // Windows can turn the effect off in part of the screen.
+    if (GetGpuReg(REG_OFFSET_DISPCNT) & (DISPCNT_WIN0_ON | DISPCNT_WIN1_ON | DISPCNT_OBJWIN_ON))
+        return FALSE;
+
+    // Semi-transparent sprites are alpha blended, which ignores BLDY.
+    for (i = 0; i < ARRAY_COUNT(gMain.oamBuffer); i++)
+    {
+        if (gMain.oamBuffer[i].objMode == ST_OAM_OBJ_BLEND && gMain.oamBuffer[i].affineMode != ST_OAM_AFFINE_ERASE)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+static bool8 AreBrightnessFadeRegistersUnchanged(void)
+{
+    return GetGpuReg(REG_OFFSET_BLDCNT) == sWrittenBldCnt
+        && GetGpuReg(REG_OFFSET_BLDY) == sWrittenBldY;
+}
+
+static void BeginBrightnessFade(void)
+{
+    gPaletteFade.mode = BRIGHTNESS_FADE;
+    sSavedBldCnt = GetGpuReg(REG_OFFSET_BLDCNT);
+    sSavedBldY = GetGpuReg(REG_OFFSET_BLDY);
+    sWrittenBldCnt = sSavedBldCnt;
+    sWrittenBldY = sSavedBldY;
+    if (gPaletteFade.blendColor == RGB_WHITE)
+        sBrightnessFadeBldCnt = BLDCNT_TGT1_ALL | BLDCNT_EFFECT_LIGHTEN;
+    else
+        sBrightnessFadeBldCnt = BLDCNT_TGT1_ALL | BLDCNT_EFFECT_DARKEN;
+
+    // The PPU does the blending, so the unfaded colors are what get copied.
+    CpuFastCopy(gPlttBufferUnfaded, gPlttBufferFaded, PLTT_SIZE);
+    sPlttBufferDirtyBanks = PALETTES_ALL;
+}
+
+static u8 UpdateBrightnessPaletteFade(void)
+{
+    if (!gPaletteFade.active)
+        return PALETTE_FADE_STATUS_DONE;
+
+    // The screen set up its own blend, windows or semi-transparent sprites
+    // partway through, so the rest of the fade is blended in software.
+    if (!AreBrightnessFadeRegistersUnchanged() || !CanKeepBrightnessFade())
+    {
+        EndBrightnessFade();
+        return UpdateNormalPaletteFade();
+    }
+
+    if (!gPaletteFade.objPaletteToggle)
+    {
+        if (gPaletteFade.delayCounter < gPaletteFade_delay)
+        {
+            gPaletteFade.delayCounter++;
+            return PALETTE_FADE_STATUS_DELAY;
+        }
+        gPaletteFade.delayCounter = 0;
+    }
+
+    // Keeps the pace of the software fade, which blends the BG and OBJ
+    // palettes on alternate updates.
+    gPaletteFade.objPaletteToggle ^= 1;
+
+    if (!gPaletteFade.objPaletteToggle)
+    {
+        if (gPaletteFade.y == gPaletteFade.targetY)
+        {
+            EndBrightnessFade();
+            gPaletteFade_selectedPalettes = 0;
+            gPaletteFade.softwareFadeFinishing = TRUE;
+        }
+        else
+        {
+            StepPaletteFadeY();
+        }
+    }
+
+    return PALETTE_FADE_STATUS_ACTIVE;
+}
+
+// Blends the palettes to the brightness the fade is at, so the screen keeps
+// looking the same once the effect is turned off. From here the fade finishes
+// like a software one.
+static void EndBrightnessFade(void)
+{
+    BlendPalettes(PALETTES_ALL, gPaletteFade.y, gPaletteFade.blendColor);
+    gPaletteFade.mode = NORMAL_FADE;
+    sBlendRegistersRestorePending = TRUE;
+}
+
+// Only puts back the registers that still hold what the fade wrote, so a
+// blend the screen set up in the meantime is kept.
+static void RestoreBlendRegisters(void)
+{
+    if (GetGpuReg(REG_OFFSET_BLDCNT) == sWrittenBldCnt)
+        SetGpuReg(REG_OFFSET_BLDCNT, sSavedBldCnt);
+    if (GetGpuReg(REG_OFFSET_BLDY) == sWrittenBldY)
+        SetGpuReg(REG_OFFSET_BLDY, sSavedBldY);
+    sBlendRegistersRestorePending = FALSE;
+}
+
+// During a brightness fade the palette buffers hold unfaded colors, so
+// palettes loaded partway through the fade shouldn't be blended to match it.
+bool8 IsBrightnessPaletteFadeActive(void)
+{
+    return gPaletteFade.mode == BRIGHTNESS_FADE;
+}
+
 void InvertPlttBuffer(u32 selectedPalettes)
 {
     u16 paletteOffset = 0;
 
+    sPlttBufferDirtyBanks |= selectedPalettes;
+
     while (selectedPalettes)
     {
         if (selectedPalettes & 1)
@@ -511,6 +812,8 @@ void TintPlttBuffer(u32 selectedPalettes, s8 r, s8 g, s8 b)
 {
     u16 paletteOffset = 0;
 
+    sPlttBufferDirtyBanks |= selectedPalettes;
+
     while (selectedPalettes)
     {
         if (selectedPalettes & 1)
@@ -533,6 +836,8 @@ void UnfadePlttBuffer(u32 selectedPalettes)
 {
     u16 paletteOffset = 0;
 
+    sPlttBufferDirtyBanks |= selectedPalettes;
+
     while (selectedPalettes)
     {
         if (selectedPalettes & 1)
@@ -565,6 +870,8 @@ static void BeginFastPaletteFadeInternal(u8 submode)
     if (submode == FAST_FADE_IN_FROM_WHITE)
         CpuFill16(RGB_WHITE, gPlttBufferFaded, PLTT_SIZE);
 
+    sPlttBufferDirtyBanks = PALETTES_ALL;
+
     UpdatePaletteFade();
 }
 
@@ -586,6 +893,7 @@ static u8 UpdateFastPaletteFade(void)
     if (IsSoftwarePaletteFadeFinishing())
         return gPaletteFade.active ? PALETTE_FADE_STATUS_ACTIVE : PALETTE_FADE_STATUS_DONE;
 
+    sPlttBufferDirtyBanks = PALETTES_ALL;
 
     if (gPaletteFade.objPaletteToggle)
     {
@@ -845,6 +1153,7 @@ void BlendPalettesUnfaded(u32 selectedPalettes, u8 coeff, u16 color)
     void *src = gPlttBufferUnfaded;
     void *dest = gPlttBufferFaded;
     DmaCopy32(3, src, dest, PLTT_SIZE);
+    sPlttBufferDirtyBanks = PALETTES_ALL;
     BlendPalettes(selectedPalettes, coeff, color);
 }
 
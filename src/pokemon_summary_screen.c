@@ -36,6 +36,7 @@
 #include "scanline_effect.h"
 #include "sound.h"
 #include "sprite.h"
+#include "static_text.h"
 #include "string_util.h"
 #include "strings.h"
 #include "task.h"
@@ -197,6 +198,8 @@ static EWRAM_DATA struct PokemonSummaryScreenData
     u8 categoryIconSpriteId;
 } *sMonSummaryScreen = NULL;
 
+static EWRAM_DATA struct Arena sSummaryArena = {0};
+
 EWRAM_DATA u8 gLastViewedMonIndex = 0;
 static EWRAM_DATA u8 sMoveSlotToReplace = 0;
 ALIGNED(4) static EWRAM_DATA u8 sAnimDelayTaskId = 0;
@@ -1161,7 +1164,15 @@ static void DestroyCategoryIcon(void)
 
 void ShowPokemonSummaryScreen(u8 mode, void *mons, u8 monIndex, u8 maxMonIndex, void (*callback)(void))
 {
-    sMonSummaryScreen = AllocZeroed(sizeof(*sMonSummaryScreen));
+    if (!ArenaOpen(&sSummaryArena, sizeof(*sMonSummaryScreen) + SUMMARY_SCRATCH_SIZE))
+    {
+        // Alloc failed, exit as if the player had backed out
+        sMonSummaryScreen = NULL;
+        sMoveSlotToReplace = MAX_MON_MOVES;
+        SetMainCallback2(callback);
+        return;
+    }
+    sMonSummaryScreen = ArenaAllocZeroed(&sSummaryArena, sizeof(*sMonSummaryScreen));
     sMonSummaryScreen->mode = mode;
     sMonSummaryScreen->monList.mons = mons;
     sMonSummaryScreen->curMonIndex = monIndex;
@@ -1205,13 +1216,15 @@ void ShowPokemonSummaryScreen(u8 mode, void *mons, u8 monIndex, u8 maxMonIndex,
 void ShowSelectMovePokemonSummaryScreen(struct Pokemon *mons, u8 monIndex, u8 maxMonIndex, void (*callback)(void), u16 newMove)
 {
     ShowPokemonSummaryScreen(SUMMARY_MODE_SELECT_MOVE, mons, monIndex, maxMonIndex, callback);
-    sMonSummaryScreen->newMove = newMove;
+    if (sMonSummaryScreen != NULL)
+        sMonSummaryScreen->newMove = newMove;
 }
 
 void ShowPokemonSummaryScreenHandleDeoxys(u8 mode, struct BoxPokemon *mons, u8 monIndex, u8 maxMonIndex, void (*callback)(void))
 {
     ShowPokemonSummaryScreen(mode, mons, monIndex, maxMonIndex, callback);
-    sMonSummaryScreen->handleDeoxys = TRUE;
+    if (sMonSummaryScreen != NULL)
+        sMonSummaryScreen->handleDeoxys = TRUE;
 }
 
 static void MainCB2(void)
@@ -1571,7 +1584,7 @@ static void SetDefaultTilemaps(void)
 static void FreeSummaryScreen(void)
 {
     FreeAllWindowBuffers();
-    Free(sMonSummaryScreen);
+    ArenaClose(&sSummaryArena);
 }
 
 static void BeginCloseSummaryScreen(u8 taskId)
@@ -2421,7 +2434,8 @@ u8 GetMoveSlotToReplace(void)
 
 static void DrawPagination(void) // Updates the pagination dots at the top of the summary screen
 {
-    u16 *tilemap = Alloc(8 * PSS_PAGE_COUNT);
+    u32 scratch = ArenaMark(&sSummaryArena);
+    u16 *tilemap = ArenaAlloc(&sSummaryArena, 8 * PSS_PAGE_COUNT);
     u8 i;
 
     for (i = 0; i < PSS_PAGE_COUNT; i++)
@@ -2483,13 +2497,14 @@ static void DrawPagination(void) // Updates the pagination dots at the top of th
     }
     CopyToBgTilemapBufferRect_ChangePalette(3, tilemap, 11, 0, PSS_PAGE_COUNT * 2, 2, 16);
     ScheduleBgCopyTilemapToVram(3);
-    Free(tilemap);
+    ArenaRewind(&sSummaryArena, scratch);
 }
 
 static void ChangeTilemap(const struct TilemapCtrl *unkStruct, u16 *dest, u8 c, bool8 d)
 {
     u16 i;
-    u16 *alloced = Alloc(unkStruct->field_6 * 2 * unkStruct->field_7);
+    u32 scratch = ArenaMark(&sSummaryArena);
+    u16 *alloced = ArenaAlloc(&sSummaryArena, unkStruct->field_6 * 2 * unkStruct->field_7);
     CpuFill16(unkStruct->field_4, alloced, unkStruct->field_6 * 2 * unkStruct->field_7);
     if (unkStruct->field_6 != c)
     {
@@ -2508,7 +2523,7 @@ static void ChangeTilemap(const struct TilemapCtrl *unkStruct, u16 *dest, u8 c,
     for (i = 0; i < unkStruct->field_7; i++)
         CpuCopy16(&alloced[unkStruct->field_6 * i], &dest[(unkStruct->field_9 + i) * 32 + unkStruct->field_8], unkStruct->field_6 * 2);
 
-    Free(alloced);
+    ArenaRewind(&sSummaryArena, scratch);
 }
 
 static void HandlePowerAccTilemap(u16 a, s16 b)
@@ -2816,6 +2831,12 @@ static void PrintTextOnWindow(u8 windowId, const u8 *string, u8 x, u8 y, u8 line
     PrintTextOnWindowWithFont(windowId, string, x, y, lineSpacing, colorId, FONT_NORMAL);
 }
 
+static void PrintStaticTextOnWindow(u8 windowId, u32 staticTextId, u8 x, u8 y)
+{
+    BlitStaticTextToWindow(windowId, staticTextId, x, y);
+    CopyWindowToVram(windowId, COPYWIN_GFX);
+}
+
 static void PrintTextOnWindowToFitPx(u8 windowId, const u8 *string, u8 x, u8 y, u8 lineSpacing, u8 colorId, u32 width)
 {
     u32 fontId = GetFontIdToFit(string, FONT_NORMAL, 0, width);
@@ -2926,53 +2947,53 @@ static void PrintPageNamesAndStats(void)
     int iconXPos;
     int statsXPos;
 
-    PrintTextOnWindow(PSS_LABEL_WINDOW_POKEMON_INFO_TITLE, gText_PkmnInfo, 2, 1, 0, 1);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_TITLE, gText_PkmnSkills, 2, 1, 0, 1);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_BATTLE_MOVES_TITLE, gText_BattleMoves, 2, 1, 0, 1);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_CONTEST_MOVES_TITLE, gText_ContestMoves, 2, 1, 0, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_POKEMON_INFO_TITLE, STATIC_TEXT_SUMMARY_PKMN_INFO, 2, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_TITLE, STATIC_TEXT_SUMMARY_PKMN_SKILLS, 2, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_BATTLE_MOVES_TITLE, STATIC_TEXT_SUMMARY_BATTLE_MOVES, 2, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_CONTEST_MOVES_TITLE, STATIC_TEXT_SUMMARY_CONTEST_MOVES, 2, 1);
 
     stringXPos = GetStringRightAlignXOffset(FONT_NORMAL, gText_Cancel2, 62);
     iconXPos = stringXPos - 16;
     if (iconXPos < 0)
         iconXPos = 0;
     PrintAOrBButtonIcon(PSS_LABEL_WINDOW_PROMPT_CANCEL, FALSE, iconXPos);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_PROMPT_CANCEL, gText_Cancel2, stringXPos, 1, 0, 0);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_PROMPT_CANCEL, STATIC_TEXT_SUMMARY_CANCEL, stringXPos, 1);
 
     stringXPos = GetStringRightAlignXOffset(FONT_NORMAL, gText_Info, 62);
     iconXPos = stringXPos - 16;
     if (iconXPos < 0)
         iconXPos = 0;
     PrintAOrBButtonIcon(PSS_LABEL_WINDOW_PROMPT_INFO, FALSE, iconXPos);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_PROMPT_INFO, gText_Info, stringXPos, 1, 0, 0);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_PROMPT_INFO, STATIC_TEXT_SUMMARY_INFO, stringXPos, 1);
 
     stringXPos = GetStringRightAlignXOffset(FONT_NORMAL, gText_Switch, 62);
     iconXPos = stringXPos - 16;
     if (iconXPos < 0)
         iconXPos = 0;
     PrintAOrBButtonIcon(PSS_LABEL_WINDOW_PROMPT_SWITCH, FALSE, iconXPos);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_PROMPT_SWITCH, gText_Switch, stringXPos, 1, 0, 0);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_PROMPT_SWITCH, STATIC_TEXT_SUMMARY_SWITCH, stringXPos, 1);
 
-    PrintTextOnWindow(PSS_LABEL_WINDOW_POKEMON_INFO_RENTAL, gText_RentalPkmn, 0, 1, 0, 1);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_POKEMON_INFO_TYPE, gText_TypeSlash, 0, 1, 0, 0);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_POKEMON_INFO_RENTAL, STATIC_TEXT_SUMMARY_RENTAL_PKMN, 0, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_POKEMON_INFO_TYPE, STATIC_TEXT_SUMMARY_TYPE, 0, 1);
     statsXPos = 6 + GetStringCenterAlignXOffset(FONT_NORMAL, gText_HP4, 42);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATS_LEFT, gText_HP4, statsXPos, 1, 0, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATS_LEFT, STATIC_TEXT_SUMMARY_HP, statsXPos, 1);
     statsXPos = 6 + GetStringCenterAlignXOffset(FONT_NORMAL, gText_Attack3, 42);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATS_LEFT, gText_Attack3, statsXPos, 17, 0, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATS_LEFT, STATIC_TEXT_SUMMARY_ATTACK, statsXPos, 17);
     statsXPos = 6 + GetStringCenterAlignXOffset(FONT_NORMAL, gText_Defense3, 42);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATS_LEFT, gText_Defense3, statsXPos, 33, 0, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATS_LEFT, STATIC_TEXT_SUMMARY_DEFENSE, statsXPos, 33);
     statsXPos = 2 + GetStringCenterAlignXOffset(FONT_NORMAL, gText_SpAtk4, 36);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATS_RIGHT, gText_SpAtk4, statsXPos, 1, 0, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATS_RIGHT, STATIC_TEXT_SUMMARY_SP_ATK, statsXPos, 1);
     statsXPos = 2 + GetStringCenterAlignXOffset(FONT_NORMAL, gText_SpDef4, 36);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATS_RIGHT, gText_SpDef4, statsXPos, 17, 0, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATS_RIGHT, STATIC_TEXT_SUMMARY_SP_DEF, statsXPos, 17);
     statsXPos = 2 + GetStringCenterAlignXOffset(FONT_NORMAL, gText_Speed2, 36);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATS_RIGHT, gText_Speed2, statsXPos, 33, 0, 1);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_EXP, gText_ExpPoints, 6, 1, 0, 1);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_EXP, gText_NextLv, 6, 17, 0, 1);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATUS, gText_Status, 2, 1, 0, 1);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_MOVES_POWER_ACC, gText_Power, 0, 1, 0, 1);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_MOVES_POWER_ACC, gText_Accuracy2, 0, 17, 0, 1);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_MOVES_APPEAL_JAM, gText_Appeal, 0, 1, 0, 1);
-    PrintTextOnWindow(PSS_LABEL_WINDOW_MOVES_APPEAL_JAM, gText_Jam, 0, 17, 0, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATS_RIGHT, STATIC_TEXT_SUMMARY_SPEED, statsXPos, 33);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_EXP, STATIC_TEXT_SUMMARY_EXP_POINTS, 6, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_EXP, STATIC_TEXT_SUMMARY_NEXT_LV, 6, 17);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_POKEMON_SKILLS_STATUS, STATIC_TEXT_SUMMARY_STATUS, 2, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_MOVES_POWER_ACC, STATIC_TEXT_SUMMARY_POWER, 0, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_MOVES_POWER_ACC, STATIC_TEXT_SUMMARY_ACCURACY, 0, 17);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_MOVES_APPEAL_JAM, STATIC_TEXT_SUMMARY_APPEAL, 0, 1);
+    PrintStaticTextOnWindow(PSS_LABEL_WINDOW_MOVES_APPEAL_JAM, STATIC_TEXT_SUMMARY_JAM, 0, 17);
 }
 
 static void PutPageWindowTilemaps(u8 page)
@@ -3223,8 +3244,9 @@ static void BufferMonTrainerMemo(void)
     }
     else
     {
-        u8 *metLevelString = Alloc(32);
-        u8 *metLocationString = Alloc(32);
+        u32 scratch = ArenaMark(&sSummaryArena);
+        u8 *metLevelString = ArenaAlloc(&sSummaryArena, 32);
+        u8 *metLocationString = ArenaAlloc(&sSummaryArena, 32);
         GetMetLevelString(metLevelString);
 
         if (sum->metLocation < MAPSEC_NONE)
@@ -3254,8 +3276,7 @@ static void BufferMonTrainerMemo(void)
         }
 
         DynamicPlaceholderTextUtil_ExpandPlaceholders(gStringVar4, text);
-        Free(metLevelString);
-        Free(metLocationString);
+        ArenaRewind(&sSummaryArena, scratch);
     }
 }
 
@@ -3506,10 +3527,11 @@ static void BufferStat(u8 *dst, u8 statIndex, u32 stat, u32 strId, u32 n)
 
 static void BufferLeftColumnStats(void)
 {
-    u8 *currentHPString = Alloc(20);
-    u8 *maxHPString = Alloc(20);
-    u8 *attackString = Alloc(20);
-    u8 *defenseString = Alloc(20);
+    u32 scratch = ArenaMark(&sSummaryArena);
+    u8 *currentHPString = ArenaAlloc(&sSummaryArena, 20);
+    u8 *maxHPString = ArenaAlloc(&sSummaryArena, 20);
+    u8 *attackString = ArenaAlloc(&sSummaryArena, 20);
+    u8 *defenseString = ArenaAlloc(&sSummaryArena, 20);
 
     DynamicPlaceholderTextUtil_Reset();
     BufferStat(currentHPString, 0, sMonSummaryScreen->summary.currentHP, 0, 3);
@@ -3518,10 +3540,7 @@ static void BufferLeftColumnStats(void)
     BufferStat(defenseString, STAT_DEF, sMonSummaryScreen->summary.def, 3, 7);
     DynamicPlaceholderTextUtil_ExpandPlaceholders(gStringVar4, sStatsLeftColumnLayout);
 
-    Free(currentHPString);
-    Free(maxHPString);
-    Free(attackString);
-    Free(defenseString);
+    ArenaRewind(&sSummaryArena, scratch);
 }
 
 static void PrintLeftColumnStats(void)
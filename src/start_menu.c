@@ -36,6 +36,7 @@
 #include "script.h"
 #include "sound.h"
 #include "start_menu.h"
+#include "static_text.h"
 #include "strings.h"
 #include "string_util.h"
 #include "task.h"
@@ -202,6 +203,25 @@ static const struct MenuAction sStartMenuItems[] =
     [MENU_ACTION_DEBUG]           = {sText_MenuDebug,   {.u8_void = StartMenuDebugCallback}},
 };
 
+// The prerendered versions of sStartMenuItems' texts.
+static const u8 sStartMenuStaticTexts[] =
+{
+    [MENU_ACTION_POKEDEX]         = STATIC_TEXT_START_MENU_POKEDEX,
+    [MENU_ACTION_POKEMON]         = STATIC_TEXT_START_MENU_POKEMON,
+    [MENU_ACTION_BAG]             = STATIC_TEXT_START_MENU_BAG,
+    [MENU_ACTION_POKENAV]         = STATIC_TEXT_START_MENU_POKENAV,
+    [MENU_ACTION_PLAYER]          = STATIC_TEXT_NONE,
+    [MENU_ACTION_SAVE]            = STATIC_TEXT_START_MENU_SAVE,
+    [MENU_ACTION_OPTION]          = STATIC_TEXT_START_MENU_OPTION,
+    [MENU_ACTION_EXIT]            = STATIC_TEXT_START_MENU_EXIT,
+    [MENU_ACTION_RETIRE_SAFARI]   = STATIC_TEXT_START_MENU_RETIRE,
+    [MENU_ACTION_PLAYER_LINK]     = STATIC_TEXT_NONE,
+    [MENU_ACTION_REST_FRONTIER]   = STATIC_TEXT_START_MENU_REST,
+    [MENU_ACTION_RETIRE_FRONTIER] = STATIC_TEXT_START_MENU_RETIRE,
+    [MENU_ACTION_PYRAMID_BAG]     = STATIC_TEXT_START_MENU_BAG,
+    [MENU_ACTION_DEBUG]           = STATIC_TEXT_NONE,
+};
+
 static const struct BgTemplate sBgTemplates_LinkBattleSave[] =
 {
     {
@@ -482,6 +502,10 @@ static bool32 PrintStartMenuActions(s8 *pIndex, u32 count)
         {
             PrintPlayerNameOnWindow(GetStartMenuWindowId(), sStartMenuItems[sCurrentStartMenuActions[index]].text, 8, (index << 4) + 9);
         }
+        else if (sStartMenuStaticTexts[sCurrentStartMenuActions[index]] != STATIC_TEXT_NONE)
+        {
+            BlitStaticTextToWindow(GetStartMenuWindowId(), sStartMenuStaticTexts[sCurrentStartMenuActions[index]], 8, (index << 4) + 9);
+        }
         else
         {
             StringExpandPlaceholders(gStringVar4, sStartMenuItems[sCurrentStartMenuActions[index]].text);
@@ -1327,7 +1351,7 @@ static void Task_SaveAfterLinkBattle(u8 taskId)
             DrawTextBorderOuter(0, 8, 14);
             PutWindowTilemap(0);
             CopyWindowToVram(0, COPYWIN_FULL);
-            BeginNormalPaletteFade(PALETTES_ALL, 0, 16, 0, RGB_BLACK);
+            BeginBrightnessPaletteFade(PALETTES_ALL, 0, 16, 0, RGB_BLACK);
 
             if (gWirelessCommType != 0 && InUnionRoom())
             {
@@ -1360,7 +1384,7 @@ static void Task_SaveAfterLinkBattle(u8 taskId)
             }
             break;
         case 3:
-            BeginNormalPaletteFade(PALETTES_ALL, 0, 0, 16, RGB_BLACK);
+            BeginBrightnessPaletteFade(PALETTES_ALL, 0, 0, 16, RGB_BLACK);
             *state = 4;
             break;
         case 4:
@@ -0,0 +1,65 @@
+#include "global.h"
+#include "static_text.h"
+#include "strings.h"
+#include "text.h"
+#include "window.h"
+
+#include "data/text/static_text.h"
+
+// Draws the text the same way AddTextPrinterParameterized with TEXT_SKIP_DRAW
+// would, clipped to the window. Each row of a prerendered tile is one word, so
+// it's written with at most two masked stores.
+void BlitStaticTextToWindow(u32 windowId, u32 staticTextId, u32 x, u32 y)
+{
+    const struct StaticText *staticText = &gStaticTexts[staticTextId];
+    struct Window *window = &gWindows[windowId];
+    u32 windowTilesWide = window->window.width;
+    u32 windowWidth = windowTilesWide * 8;
+    u32 windowHeight = window->window.height * 8;
+    u32 tilesWide = (staticText->width + 7) / 8;
+    u32 width, height, row, tileX, tileCount, lastMask;
+
+    if (x >= windowWidth || y >= windowHeight)
+        return;
+
+    width = min(staticText->width, windowWidth - x);
+    height = min(staticText->height, windowHeight - y);
+    tileCount = (width + 7) / 8;
+    lastMask = (width % 8) ? (1u << ((width % 8) * 4)) - 1 : 0xFFFFFFFF;
+
+    for (row = 0; row < height; row++)
+    {
+        const u32 *src = &staticText->tiles[(row / 8) * tilesWide * 8 + (row % 8)];
+        u32 dstY = y + row;
+        u32 *dstRow = (u32 *)window->tileData + (dstY / 8) * windowTilesWide * 8 + (dstY % 8);
+
+        for (tileX = 0; tileX < tileCount; tileX++)
+        {
+            u32 pixels = src[tileX * 8];
+            u32 mask, shift, dstX;
+            u32 *dst;
+
+            if (tileX == tileCount - 1)
+                pixels &= lastMask;
+            if (pixels == 0)
+                continue;
+
+            // Expand every non-transparent pixel to a 0xF nibble.
+            mask = pixels | (pixels >> 1);
+            mask |= mask >> 2;
+            mask = (mask & 0x11111111) * 0xF;
+
+            dstX = x + tileX * 8;
+            shift = (dstX % 8) * 4;
+            dst = dstRow + (dstX / 8) * 8;
+            *dst = (*dst & ~(mask << shift)) | (pixels << shift);
+            if (shift != 0 && (pixels >> (32 - shift)) != 0)
+                dst[8] = (dst[8] & ~(mask >> (32 - shift))) | (pixels >> (32 - shift));
+        }
+    }
+}
+
+u32 GetStaticTextWidth(u32 staticTextId)
+{
+    return gStaticTexts[staticTextId].width;
+}
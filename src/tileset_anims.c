@@ -550,9 +550,39 @@ static void ResetTilesetAnimBuffer(void)
     CpuFill32(0, sTilesetDMA3TransferBuffer, sizeof sTilesetDMA3TransferBuffer);
 }
 
+// Strips that would take a VBlank past this many bytes wait for the next one,
+// so anims that land on the same frame are staggered instead of all being
+// copied at once. The first strip always goes, however big it is.
+#define TILESET_ANIM_DMA_BUDGET (32 * TILE_SIZE_4BPP)
+
 static void AppendTilesetAnimToBuffer(const u16 *src, u16 *dest, u16 size)
 {
-    if (sTilesetDMA3TransferBufferSize < 20)
+    int i;
+
+    // A newer frame of a strip that's still waiting replaces it.
+    for (i = 0; i < sTilesetDMA3TransferBufferSize; i++)
+    {
+        if (sTilesetDMA3TransferBuffer[i].dest == dest && sTilesetDMA3TransferBuffer[i].size == size)
+        {
+            sTilesetDMA3TransferBuffer[i].src = src;
+            return;
+        }
+    }
+
+    // Strips that continue the last one are copied with it.
+    if (i != 0)
+    {
+        i--;
+        if ((const u8 *)sTilesetDMA3TransferBuffer[i].src + sTilesetDMA3TransferBuffer[i].size == (const u8 *)src
+         && (u8 *)sTilesetDMA3TransferBuffer[i].dest + sTilesetDMA3TransferBuffer[i].size == (u8 *)dest
+         && sTilesetDMA3TransferBuffer[i].size + size <= TILESET_ANIM_DMA_BUDGET)
+        {
+            sTilesetDMA3TransferBuffer[i].size += size;
+            return;
+        }
+    }
+
+    if (sTilesetDMA3TransferBufferSize < ARRAY_COUNT(sTilesetDMA3TransferBuffer))
     {
         sTilesetDMA3TransferBuffer[sTilesetDMA3TransferBufferSize].src = src;
         sTilesetDMA3TransferBuffer[sTilesetDMA3TransferBufferSize].dest = dest;
@@ -563,12 +593,21 @@ static void AppendTilesetAnimToBuffer(const u16 *src, u16 *dest, u16 size)
 
 void TransferTilesetAnimsBuffer(void)
 {
-    int i;
+    int i, j;
+    u32 bytes = 0;
 
     for (i = 0; i < sTilesetDMA3TransferBufferSize; i ++)
+    {
+        if (i != 0 && bytes + sTilesetDMA3TransferBuffer[i].size > TILESET_ANIM_DMA_BUDGET)
+            break;
         DmaCopy16(3, sTilesetDMA3TransferBuffer[i].src, sTilesetDMA3TransferBuffer[i].dest, sTilesetDMA3TransferBuffer[i].size);
+        bytes += sTilesetDMA3TransferBuffer[i].size;
+    }
 
-    sTilesetDMA3TransferBufferSize = 0;
+    // Whatever didn't fit goes first next time.
+    for (j = 0; i < sTilesetDMA3TransferBufferSize; i++, j++)
+        sTilesetDMA3TransferBuffer[j] = sTilesetDMA3TransferBuffer[i];
+    sTilesetDMA3TransferBufferSize = j;
 }
 
 void InitTilesetAnimations(void)
@@ -580,12 +619,13 @@ void InitTilesetAnimations(void)
 
 void InitSecondaryTilesetAnimation(void)
 {
+    // Don't let the old tileset's strips overwrite the new one's tiles.
+    ResetTilesetAnimBuffer();
     _InitSecondaryTilesetAnimation();
 }
 
 void UpdateTilesetAnimations(void)
 {
-    ResetTilesetAnimBuffer();
     if (++sPrimaryTilesetAnimCounter >= sPrimaryTilesetAnimCounterMax)
         sPrimaryTilesetAnimCounter = 0;
     if (++sSecondaryTilesetAnimCounter >= sSecondaryTilesetAnimCounterMax)
@@ -1168,7 +1208,7 @@ static void QueueAnimTiles_BattlePyramid_StatueShadow(u16 timer)
 static void BlendAnimPalette_BattleDome_FloorLights(u16 timer)
 {
     CpuCopy16(sTilesetAnims_BattleDomeFloorLightPals[timer % ARRAY_COUNT(sTilesetAnims_BattleDomeFloorLightPals)], &gPlttBufferUnfaded[BG_PLTT_ID(8)], PLTT_SIZE_4BPP);
-    BlendPalette(BG_PLTT_ID(8), 16, gPaletteFade.y, gPaletteFade.blendColor & 0x7FFF);
+    BlendPalette(BG_PLTT_ID(8), 16, IsBrightnessPaletteFadeActive() ? 0 : gPaletteFade.y, gPaletteFade.blendColor & 0x7FFF);
     if ((u8)FindTaskIdByFunc(Task_BattleTransition_Intro) != TASK_NONE)
     {
         sSecondaryTilesetAnimCallback = TilesetAnim_BattleDome2;
@@ -1181,7 +1221,7 @@ static void BlendAnimPalette_BattleDome_FloorLightsNoBlend(u16 timer)
     CpuCopy16(sTilesetAnims_BattleDomeFloorLightPals[timer % ARRAY_COUNT(sTilesetAnims_BattleDomeFloorLightPals)], &gPlttBufferUnfaded[BG_PLTT_ID(8)], PLTT_SIZE_4BPP);
     if ((u8)FindTaskIdByFunc(Task_BattleTransition_Intro) == TASK_NONE)
     {
-        BlendPalette(BG_PLTT_ID(8), 16, gPaletteFade.y, gPaletteFade.blendColor & 0x7FFF);
+        BlendPalette(BG_PLTT_ID(8), 16, IsBrightnessPaletteFadeActive() ? 0 : gPaletteFade.y, gPaletteFade.blendColor & 0x7FFF);
         if (!--sSecondaryTilesetAnimCounterMax)
             sSecondaryTilesetAnimCallback = NULL;
     }
@@ -261,19 +261,44 @@ u32 CalcByteArraySum(const u8 *data, u32 length)
     return sum;
 }
 
+// Each channel of a pair of colors gets its own 16-bit lanes, where
+// color * (16 - coeff) + blendColor * coeff can't carry into the next lane.
+// That's the same as color + (((blendColor - color) * coeff) >> 4), without
+// the signed math, so two colors can be blended with one set of operations.
+#define BLEND_LANES 0x001F001F
+
+static inline u32 BlendColorPair(u32 colors, u32 keep, u32 r, u32 g, u32 b)
+{
+    r += (colors & BLEND_LANES) * keep;
+    g += ((colors >> 5) & BLEND_LANES) * keep;
+    b += ((colors >> 10) & BLEND_LANES) * keep;
+    return ((r >> 4) & BLEND_LANES) | (((g >> 4) & BLEND_LANES) << 5) | (((b >> 4) & BLEND_LANES) << 10);
+}
+
 void BlendPalette(u16 palOffset, u16 numEntries, u8 coeff, u32 blendColor)
 {
-    u16 i;
-    for (i = 0; i < numEntries; i++)
+    u32 keep = 16 - coeff;
+    u32 r = (blendColor & 0x1F) * coeff * 0x10001;
+    u32 g = ((blendColor >> 5) & 0x1F) * coeff * 0x10001;
+    u32 b = ((blendColor >> 10) & 0x1F) * coeff * 0x10001;
+    u16 *src = &gPlttBufferUnfaded[palOffset];
+    u16 *dest = &gPlttBufferFaded[palOffset];
+
+    MarkPlttBufferDirty(palOffset, PLTT_SIZEOF(numEntries));
+
+    if ((palOffset & 1) && numEntries != 0)
     {
-        u16 index = i + palOffset;
-        struct PlttData *data1 = (struct PlttData *)&gPlttBufferUnfaded[index];
-        s8 r = data1->r;
-        s8 g = data1->g;
-        s8 b = data1->b;
-        struct PlttData *data2 = (struct PlttData *)&blendColor;
-        gPlttBufferFaded[index] = RGB(r + (((data2->r - r) * coeff) >> 4),
-                                      g + (((data2->g - g) * coeff) >> 4),
-                                      b + (((data2->b - b) * coeff) >> 4));
+        *dest++ = BlendColorPair(*src++, keep, r, g, b);
+        numEntries--;
     }
+
+    for (; numEntries >= 2; numEntries -= 2)
+    {
+        *(u32 *)dest = BlendColorPair(*(u32 *)src, keep, r, g, b);
+        src += 2;
+        dest += 2;
+    }
+
+    if (numEntries != 0)
+        *dest = BlendColorPair(*src, keep, r, g, b);
 }
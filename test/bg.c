@@ -0,0 +1,129 @@
+#include "global.h"
+#include "bg.h"
+#include "dma3.h"
+#include "malloc.h"
+#include "window.h"
+#include "test/test.h"
+
+static const struct BgTemplate sBgTemplate =
+{
+    .bg = 0,
+    .charBaseIndex = 2,
+    .mapBaseIndex = 31,
+    .screenSize = 0,
+    .paletteMode = 0,
+    .priority = 0,
+    .baseTile = 0,
+};
+
+static const struct WindowTemplate sWindowTemplates[] =
+{
+    {
+        .bg = 0,
+        .tilemapLeft = 2,
+        .tilemapTop = 15,
+        .width = 26,
+        .height = 4,
+        .paletteNum = 15,
+        .baseBlock = 1,
+    },
+    DUMMY_WIN_TEMPLATE,
+};
+
+// Dirty bands are only queued at the end of the frame, so the tests stand in
+// for the main loop by calling CopyPendingBgTilemapBandsToVram themselves.
+static void SetUpTextBg(void)
+{
+    ClearDma3Requests();
+    ResetBgsAndClearDma3BusyFlags(0);
+    InitBgsFromTemplates(0, &sBgTemplate, 1);
+    InitWindows(sWindowTemplates);
+    ResetBgTilemapCopyStats();
+}
+
+static void TearDownTextBg(void)
+{
+    FreeAllWindowBuffers();
+    ClearDma3Requests();
+}
+
+TEST("CopyBgTilemapBufferToVram only copies bands changed since the last copy")
+{
+    const struct BgTilemapCopyStats *stats = GetBgTilemapCopyStats();
+
+    SetUpTextBg();
+
+    // The first copy after the buffer is allocated has to copy everything.
+    PutWindowTilemap(0);
+    CopyBgTilemapBufferToVram(0);
+    CopyPendingBgTilemapBandsToVram();
+    EXPECT_EQ(stats->requestedBytes, BG_SCREEN_SIZE);
+    EXPECT_EQ(stats->copiedBytes, BG_SCREEN_SIZE);
+
+    // A one-row cursor move only copies that row.
+    ResetBgTilemapCopyStats();
+    FillBgTilemapBufferRect(0, 0x10, 1, 16, 1, 1, 15);
+    CopyBgTilemapBufferToVram(0);
+    CopyPendingBgTilemapBandsToVram();
+    EXPECT_EQ(stats->requestedBytes, BG_SCREEN_SIZE);
+    EXPECT_EQ(stats->copiedBytes, 32 * sizeof(u16));
+
+    // Nothing changed.
+    ResetBgTilemapCopyStats();
+    CopyBgTilemapBufferToVram(0);
+    CopyPendingBgTilemapBandsToVram();
+    EXPECT_EQ(stats->copiedBytes, 0);
+
+    // Redrawing the window copies only the rows it covers.
+    ResetBgTilemapCopyStats();
+    PutWindowTilemap(0);
+    CopyWindowToVram(0, COPYWIN_MAP);
+    CopyPendingBgTilemapBandsToVram();
+    EXPECT_EQ(stats->copiedBytes, sWindowTemplates[0].height * 32 * sizeof(u16));
+
+    TearDownTextBg();
+}
+
+TEST("CopyBgTilemapBufferToVram also copies bands written later in the same frame")
+{
+    const struct BgTilemapCopyStats *stats = GetBgTilemapCopyStats();
+
+    SetUpTextBg();
+    CopyBgTilemapBufferToVram(0);
+    CopyPendingBgTilemapBandsToVram();
+
+    // The window's rows are written and the copy is requested, then a cursor
+    // row below them is written before the frame ends.
+    ResetBgTilemapCopyStats();
+    PutWindowTilemap(0);
+    CopyWindowToVram(0, COPYWIN_MAP);
+    FillBgTilemapBufferRect(0, 0x10, 1, 20, 1, 1, 15);
+    CopyPendingBgTilemapBandsToVram();
+    EXPECT_EQ(stats->copiedBytes, (sWindowTemplates[0].height + 1) * 32 * sizeof(u16));
+
+    // Nothing is left dirty for the next frame.
+    ResetBgTilemapCopyStats();
+    CopyBgTilemapBufferToVram(0);
+    CopyPendingBgTilemapBandsToVram();
+    EXPECT_EQ(stats->copiedBytes, 0);
+
+    TearDownTextBg();
+}
+
+TEST("CopyBgTilemapBufferToVram copies everything once the buffer is handed out")
+{
+    const struct BgTilemapCopyStats *stats = GetBgTilemapCopyStats();
+    u16 *tilemap;
+
+    SetUpTextBg();
+    CopyBgTilemapBufferToVram(0);
+    CopyPendingBgTilemapBandsToVram();
+
+    ResetBgTilemapCopyStats();
+    tilemap = GetBgTilemapBuffer(0);
+    tilemap[0] = 0x10;
+    CopyBgTilemapBufferToVram(0);
+    EXPECT_EQ(stats->copiedBytes, BG_SCREEN_SIZE);
+
+    TearDownTextBg();
+}
@@ -0,0 +1,64 @@
+#include "global.h"
+#include "decompress.h"
+#include "malloc.h"
+#include "test/test.h"
+
+// graphics_file_rules.mk compresses these with fast LZ. The .lz77 copies are
+// the same data compressed with LZ77, for the BIOS to decompress.
+static const u32 sFrontPic_Fast[] = INCBIN_U32("graphics/pokemon/bulbasaur/anim_front.4bpp.lz");
+static const u32 sFrontPic_LZ77[] = INCBIN_U32("graphics/pokemon/bulbasaur/anim_front.4bpp.lz77");
+static const u32 sTileset_Fast[] = INCBIN_U32("data/tilesets/secondary/petalburg/tiles.4bpp.lz");
+static const u32 sTileset_LZ77[] = INCBIN_U32("data/tilesets/secondary/petalburg/tiles.4bpp.lz77");
+
+TEST("LZDecompressWram decompresses fast LZ to the same data as LZ77")
+{
+    const u32 *fast = NULL, *lz77 = NULL;
+    u32 size;
+    u8 *a, *b;
+
+    PARAMETRIZE { fast = sFrontPic_Fast; lz77 = sFrontPic_LZ77; }
+    PARAMETRIZE { fast = sTileset_Fast; lz77 = sTileset_LZ77; }
+
+    EXPECT(IsFastLZData(fast));
+    EXPECT(!IsFastLZData(lz77));
+    size = GetDecompressedDataSize(lz77);
+    EXPECT_EQ(GetDecompressedDataSize(fast), size);
+    EXPECT_EQ(IsLZ77Data(fast, 0, size), size);
+
+    a = AllocZeroed(size + 4);
+    b = AllocZeroed(size + 4);
+    LZDecompressWram(fast, a);
+    LZDecompressWram(lz77, b);
+    EXPECT_EQ(memcmp(a, b, size), 0);
+    EXPECT_EQ(a[size], 0);
+    Free(a);
+    Free(b);
+}
+
+TEST("Fast LZ decompresses faster than LZ77")
+{
+    struct Benchmark fastBenchmark, lz77Benchmark;
+    const u32 *fast = NULL, *lz77 = NULL;
+    u8 *buffer;
+
+    PARAMETRIZE { fast = sFrontPic_Fast; lz77 = sFrontPic_LZ77; }
+    PARAMETRIZE { fast = sTileset_Fast; lz77 = sTileset_LZ77; }
+
+    buffer = Alloc(GetDecompressedDataSize(lz77));
+
+    BENCHMARK(&lz77Benchmark) { LZ77UnCompWram(lz77, buffer); }
+    BENCHMARK(&fastBenchmark) { FastLZDecompress(fast, buffer); }
+
+    EXPECT_FASTER(fastBenchmark, lz77Benchmark);
+    Free(buffer);
+}
+
+TEST("Fast LZ decompresses to VRAM faster than LZ77")
+{
+    struct Benchmark fastBenchmark, lz77Benchmark;
+
+    BENCHMARK(&lz77Benchmark) { LZ77UnCompVram(sTileset_LZ77, (void *)BG_CHAR_ADDR(0)); }
+    BENCHMARK(&fastBenchmark) { LZDecompressVram(sTileset_Fast, (void *)BG_CHAR_ADDR(0)); }
+
+    EXPECT_FASTER(fastBenchmark, lz77Benchmark);
+}
@@ -0,0 +1,149 @@
+#include "global.h"
+#include "dma3.h"
+#include "gpu_regs.h"
+#include "test/test.h"
+
+#define BLOCK_SIZE 0x1000
+
+static const u32 sSource[BLOCK_SIZE / 4] = {[0] = 0x01234567, [1] = 0x89ABCDEF, [8] = 0x76543210, [9] = 0xFEDCBA98};
+static u32 sDest[64];
+
+// The real VBlank handler would process the queue behind the test's back, and
+// the budget depends on how far into VBlank it runs, so the tests stop the
+// VBlank interrupt and process the queue at the top of the frame themselves.
+static void SetUpDma3(void)
+{
+    DisableInterrupts(INTR_FLAG_VBLANK);
+    ClearDma3Requests();
+    ResetDma3Stats();
+    CpuFill32(0, sDest, sizeof(sDest));
+}
+
+static void TearDownDma3(void)
+{
+    ClearDma3Requests();
+    EnableInterrupts(INTR_FLAG_VBLANK);
+}
+
+static void ProcessDma3RequestsOnNextFrame(void)
+{
+    while (REG_VCOUNT != 0)
+        ;
+    ProcessDma3Requests();
+}
+
+TEST("RequestDma3Copy merges copies that continue the previous one")
+{
+    const struct Dma3Stats *stats = GetDma3Stats();
+    s16 first, second;
+
+    SetUpDma3();
+
+    first = RequestDma3Copy(&sSource[0], &sDest[0], 32, 1);
+    second = RequestDma3Copy(&sSource[8], &sDest[8], 32, 1);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(stats->merged, 1);
+
+    ProcessDma3RequestsOnNextFrame();
+    EXPECT_EQ(stats->lastFrameRequests, 1);
+    EXPECT_EQ(stats->lastFrameBytes, 64);
+    EXPECT_EQ(sDest[0], sSource[0]);
+    EXPECT_EQ(sDest[9], sSource[9]);
+
+    TearDownDma3();
+}
+
+TEST("RequestDma3Fill merges fills of the same value that continue the previous one")
+{
+    const struct Dma3Stats *stats = GetDma3Stats();
+
+    SetUpDma3();
+
+    RequestDma3Fill(0x11111111, &sDest[0], 32, 1);
+    RequestDma3Fill(0x11111111, &sDest[8], 32, 1);
+    EXPECT_EQ(stats->merged, 1);
+
+    ProcessDma3RequestsOnNextFrame();
+    EXPECT_EQ(stats->lastFrameRequests, 1);
+    EXPECT_EQ(sDest[15], 0x11111111);
+
+    TearDownDma3();
+}
+
+TEST("Dma3 requests aren't merged unless they're the same kind and contiguous")
+{
+    const struct Dma3Stats *stats = GetDma3Stats();
+    s16 first = 0, second = 0;
+
+    PARAMETRIZE { // A fill after a copy.
+        SetUpDma3();
+        first = RequestDma3Copy(&sSource[0], &sDest[0], 32, 1);
+        second = RequestDma3Fill(0, &sDest[8], 32, 1);
+    }
+    PARAMETRIZE { // A copy after a fill.
+        SetUpDma3();
+        first = RequestDma3Fill(0, &sDest[0], 32, 1);
+        second = RequestDma3Copy(&sSource[8], &sDest[8], 32, 1);
+    }
+    PARAMETRIZE { // 16-bit after 32-bit.
+        SetUpDma3();
+        first = RequestDma3Copy(&sSource[0], &sDest[0], 32, 1);
+        second = RequestDma3Copy(&sSource[8], &sDest[8], 32, 0);
+    }
+    PARAMETRIZE { // A gap between the destinations.
+        SetUpDma3();
+        first = RequestDma3Copy(&sSource[0], &sDest[0], 32, 1);
+        second = RequestDma3Copy(&sSource[8], &sDest[16], 32, 1);
+    }
+    PARAMETRIZE { // The destinations touch, but the sources don't.
+        SetUpDma3();
+        first = RequestDma3Copy(&sSource[0], &sDest[0], 32, 1);
+        second = RequestDma3Copy(&sSource[16], &sDest[8], 32, 1);
+    }
+    PARAMETRIZE { // Fills of different values.
+        SetUpDma3();
+        first = RequestDma3Fill(0, &sDest[0], 32, 1);
+        second = RequestDma3Fill(1, &sDest[8], 32, 1);
+    }
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(stats->merged, 0);
+
+    ProcessDma3RequestsOnNextFrame();
+    EXPECT_EQ(stats->lastFrameRequests, 2);
+
+    TearDownDma3();
+}
+
+TEST("ProcessDma3Requests leaves what doesn't fit in one VBlank for the next")
+{
+    const struct Dma3Stats *stats = GetDma3Stats();
+    u32 i, count, firstFrameRequests;
+
+    SetUpDma3();
+
+    // The same source every time, so none of them merge.
+    count = 0;
+    for (i = 0; i < BG_VRAM_SIZE / BLOCK_SIZE; i++)
+    {
+        if (RequestDma3Copy(sSource, (void *)(BG_VRAM + i * BLOCK_SIZE), BLOCK_SIZE, 1) != -1)
+            count++;
+    }
+    EXPECT_EQ(count, BG_VRAM_SIZE / BLOCK_SIZE);
+
+    ProcessDma3RequestsOnNextFrame();
+    firstFrameRequests = stats->lastFrameRequests;
+    EXPECT_GT(count * BLOCK_SIZE, stats->lastFrameBudget);
+    EXPECT_EQ(firstFrameRequests, stats->lastFrameBudget / BLOCK_SIZE);
+    EXPECT_LE(stats->lastFrameBytes, stats->lastFrameBudget);
+    EXPECT_EQ(stats->lastFrameDeferred, count - firstFrameRequests);
+    EXPECT_EQ(stats->deferredFrames, 1);
+
+    ProcessDma3RequestsOnNextFrame();
+    EXPECT_EQ(stats->lastFrameRequests, count - firstFrameRequests);
+    EXPECT_EQ(stats->lastFrameDeferred, 0);
+    EXPECT_EQ(stats->deferredFrames, 1);
+    EXPECT_EQ(stats->totalBytes, count * BLOCK_SIZE);
+
+    TearDownDma3();
+}
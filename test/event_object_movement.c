@@ -0,0 +1,198 @@
+#include "global.h"
+#include "event_object_movement.h"
+#include "fieldmap.h"
+#include "random.h"
+#include "sprite.h"
+#include "test/test.h"
+#include "constants/event_object_movement.h"
+#include "constants/event_objects.h"
+
+#define ROOM_SIZE 12
+
+static u8 Old_GetObjectEventIdByXY(s16 x, s16 y)
+{
+    u8 i;
+    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    {
+        if (gObjectEvents[i].active && gObjectEvents[i].currentCoords.x == x && gObjectEvents[i].currentCoords.y == y)
+            break;
+    }
+
+    return i;
+}
+
+// Packs every slot into a small room, like a room full of enemies and items.
+static void FillRoomWithObjectEvents(void)
+{
+    u32 i;
+
+    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    {
+        gObjectEvents[i] = (struct ObjectEvent){};
+        gObjectEvents[i].active = (i % 5) != 4;
+        gObjectEvents[i].currentCoords.x = gObjectEvents[i].previousCoords.x = MAP_OFFSET + Random() % ROOM_SIZE;
+        gObjectEvents[i].currentCoords.y = gObjectEvents[i].previousCoords.y = MAP_OFFSET + Random() % ROOM_SIZE;
+    }
+    RebuildObjectEventTileBuckets();
+}
+
+TEST("GetObjectEventIdByXY finds the same object events as checking every slot")
+{
+    u32 i, step;
+    s16 x, y;
+
+    FillRoomWithObjectEvents();
+    for (step = 0; step < 8; step++)
+    {
+        for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+        {
+            ShiftObjectEventCoords(&gObjectEvents[i],
+                                   gObjectEvents[i].currentCoords.x + (Random() % 3) - 1,
+                                   gObjectEvents[i].currentCoords.y + (Random() % 3) - 1);
+        }
+        for (y = MAP_OFFSET - 2; y < MAP_OFFSET + ROOM_SIZE + 2; y++)
+        {
+            for (x = MAP_OFFSET - 2; x < MAP_OFFSET + ROOM_SIZE + 2; x++)
+                EXPECT_EQ(GetObjectEventIdByXY(x, y), Old_GetObjectEventIdByXY(x, y));
+        }
+    }
+}
+
+TEST("GetObjectEventIdByXY is faster than checking every slot")
+{
+    struct Benchmark oldLookup, newLookup;
+    u32 result = 0;
+    s16 x, y;
+
+    FillRoomWithObjectEvents();
+    BENCHMARK(&oldLookup)
+    {
+        for (y = MAP_OFFSET; y < MAP_OFFSET + ROOM_SIZE; y++)
+        {
+            for (x = MAP_OFFSET; x < MAP_OFFSET + ROOM_SIZE; x++)
+                result += Old_GetObjectEventIdByXY(x, y);
+        }
+    }
+    BENCHMARK(&newLookup)
+    {
+        for (y = MAP_OFFSET; y < MAP_OFFSET + ROOM_SIZE; y++)
+        {
+            for (x = MAP_OFFSET; x < MAP_OFFSET + ROOM_SIZE; x++)
+                result -= GetObjectEventIdByXY(x, y);
+        }
+    }
+
+    EXPECT_EQ(result, 0);
+    EXPECT_FASTER(newLookup, oldLookup);
+}
+
+// Fills a room with object events walking in place, either around the player
+// or far enough away to be offscreen.
+static void SpawnRoomOfObjectEvents(s16 distance)
+{
+    u32 i;
+
+    ResetSpriteData();
+    FreeAllSpritePalettes();
+    ResetObjectEvents();
+    gSaveBlock1Ptr->pos.x = MAP_OFFSET + 20;
+    gSaveBlock1Ptr->pos.y = MAP_OFFSET + 20;
+    for (i = 0; i < OBJECT_EVENTS_COUNT; i++)
+    {
+        SpawnSpecialObjectEventParameterized(OBJ_EVENT_GFX_BOY_1, MOVEMENT_TYPE_WALK_IN_PLACE_DOWN, i + 1,
+                                             gSaveBlock1Ptr->pos.x + distance + (i % 4) * 2 - 3,
+                                             gSaveBlock1Ptr->pos.y + (i / 4) * 2 - 3,
+                                             3);
+    }
+}
+
+TEST("Object events far offscreen sleep instead of updating every frame")
+{
+    struct Benchmark onscreen, offscreen;
+    u32 frame;
+
+    ASSUME(OW_OBJECT_SLEEP_MARGIN != 0);
+
+    SpawnRoomOfObjectEvents(0);
+    BENCHMARK(&onscreen)
+    {
+        for (frame = 0; frame < 16; frame++)
+            AnimateSprites();
+    }
+
+    SpawnRoomOfObjectEvents(DISPLAY_TILE_WIDTH + OW_OBJECT_SLEEP_MARGIN * 2);
+    BENCHMARK(&offscreen)
+    {
+        for (frame = 0; frame < 16; frame++)
+            AnimateSprites();
+    }
+
+    EXPECT_FASTER(offscreen, onscreen);
+    ResetSpriteData();
+    FreeAllSpritePalettes();
+}
+
+static const u16 sRoomSpecies[] = {SPECIES_ZIGZAGOON, SPECIES_WINGULL, SPECIES_POOCHYENA};
+
+#define ROOM_MON_COUNT 12
+
+// Spawns a room of overworld Pokémon, several of each species in sRoomSpecies.
+static void SpawnRoomOfMons(u8 *objectEventIds)
+{
+    u32 i;
+
+    for (i = 0; i < ROOM_MON_COUNT; i++)
+    {
+        objectEventIds[i] = SpawnSpecialObjectEventParameterized(OBJ_EVENT_GFX_MON_BASE + sRoomSpecies[i % ARRAY_COUNT(sRoomSpecies)],
+                                                                 MOVEMENT_TYPE_FACE_DOWN, i + 1,
+                                                                 gSaveBlock1Ptr->pos.x + (i % 4) * 2 - 3,
+                                                                 gSaveBlock1Ptr->pos.y + (i / 4) * 2 - 3,
+                                                                 3);
+    }
+}
+
+static u32 GetObjectEventPaletteNum(u8 objectEventId)
+{
+    return gSprites[gObjectEvents[objectEventId].spriteId].oam.paletteNum;
+}
+
+TEST("Overworld Pokémon of the same species share a palette that's only decompressed once")
+{
+    u8 objectEventIds[ROOM_MON_COUNT];
+    u32 paletteNums[ARRAY_COUNT(sRoomSpecies)];
+    u32 i, decompressions;
+
+    ResetSpriteData();
+    FreeAllSpritePalettes();
+    ResetObjectEvents();
+    gSaveBlock1Ptr->pos.x = MAP_OFFSET + 20;
+    gSaveBlock1Ptr->pos.y = MAP_OFFSET + 20;
+    gMonPaletteCacheStats = (struct MonPaletteCacheStats){0};
+
+    SpawnRoomOfMons(objectEventIds);
+    EXPECT_EQ(gMonPaletteCacheStats.requests, ROOM_MON_COUNT);
+    EXPECT_EQ(gMonPaletteCacheStats.requests - gMonPaletteCacheStats.slotHits, ARRAY_COUNT(sRoomSpecies));
+    EXPECT_LE(gMonPaletteCacheStats.decompressions, ARRAY_COUNT(sRoomSpecies));
+    EXPECT_NE(GetObjectEventPaletteNum(objectEventIds[0]), GetObjectEventPaletteNum(objectEventIds[1]));
+    EXPECT_NE(GetObjectEventPaletteNum(objectEventIds[1]), GetObjectEventPaletteNum(objectEventIds[2]));
+    EXPECT_NE(GetObjectEventPaletteNum(objectEventIds[0]), GetObjectEventPaletteNum(objectEventIds[2]));
+    for (i = ARRAY_COUNT(sRoomSpecies); i < ROOM_MON_COUNT; i++)
+        EXPECT_EQ(GetObjectEventPaletteNum(objectEventIds[i]), GetObjectEventPaletteNum(objectEventIds[i % ARRAY_COUNT(sRoomSpecies)]));
+
+    // Despawning them frees their palette slots, and spawning them again
+    // reloads the palettes from the cache without decompressing anything.
+    decompressions = gMonPaletteCacheStats.decompressions;
+    for (i = 0; i < ARRAY_COUNT(sRoomSpecies); i++)
+        paletteNums[i] = GetObjectEventPaletteNum(objectEventIds[i]);
+    for (i = 0; i < ROOM_MON_COUNT; i++)
+        RemoveObjectEventByLocalIdAndMap(i + 1, gSaveBlock1Ptr->location.mapNum, gSaveBlock1Ptr->location.mapGroup);
+    for (i = 0; i < ARRAY_COUNT(sRoomSpecies); i++)
+        EXPECT_EQ(GetSpritePaletteTagByPaletteNum(paletteNums[i]), TAG_NONE);
+
+    SpawnRoomOfMons(objectEventIds);
+    EXPECT_EQ(gMonPaletteCacheStats.decompressions, decompressions);
+    EXPECT_EQ(gMonPaletteCacheStats.requests - gMonPaletteCacheStats.slotHits, 2 * ARRAY_COUNT(sRoomSpecies));
+
+    ResetSpriteData();
+    FreeAllSpritePalettes();
+}
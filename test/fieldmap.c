@@ -0,0 +1,99 @@
+#include "global.h"
+#include "fieldmap.h"
+#include "overworld.h"
+#include "random.h"
+#include "test/test.h"
+#include "constants/layouts.h"
+
+#define MOVER_COUNT (1 + 10) // The player and 10 object events.
+
+static const s8 sDirectionDeltas[][2] = {{0, 1}, {0, -1}, {-1, 0}, {1, 0}};
+
+static u32 Old_MapGridGetMetatileBehaviorAt(int x, int y)
+{
+    u16 metatile = MapGridGetMetatileIdAt(x, y);
+    return GetMetatileAttributesById(metatile) & METATILE_ATTR_BEHAVIOR_MASK;
+}
+
+static u8 Old_MapGridGetMetatileLayerTypeAt(int x, int y)
+{
+    u16 metatile = MapGridGetMetatileIdAt(x, y);
+    return (GetMetatileAttributesById(metatile) & METATILE_ATTR_LAYER_MASK) >> METATILE_ATTR_LAYER_SHIFT;
+}
+
+// Lays out every metatile once, in a 32x32 grid.
+static void LoadAllMetatilesMap(u16 mapLayoutId)
+{
+    u32 i;
+
+    gMapHeader.mapLayout = GetMapLayout(mapLayoutId);
+    LoadMetatileAttributes(gMapHeader.mapLayout);
+    gBackupMapLayout.map = sBackupMapData;
+    gBackupMapLayout.width = 32;
+    gBackupMapLayout.height = NUM_METATILES_TOTAL / 32;
+    for (i = 0; i < NUM_METATILES_TOTAL; i++)
+        sBackupMapData[i] = i;
+}
+
+TEST("MapGridGetMetatileBehaviorAt and MapGridGetMetatileLayerTypeAt match the tilesets' attributes")
+{
+    u32 mapLayoutId = 0;
+    int x, y;
+
+    PARAMETRIZE { mapLayoutId = LAYOUT_LITTLEROOT_TOWN; }
+    PARAMETRIZE { mapLayoutId = LAYOUT_SOOTOPOLIS_CITY; }
+
+    LoadAllMetatilesMap(mapLayoutId);
+    for (y = 0; y < gBackupMapLayout.height; y++)
+    {
+        for (x = 0; x < gBackupMapLayout.width; x++)
+        {
+            EXPECT_EQ(MapGridGetMetatileBehaviorAt(x, y), Old_MapGridGetMetatileBehaviorAt(x, y));
+            EXPECT_EQ(MapGridGetMetatileLayerTypeAt(x, y), Old_MapGridGetMetatileLayerTypeAt(x, y));
+        }
+    }
+}
+
+// Roughly the lookups a walk step makes for each mover: the behavior where it
+// stands and where it's going, and the layer type it's going to.
+TEST("Metatile attribute lookups for a walk step are faster from the table")
+{
+    struct Benchmark oldStep, newStep;
+    s16 coords[MOVER_COUNT][2];
+    u32 i, j, result = 0;
+
+    LoadAllMetatilesMap(LAYOUT_LITTLEROOT_TOWN);
+    for (i = 0; i < MOVER_COUNT; i++)
+    {
+        coords[i][0] = 1 + Random() % (gBackupMapLayout.width - 2);
+        coords[i][1] = 1 + Random() % (gBackupMapLayout.height - 2);
+    }
+
+    BENCHMARK(&oldStep)
+    {
+        for (i = 0; i < MOVER_COUNT; i++)
+        {
+            for (j = 0; j < ARRAY_COUNT(sDirectionDeltas); j++)
+            {
+                result += Old_MapGridGetMetatileBehaviorAt(coords[i][0], coords[i][1]);
+                result += Old_MapGridGetMetatileBehaviorAt(coords[i][0] + sDirectionDeltas[j][0], coords[i][1] + sDirectionDeltas[j][1]);
+                result += Old_MapGridGetMetatileLayerTypeAt(coords[i][0] + sDirectionDeltas[j][0], coords[i][1] + sDirectionDeltas[j][1]);
+            }
+        }
+    }
+    BENCHMARK(&newStep)
+    {
+        for (i = 0; i < MOVER_COUNT; i++)
+        {
+            for (j = 0; j < ARRAY_COUNT(sDirectionDeltas); j++)
+            {
+                result -= MapGridGetMetatileBehaviorAt(coords[i][0], coords[i][1]);
+                result -= MapGridGetMetatileBehaviorAt(coords[i][0] + sDirectionDeltas[j][0], coords[i][1] + sDirectionDeltas[j][1]);
+                result -= MapGridGetMetatileLayerTypeAt(coords[i][0] + sDirectionDeltas[j][0], coords[i][1] + sDirectionDeltas[j][1]);
+            }
+        }
+    }
+
+    EXPECT_EQ(result, 0);
+    EXPECT_FASTER(newStep, oldStep);
+}
@@ -0,0 +1,88 @@
+#include "global.h"
+#include "malloc.h"
+#include "test/test.h"
+
+#define SCREEN_ALLOC_COUNT 16
+
+static const u16 sScreenAllocSizes[SCREEN_ALLOC_COUNT] =
+{
+    0x800, 0x20, 0x14, 0x14, 0x600, 0x40, 0x100, 0x8,
+    0x800, 0x20, 0x8C, 0x14, 0x300, 0x40, 0x100, 0x8,
+};
+
+TEST("ArenaAlloc returns aligned, non-overlapping memory")
+{
+    struct Arena arena;
+    u8 *a, *b, *c;
+
+    EXPECT(ArenaOpen(&arena, 64));
+    a = ArenaAlloc(&arena, 3);
+    b = ArenaAlloc(&arena, 8);
+    c = ArenaAllocZeroed(&arena, 16);
+    EXPECT_EQ((uintptr_t)a & 3, 0);
+    EXPECT_EQ(b, a + 4);
+    EXPECT_EQ(c, b + 8);
+    EXPECT_EQ(c[0], 0);
+    EXPECT_EQ(c[15], 0);
+    EXPECT_EQ(ArenaMark(&arena), 28);
+    ArenaClose(&arena);
+    EXPECT(!ArenaIsOpen(&arena));
+}
+
+TEST("ArenaRewind releases scratch allocations")
+{
+    struct Arena arena;
+    u32 mark;
+    u8 *a, *b;
+
+    EXPECT(ArenaOpen(&arena, 64));
+    ArenaAlloc(&arena, 16);
+    mark = ArenaMark(&arena);
+    a = ArenaAlloc(&arena, 32);
+    ArenaRewind(&arena, mark);
+    b = ArenaAlloc(&arena, 32);
+    EXPECT_EQ(a, b);
+    ArenaClose(&arena);
+}
+
+TEST("ArenaClose returns the arena to the heap")
+{
+    struct Arena outer, inner;
+
+    EXPECT(ArenaOpen(&outer, 0x100));
+    EXPECT(ArenaOpen(&inner, 0x100));
+    ArenaAlloc(&inner, 0x80);
+    ArenaClose(&inner);
+    ArenaClose(&outer);
+    EXPECT(!HeapHead()->allocated);
+    EXPECT(HeapHead()->next == HeapHead());
+}
+
+TEST("ArenaAlloc is faster than Alloc for a screen's allocations")
+{
+    struct Benchmark heap, arena;
+    void *ptrs[SCREEN_ALLOC_COUNT];
+    struct Arena screenArena;
+    u32 i, size = 0;
+
+    for (i = 0; i < SCREEN_ALLOC_COUNT; i++)
+        size += sScreenAllocSizes[i];
+
+    BENCHMARK(&heap)
+    {
+        for (i = 0; i < SCREEN_ALLOC_COUNT; i++)
+            ptrs[i] = Alloc(sScreenAllocSizes[i]);
+        for (i = 0; i < SCREEN_ALLOC_COUNT; i++)
+            Free(ptrs[i]);
+    }
+
+    BENCHMARK(&arena)
+    {
+        ArenaOpen(&screenArena, size);
+        for (i = 0; i < SCREEN_ALLOC_COUNT; i++)
+            ptrs[i] = ArenaAlloc(&screenArena, sScreenAllocSizes[i]);
+        ArenaClose(&screenArena);
+    }
+
+    EXPECT_FASTER(arena, heap);
+}
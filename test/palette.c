@@ -0,0 +1,198 @@
+#include "global.h"
+#include "gpu_regs.h"
+#include "main.h"
+#include "palette.h"
+#include "random.h"
+#include "util.h"
+#include "test/test.h"
+#include "constants/rgb.h"
+
+static void Old_BlendPalette(u16 palOffset, u16 numEntries, u8 coeff, u32 blendColor)
+{
+    u16 i;
+    for (i = 0; i < numEntries; i++)
+    {
+        u16 index = i + palOffset;
+        struct PlttData *data1 = (struct PlttData *)&gPlttBufferUnfaded[index];
+        s8 r = data1->r;
+        s8 g = data1->g;
+        s8 b = data1->b;
+        struct PlttData *data2 = (struct PlttData *)&blendColor;
+        gPlttBufferFaded[index] = RGB(r + (((data2->r - r) * coeff) >> 4),
+                                      g + (((data2->g - g) * coeff) >> 4),
+                                      b + (((data2->b - b) * coeff) >> 4));
+    }
+}
+
+static void FillRandomPalettes(void)
+{
+    u32 i;
+    for (i = 0; i < PLTT_BUFFER_SIZE; i++)
+        gPlttBufferUnfaded[i] = Random();
+}
+
+TEST("BlendPalette blends the same as blending one color at a time")
+{
+    u16 *expected = (u16 *)gPaletteDecompressionBuffer;
+    u32 coeff = 0, blendColor = 0, palOffset = 0, numEntries = 0;
+
+    PARAMETRIZE { coeff = 0; blendColor = RGB_BLACK; palOffset = 0; numEntries = PLTT_BUFFER_SIZE; }
+    PARAMETRIZE { coeff = 16; blendColor = RGB_WHITE; palOffset = 0; numEntries = PLTT_BUFFER_SIZE; }
+    PARAMETRIZE { coeff = 7; blendColor = RGB(3, 29, 17); palOffset = 16; numEntries = 16; }
+    PARAMETRIZE { coeff = 11; blendColor = RGB(31, 0, 9); palOffset = 1; numEntries = 14; }
+    PARAMETRIZE { coeff = 3; blendColor = 0xFFFF; palOffset = 3; numEntries = 1; }
+
+    FillRandomPalettes();
+    Old_BlendPalette(palOffset, numEntries, coeff, blendColor);
+    CpuCopy16(gPlttBufferFaded, expected, PLTT_SIZE);
+    BlendPalette(palOffset, numEntries, coeff, blendColor);
+    EXPECT_EQ(memcmp(gPlttBufferFaded, expected, PLTT_SIZE), 0);
+}
+
+TEST("BlendPalette blends faster than blending one color at a time")
+{
+    struct Benchmark oldBlend, newBlend;
+
+    FillRandomPalettes();
+    BENCHMARK(&oldBlend) { Old_BlendPalette(0, PLTT_BUFFER_SIZE, 9, RGB(4, 20, 12)); }
+    BENCHMARK(&newBlend) { BlendPalette(0, PLTT_BUFFER_SIZE, 9, RGB(4, 20, 12)); }
+
+    EXPECT_FASTER(newBlend, oldBlend);
+}
+
+TEST("BeginBrightnessPaletteFade uses the brightness registers to fade the whole screen")
+{
+    u32 i;
+    u16 blendColor = 0, bldCnt = 0;
+
+    PARAMETRIZE { blendColor = RGB_BLACK; bldCnt = BLDCNT_TGT1_ALL | BLDCNT_EFFECT_DARKEN; }
+    PARAMETRIZE { blendColor = RGB_WHITE; bldCnt = BLDCNT_TGT1_ALL | BLDCNT_EFFECT_LIGHTEN; }
+
+    ResetPaletteFade();
+    for (i = 0; i < ARRAY_COUNT(gMain.oamBuffer); i++)
+        gMain.oamBuffer[i].objMode = ST_OAM_OBJ_NORMAL;
+    SetGpuReg(REG_OFFSET_DISPCNT, 0);
+    SetGpuReg(REG_OFFSET_BLDCNT, 0);
+    SetGpuReg(REG_OFFSET_BLDY, 0);
+    FillRandomPalettes();
+
+    BeginBrightnessPaletteFade(PALETTES_ALL, 0, 0, 16, blendColor);
+    EXPECT(IsBrightnessPaletteFadeActive());
+    EXPECT_EQ(memcmp(gPlttBufferFaded, gPlttBufferUnfaded, PLTT_SIZE), 0);
+
+    TransferPlttBuffer();
+    EXPECT_EQ(GetGpuReg(REG_OFFSET_BLDCNT), bldCnt);
+
+    while (UpdatePaletteFade() != PALETTE_FADE_STATUS_DONE)
+        TransferPlttBuffer();
+
+    // Once it's done, the fade's result is in the palettes like a software fade's.
+    EXPECT(!IsBrightnessPaletteFadeActive());
+    EXPECT_EQ(GetGpuReg(REG_OFFSET_BLDCNT), 0);
+    EXPECT_EQ(GetGpuReg(REG_OFFSET_BLDY), 0);
+    for (i = 0; i < PLTT_BUFFER_SIZE; i++)
+        EXPECT_EQ(gPlttBufferFaded[i], blendColor);
+}
+
+TEST("BeginBrightnessPaletteFade blends in software when the brightness registers can't be used")
+{
+    u32 selectedPalettes = 0;
+    u16 blendColor = 0, bldCnt = 0;
+
+    PARAMETRIZE { selectedPalettes = PALETTES_BG; blendColor = RGB_BLACK; bldCnt = 0; }
+    PARAMETRIZE { selectedPalettes = PALETTES_ALL; blendColor = RGB_RED; bldCnt = 0; }
+    PARAMETRIZE { selectedPalettes = PALETTES_ALL; blendColor = RGB_BLACK; bldCnt = BLDCNT_TGT1_BG1 | BLDCNT_EFFECT_BLEND; }
+
+    ResetPaletteFade();
+    SetGpuReg(REG_OFFSET_DISPCNT, 0);
+    SetGpuReg(REG_OFFSET_BLDCNT, bldCnt);
+    FillRandomPalettes();
+
+    BeginBrightnessPaletteFade(selectedPalettes, 0, 0, 16, blendColor);
+    EXPECT(!IsBrightnessPaletteFadeActive());
+
+    while (UpdatePaletteFade() != PALETTE_FADE_STATUS_DONE)
+        TransferPlttBuffer();
+
+    EXPECT_EQ(GetGpuReg(REG_OFFSET_BLDCNT), bldCnt);
+    EXPECT_EQ(gPlttBufferFaded[0], blendColor);
+    SetGpuReg(REG_OFFSET_BLDCNT, 0);
+}
+
+TEST("BeginNormalPaletteFade always blends in software")
+{
+    ResetPaletteFade();
+    SetGpuReg(REG_OFFSET_DISPCNT, 0);
+    SetGpuReg(REG_OFFSET_BLDCNT, 0);
+    FillRandomPalettes();
+
+    BeginNormalPaletteFade(PALETTES_ALL, 0, 0, 16, RGB_BLACK);
+    EXPECT(!IsBrightnessPaletteFadeActive());
+
+    while (UpdatePaletteFade() != PALETTE_FADE_STATUS_DONE)
+        TransferPlttBuffer();
+
+    EXPECT_EQ(GetGpuReg(REG_OFFSET_BLDCNT), 0);
+    EXPECT_EQ(gPlttBufferFaded[0], RGB_BLACK);
+}
+
+TEST("A brightness fade finishes in software if the screen sets up its own blend")
+{
+    u32 i;
+    u16 bldCnt = BLDCNT_TGT1_BG3 | BLDCNT_EFFECT_BLEND | BLDCNT_TGT2_ALL;
+
+    ResetPaletteFade();
+    for (i = 0; i < ARRAY_COUNT(gMain.oamBuffer); i++)
+        gMain.oamBuffer[i].objMode = ST_OAM_OBJ_NORMAL;
+    SetGpuReg(REG_OFFSET_DISPCNT, 0);
+    SetGpuReg(REG_OFFSET_BLDCNT, 0);
+    SetGpuReg(REG_OFFSET_BLDY, 0);
+    FillRandomPalettes();
+
+    BeginBrightnessPaletteFade(PALETTES_ALL, 0, 16, 0, RGB_BLACK);
+    EXPECT(IsBrightnessPaletteFadeActive());
+    TransferPlttBuffer();
+
+    // Like battle_factory_screen.c's BG3 alpha blend right after its fade starts.
+    SetGpuReg(REG_OFFSET_BLDCNT, bldCnt);
+    TransferPlttBuffer();
+    EXPECT_EQ(GetGpuReg(REG_OFFSET_BLDCNT), bldCnt);
+
+    UpdatePaletteFade();
+    EXPECT(!IsBrightnessPaletteFadeActive());
+    while (UpdatePaletteFade() != PALETTE_FADE_STATUS_DONE)
+        TransferPlttBuffer();
+
+    // The screen's blend is kept, and the palettes end up unfaded.
+    EXPECT_EQ(GetGpuReg(REG_OFFSET_BLDCNT), bldCnt);
+    EXPECT_EQ(memcmp(gPlttBufferFaded, gPlttBufferUnfaded, PLTT_SIZE), 0);
+    SetGpuReg(REG_OFFSET_BLDCNT, 0);
+}
+
+TEST("TransferDirtyPlttBuffer only copies the palettes that changed")
+{
+    static const u16 colors[32] = {RGB_RED, RGB_GREEN, RGB_BLUE, RGB_WHITE};
+
+    ResetPaletteFade();
+    TransferPlttBuffer();
+    EXPECT_EQ(gPlttTransferStats.lastBytes, PLTT_SIZE);
+
+    // The first transfer after a full one copies everything.
+    TransferDirtyPlttBuffer();
+    EXPECT_EQ(gPlttTransferStats.lastBytes, PLTT_SIZE);
+    TransferDirtyPlttBuffer();
+    EXPECT_EQ(gPlttTransferStats.lastBytes, 0);
+
+    LoadPalette(colors, OBJ_PLTT_ID(3), PLTT_SIZE_4BPP);
+    TransferDirtyPlttBuffer();
+    EXPECT_EQ(gPlttTransferStats.lastBytes, PLTT_SIZE_4BPP);
+    EXPECT_EQ(memcmp((u16 *)PLTT + OBJ_PLTT_ID(3), colors, PLTT_SIZE_4BPP), 0);
+
+    // Colors that straddle two banks copy both.
+    LoadPalette(colors, BG_PLTT_ID(1) + 8, PLTT_SIZE_4BPP);
+    BlendPalette(BG_PLTT_ID(7), 1, 8, RGB_BLACK);
+    TransferDirtyPlttBuffer();
+    EXPECT_EQ(gPlttTransferStats.lastBytes, 3 * PLTT_SIZE_4BPP);
+    EXPECT_EQ(memcmp((u16 *)PLTT + BG_PLTT_ID(1) + 8, colors, PLTT_SIZE_4BPP), 0);
+    EXPECT_EQ(((u16 *)PLTT)[BG_PLTT_ID(7)], gPlttBufferFaded[BG_PLTT_ID(7)]);
+}
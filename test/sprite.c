@@ -121,6 +121,75 @@ TEST("BuildOamBuffer faster with mix of sprites")
     BenchmarkBuildOamBuffer(FALSE);
 }
 
+static const union AnimCmd sAnim_Cycle[] =
+{
+    ANIMCMD_FRAME(0, 8),
+    ANIMCMD_FRAME(1, 8),
+    ANIMCMD_FRAME(2, 5, .hFlip = TRUE),
+    ANIMCMD_JUMP(0),
+};
+
+static const union AnimCmd sAnim_Loop[] =
+{
+    ANIMCMD_FRAME(0, 3),
+    ANIMCMD_LOOP(0),
+    ANIMCMD_FRAME(1, 2),
+    ANIMCMD_FRAME(2, 3),
+    ANIMCMD_LOOP(4),
+    ANIMCMD_FRAME(3, 6),
+    ANIMCMD_JUMP(0),
+};
+
+static const union AnimCmd sAnim_End[] =
+{
+    ANIMCMD_FRAME(0, 5),
+    ANIMCMD_FRAME(1, 5),
+    ANIMCMD_END,
+};
+
+static const union AnimCmd *const sAnims[] =
+{
+    sAnim_Cycle,
+    sAnim_Loop,
+    sAnim_End,
+};
+
+TEST("AdvanceSpriteAnim ends up where AnimateSprite would")
+{
+    u32 animNum = 0, frames = 0, i;
+    struct Sprite *stepped, *advanced;
+
+    for (i = 0; i < ARRAY_COUNT(sAnims); i++)
+    {
+        PARAMETRIZE { animNum = i; frames = 1; }
+        PARAMETRIZE { animNum = i; frames = 7; }
+        PARAMETRIZE { animNum = i; frames = 100; }
+        PARAMETRIZE { animNum = i; frames = 10007; }
+    }
+
+    ResetSpriteData_();
+    stepped = &gSprites[CreateSprite(&gDummySpriteTemplate, 0, 0, 0)];
+    advanced = &gSprites[CreateSprite(&gDummySpriteTemplate, 0, 0, 0)];
+    stepped->anims = advanced->anims = sAnims;
+    stepped->usingSheet = advanced->usingSheet = TRUE;
+    stepped->sheetTileStart = advanced->sheetTileStart = 0;
+    StartSpriteAnim(stepped, animNum);
+    StartSpriteAnim(advanced, animNum);
+    AnimateSprite(stepped);
+    AnimateSprite(advanced);
+
+    for (i = 0; i < frames; i++)
+        AnimateSprite(stepped);
+    AdvanceSpriteAnim(advanced, frames);
+
+    EXPECT_EQ(advanced->animCmdIndex, stepped->animCmdIndex);
+    EXPECT_EQ((u32)advanced->animDelayCounter, (u32)stepped->animDelayCounter);
+    EXPECT_EQ(advanced->animLoopCounter, stepped->animLoopCounter);
+    EXPECT_EQ((u32)advanced->animEnded, (u32)stepped->animEnded);
+    EXPECT_EQ((u32)advanced->oam.tileNum, (u32)stepped->oam.tileNum);
+    EXPECT_EQ((u32)advanced->oam.matrixNum, (u32)stepped->oam.matrixNum);
+}
+
 // Old implementation.
 
 #define UBFIX
@@ -26,6 +26,10 @@ __attribute__((section(".persistent"))) static struct {
     u32 state:1;
 } sCurrentTest = {0};
 
+// How many of this runner's tests have been skipped because Hydra already
+// has their results from a process that crashed.
+__attribute__((section(".persistent"))) static u16 sResumedTests = 0;
+
 void TestRunner_Battle(const struct Test *);
 
 static bool32 MgbaOpen_(void);
@@ -62,45 +66,119 @@ enum
     STATE_EXIT,
 };
 
-static u32 MinCostProcess(void)
+static bool32 ProcessCostLess(const struct ProcessCost *a, const struct ProcessCost *b)
+{
+    return a->cost < b->cost || (a->cost == b->cost && a->process < b->process);
+}
+
+static void SiftDownProcessCost(u32 i)
+{
+    struct ProcessCost *heap = gTestRunnerState.processCosts;
+    u32 n = gTestRunnerState.processCount;
+
+    while (TRUE)
+    {
+        u32 child = 2 * i + 1;
+        struct ProcessCost temp;
+
+        if (child >= n)
+            break;
+        if (child + 1 < n && ProcessCostLess(&heap[child + 1], &heap[child]))
+            child++;
+        if (!ProcessCostLess(&heap[child], &heap[i]))
+            break;
+
+        temp = heap[i];
+        heap[i] = heap[child];
+        heap[child] = temp;
+        i = child;
+    }
+}
+
+// Starts each process with the cost of the tests that Hydra assigned to
+// it from its timings.
+static void InitProcessCosts(void)
 {
     u32 i;
-    u32 minCost, minCostProcess;
 
-    minCost = gTestRunnerState.processCosts[0];
-    minCostProcess = 0;
-    for (i = 1; i < gTestRunnerN; i++)
+    gTestRunnerState.processCount = gTestRunnerN != 0 ? gTestRunnerN : 1;
+    for (i = 0; i < gTestRunnerState.processCount; i++)
     {
-        if (gTestRunnerState.processCosts[i] < minCost)
-        {
-            minCost = gTestRunnerState.processCosts[i];
-            minCostProcess = i;
-        }
+        gTestRunnerState.processCosts[i].cost = gTestRunnerProcessCosts[i];
+        gTestRunnerState.processCosts[i].process = i;
+    }
+    for (i = gTestRunnerState.processCount / 2; i > 0; i--)
+        SiftDownProcessCost(i - 1);
+}
+
+static u32 AddCostToMinProcess(u32 cost)
+{
+    u32 process = gTestRunnerState.processCosts[0].process;
+    gTestRunnerState.processCosts[0].cost += cost;
+    SiftDownProcessCost(0);
+    return process;
+}
+
+// FNV-1a, as in Hydra.
+static u32 HashTestName(const char *name)
+{
+    u32 hash = 2166136261;
+
+    while (*name)
+    {
+        hash ^= (u8)*name++;
+        hash *= 16777619;
     }
 
-    return minCostProcess;
+    return hash;
 }
 
-// Greedily assign tests to processes based on estimated cost.
-// TODO: Make processCosts a min heap.
+static const struct TestAssignment *FindTestAssignment(const char *name)
+{
+    u32 hash = HashTestName(name);
+    u32 lo = 0, hi = gTestRunnerAssignmentsCount;
+
+    while (lo < hi)
+    {
+        u32 mid = (lo + hi) / 2;
+        if (gTestRunnerAssignments[mid].nameHash < hash)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo < gTestRunnerAssignmentsCount && gTestRunnerAssignments[lo].nameHash == hash)
+        return &gTestRunnerAssignments[lo];
+    else
+        return NULL;
+}
+
+// Tests that Hydra has timings for go to the process it assigned them,
+// longest first. The rest are greedily assigned to processes based on
+// estimated cost.
 static u32 AssignCostToRunner(void)
 {
-    u32 minCostProcess;
+    const struct TestAssignment *assignment;
 
     if (gTestRunnerState.test->runner == &gAssumptionsRunner)
         return gTestRunnerI;
 
-    minCostProcess = MinCostProcess();
+    assignment = FindTestAssignment(gTestRunnerState.test->name);
+    if (assignment != NULL)
+        return assignment->process;
+
+    // The timings are in different units to estimateCost, so once
+    // there are timings the other tests cost the typical timing.
+    if (gTestRunnerAssignmentsCount != 0)
+        return AddCostToMinProcess(gTestRunnerDefaultCost);
 
     // XXX: If estimateCost returns only on some processes, or
     // returns inconsistent results then processCosts will be
     // inconsistent and some tests may not run.
     if (gTestRunnerState.test->runner->estimateCost)
-        gTestRunnerState.processCosts[minCostProcess] += gTestRunnerState.test->runner->estimateCost(gTestRunnerState.test->data);
+        return AddCostToMinProcess(gTestRunnerState.test->runner->estimateCost(gTestRunnerState.test->data));
     else
-        gTestRunnerState.processCosts[minCostProcess] += 1;
-
-    return minCostProcess;
+        return AddCostToMinProcess(1);
 }
 
 void CB2_TestRunner(void)
@@ -126,21 +204,25 @@ top:
 
         gSaveBlock2Ptr->optionsBattleStyle = OPTIONS_BATTLE_STYLE_SET;
 
+        InitProcessCosts();
+
         // The current test restarted the ROM (e.g. by jumping to NULL).
         if (sCurrentTest.address != 0)
         {
             gTestRunnerState.test = __start_tests;
             while ((uintptr_t)gTestRunnerState.test != sCurrentTest.address)
             {
-                AssignCostToRunner();
+                if (gTestRunnerState.test->runner == &gAssumptionsRunner
+                 || PrefixMatch(gTestRunnerArgv, gTestRunnerState.test->name))
+                    AssignCostToRunner();
                 gTestRunnerState.test++;
             }
             if (sCurrentTest.state == CURRENT_TEST_STATE_ESTIMATE)
             {
-                u32 runner = MinCostProcess();
-                gTestRunnerState.processCosts[runner] += 1;
+                u32 runner = AddCostToMinProcess(1);
                 if (runner == gTestRunnerI)
                 {
+                    Test_MgbaPrintf(":N%s", gTestRunnerState.test->name);
                     gTestRunnerState.state = STATE_REPORT_RESULT;
                     gTestRunnerState.result = TEST_RESULT_CRASH;
                 }
@@ -180,7 +262,6 @@ top:
                 break;
         }
 
-        Test_MgbaPrintf(":N%s", gTestRunnerState.test->name);
         gTestRunnerState.result = TEST_RESULT_PASS;
         gTestRunnerState.expectedResult = TEST_RESULT_PASS;
         gTestRunnerState.expectLeaks = FALSE;
@@ -198,10 +279,24 @@ top:
 
         // If AssignCostToRunner fails, we want to report the failure.
         gTestRunnerState.state = STATE_REPORT_RESULT;
-        if (AssignCostToRunner() == gTestRunnerI)
+        if (AssignCostToRunner() != gTestRunnerI)
+        {
+            gTestRunnerState.state = STATE_NEXT_TEST;
+        }
+        else if (gTestRunnerState.test->runner == &gAssumptionsRunner)
+        {
             gTestRunnerState.state = STATE_RUN_TEST;
-        else
+        }
+        else if (sResumedTests < gTestRunnerResume)
+        {
+            sResumedTests++;
             gTestRunnerState.state = STATE_NEXT_TEST;
+        }
+        else
+        {
+            Test_MgbaPrintf(":N%s", gTestRunnerState.test->name);
+            gTestRunnerState.state = STATE_RUN_TEST;
+        }
 
         break;
 
@@ -364,6 +459,7 @@ top:
         break;
 
     case STATE_EXIT:
+        Test_MgbaPrintf(":D");
         MgbaExit_(gTestRunnerState.exitCode);
         break;
     }
@@ -1,8 +1,16 @@
 #include "global.h"
+#include "test/test.h"
 
 // These values are patched by patchelf. Therefore we have put them in
 // their own TU so that the optimizer cannot inline them.
 const bool8 gTestRunnerEnabled = TRUE;
 const u8 gTestRunnerN = 0;
 const u8 gTestRunnerI = 0;
+const u16 gTestRunnerResume = 0;
 const char gTestRunnerArgv[256] = {'\0'};
+
+// Hydra patches these from its timings of previous runs.
+const u32 gTestRunnerAssignmentsCount = 0;
+const u32 gTestRunnerDefaultCost = 0;
+const u32 gTestRunnerProcessCosts[MAX_PROCESSES] = {0};
+const struct TestAssignment gTestRunnerAssignments[MAX_TEST_ASSIGNMENTS] = {0};
@@ -1,8 +1,15 @@
 #include "global.h"
 #include "test/test.h"
 #include "battle_main.h"
+#include "bg.h"
+#include "dma3.h"
 #include "item.h"
+#include "malloc.h"
+#include "menu.h"
+#include "random.h"
+#include "static_text.h"
 #include "text.h"
+#include "window.h"
 #include "constants/abilities.h"
 #include "constants/items.h"
 #include "constants/moves.h"
@@ -548,3 +555,258 @@ TEST("Type names fit on Pokedex Search Screen")
     }
     EXPECT_LE(GetStringWidth(fontId, gTypesInfo[type].name, 0), widthPx);
 }
+
+static const struct BgTemplate sTextBenchmarkBgTemplate =
+{
+    .bg = 0,
+    .charBaseIndex = 2,
+    .mapBaseIndex = 31,
+    .screenSize = 0,
+    .paletteMode = 0,
+    .priority = 0,
+    .baseTile = 0,
+};
+
+static const struct WindowTemplate sTextBenchmarkWindowTemplates[] =
+{
+    {
+        .bg = 0,
+        .tilemapLeft = 1,
+        .tilemapTop = 1,
+        .width = 28,
+        .height = 4,
+        .paletteNum = 15,
+        .baseBlock = 1,
+    },
+    DUMMY_WIN_TEMPLATE,
+};
+
+#define TEXT_BENCHMARK_WINDOW_SIZE (28 * 4 * TILE_SIZE_4BPP)
+
+static void SetUpTextBenchmarkWindow(void)
+{
+    ClearDma3Requests();
+    ResetBgsAndClearDma3BusyFlags(0);
+    InitBgsFromTemplates(0, &sTextBenchmarkBgTemplate, 1);
+    InitWindows(sTextBenchmarkWindowTemplates);
+    FillWindowPixelBuffer(0, PIXEL_FILL(1));
+}
+
+static void TearDownTextBenchmarkWindow(void)
+{
+    FreeAllWindowBuffers();
+    ClearDma3Requests();
+}
+
+// The per-pixel GLYPH_COPY that CopyGlyphToWindow used before it copied
+// whole tile rows.
+static void Old_GlyphCopy(u8 *windowTiles, u32 widthOffset, u32 j, u32 i, u32 *glyphPixels, s32 width, s32 height)
+{
+    u32 xAdd, yAdd, pixelData, bits, toOrr, dummyX;
+    u8 *dst;
+
+    xAdd = j + width;
+    yAdd = i + height;
+    dummyX = j;
+    for (; i < yAdd; i++)
+    {
+        pixelData = *glyphPixels++;
+        for (j = dummyX; j < xAdd; j++)
+        {
+            if ((toOrr = pixelData & 0xF))
+            {
+                dst = windowTiles + ((j / 8) * 32) + ((j % 8) / 2) + ((i / 8) * widthOffset) + ((i % 8) * 4);
+                bits = ((j & 1) * 4);
+                *dst = (toOrr << bits) | (*dst & (0xF0 >> bits));
+            }
+            pixelData >>= 4;
+        }
+    }
+}
+
+static void Old_CopyGlyphToWindow(struct TextPrinter *textPrinter)
+{
+    struct Window *window = &gWindows[textPrinter->printerTemplate.windowId];
+    struct WindowTemplate *template = &window->window;
+    u32 *glyphPixels = gCurGlyph.gfxBufferTop;
+    u32 currX = textPrinter->printerTemplate.currentX;
+    u32 currY = textPrinter->printerTemplate.currentY;
+    u32 widthOffset = template->width * 32;
+    u8 *windowTiles = window->tileData;
+    s32 glyphWidth, glyphHeight;
+
+    if ((glyphWidth = (template->width * 8) - currX) > gCurGlyph.width)
+        glyphWidth = gCurGlyph.width;
+    if ((glyphHeight = (template->height * 8) - currY) > gCurGlyph.height)
+        glyphHeight = gCurGlyph.height;
+
+    if (glyphWidth < 9)
+    {
+        if (glyphHeight < 9)
+        {
+            Old_GlyphCopy(windowTiles, widthOffset, currX, currY, glyphPixels, glyphWidth, glyphHeight);
+        }
+        else
+        {
+            Old_GlyphCopy(windowTiles, widthOffset, currX, currY, glyphPixels, glyphWidth, 8);
+            Old_GlyphCopy(windowTiles, widthOffset, currX, currY + 8, glyphPixels + 16, glyphWidth, glyphHeight - 8);
+        }
+    }
+    else
+    {
+        if (glyphHeight < 9)
+        {
+            Old_GlyphCopy(windowTiles, widthOffset, currX, currY, glyphPixels, 8, glyphHeight);
+            Old_GlyphCopy(windowTiles, widthOffset, currX + 8, currY, glyphPixels + 8, glyphWidth - 8, glyphHeight);
+        }
+        else
+        {
+            Old_GlyphCopy(windowTiles, widthOffset, currX, currY, glyphPixels, 8, 8);
+            Old_GlyphCopy(windowTiles, widthOffset, currX + 8, currY, glyphPixels + 8, glyphWidth - 8, 8);
+            Old_GlyphCopy(windowTiles, widthOffset, currX, currY + 8, glyphPixels + 16, 8, glyphHeight - 8);
+            Old_GlyphCopy(windowTiles, widthOffset, currX + 8, currY + 8, glyphPixels + 24, glyphWidth - 8, glyphHeight - 8);
+        }
+    }
+}
+
+TEST("CopyGlyphToWindow matches and is faster than copying pixel by pixel")
+{
+    struct Benchmark oldCopy, newCopy;
+    struct TextPrinter printer = {0};
+    u8 *oldTiles;
+    u32 i, x = 0, width = 0;
+
+    for (i = 0; i < 8; i++)
+    {
+        PARAMETRIZE { x = i; width = 6; }
+        PARAMETRIZE { x = i; width = 11; }
+    }
+
+    SetUpTextBenchmarkWindow();
+    oldTiles = Alloc(TEXT_BENCHMARK_WINDOW_SIZE);
+
+    // Random pixels, with plenty of transparent ones.
+    SeedRng(0);
+    for (i = 0; i < ARRAY_COUNT(gCurGlyph.gfxBufferTop); i++)
+    {
+        gCurGlyph.gfxBufferTop[i] = Random32() & Random32();
+        gCurGlyph.gfxBufferBottom[i] = Random32() & Random32();
+    }
+    gCurGlyph.width = width;
+    gCurGlyph.height = 15;
+    printer.printerTemplate.windowId = 0;
+    printer.printerTemplate.currentX = 8 * 5 + x;
+    printer.printerTemplate.currentY = 3;
+
+    BENCHMARK(&oldCopy)
+    {
+        Old_CopyGlyphToWindow(&printer);
+    }
+    memcpy(oldTiles, gWindows[0].tileData, TEXT_BENCHMARK_WINDOW_SIZE);
+
+    FillWindowPixelBuffer(0, PIXEL_FILL(1));
+    BENCHMARK(&newCopy)
+    {
+        CopyGlyphToWindow(&printer);
+    }
+
+    EXPECT(memcmp(oldTiles, gWindows[0].tileData, TEXT_BENCHMARK_WINDOW_SIZE) == 0);
+    EXPECT_FASTER(newCopy, oldCopy);
+
+    Free(oldTiles);
+    TearDownTextBenchmarkWindow();
+}
+
+TEST("Instant text renders faster with cached glyphs")
+{
+    static const u8 sText[] = _("POKéMON   BAG   SAVE   OPTION   EXIT\nAttack  Defense  Sp. Atk  Sp. Def  Speed");
+    struct Benchmark cold, warm;
+    u8 *coldTiles;
+
+    SetUpTextBenchmarkWindow();
+    coldTiles = Alloc(TEXT_BENCHMARK_WINDOW_SIZE);
+
+    ResetGlyphCache();
+    BENCHMARK(&cold)
+    {
+        AddTextPrinterParameterized(0, FONT_NORMAL, sText, 0, 1, TEXT_SKIP_DRAW, NULL);
+    }
+    memcpy(coldTiles, gWindows[0].tileData, TEXT_BENCHMARK_WINDOW_SIZE);
+
+    FillWindowPixelBuffer(0, PIXEL_FILL(1));
+    BENCHMARK(&warm)
+    {
+        AddTextPrinterParameterized(0, FONT_NORMAL, sText, 0, 1, TEXT_SKIP_DRAW, NULL);
+    }
+
+    EXPECT(memcmp(coldTiles, gWindows[0].tileData, TEXT_BENCHMARK_WINDOW_SIZE) == 0);
+    EXPECT_FASTER(warm, cold);
+
+    Free(coldTiles);
+    TearDownTextBenchmarkWindow();
+}
+
+TEST("Static text blits the same pixels as the text printer")
+{
+    const struct StaticText *staticText;
+    u8 colors[3];
+    u8 *printedTiles;
+    u32 i, id = 0;
+
+    for (i = 0; i < STATIC_TEXT_COUNT; i++)
+    {
+        PARAMETRIZE_LABEL("%S", gStaticTexts[i].text) { id = i; }
+    }
+
+    staticText = &gStaticTexts[id];
+    colors[0] = staticText->bgColor;
+    colors[1] = staticText->fgColor;
+    colors[2] = staticText->shadowColor;
+
+    SetUpTextBenchmarkWindow();
+    printedTiles = Alloc(TEXT_BENCHMARK_WINDOW_SIZE);
+
+    AddTextPrinterParameterized4(0, staticText->fontId, 3, 1, 0, 0, colors, TEXT_SKIP_DRAW, staticText->text);
+    memcpy(printedTiles, gWindows[0].tileData, TEXT_BENCHMARK_WINDOW_SIZE);
+
+    FillWindowPixelBuffer(0, PIXEL_FILL(1));
+    BlitStaticTextToWindow(0, id, 3, 1);
+
+    EXPECT_EQ(GetStaticTextWidth(id), GetStringWidth(staticText->fontId, staticText->text, 0));
+    EXPECT(memcmp(printedTiles, gWindows[0].tileData, TEXT_BENCHMARK_WINDOW_SIZE) == 0);
+
+    Free(printedTiles);
+    TearDownTextBenchmarkWindow();
+}
+
+TEST("Static text is faster than printing the same strings")
+{
+    struct Benchmark printed, blitted;
+    const struct StaticText *staticText;
+    u8 colors[3];
+    u32 i;
+
+    SetUpTextBenchmarkWindow();
+
+    BENCHMARK(&printed)
+    {
+        for (i = 0; i < STATIC_TEXT_COUNT; i++)
+        {
+            staticText = &gStaticTexts[i];
+            colors[0] = staticText->bgColor;
+            colors[1] = staticText->fgColor;
+            colors[2] = staticText->shadowColor;
+            AddTextPrinterParameterized4(0, staticText->fontId, i % 8, 1, 0, 0, colors, TEXT_SKIP_DRAW, staticText->text);
+        }
+    }
+
+    BENCHMARK(&blitted)
+    {
+        for (i = 0; i < STATIC_TEXT_COUNT; i++)
+            BlitStaticTextToWindow(0, i, i % 8, 1);
+    }
+
+    EXPECT_FASTER(blitted, printed);
+
+    TearDownTextBenchmarkWindow();
+}
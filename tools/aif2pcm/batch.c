@@ -0,0 +1,437 @@
+// Batch mode runs every conversion in a manifest in one process, on a pool of
+// threads. With a cache directory, it also keeps each output under a hash of
+// everything that goes into it, and copies unchanged conversions from the cache
+// instead of redoing them, even if their timestamps changed, like after a
+// branch switch or a clean.
+//
+//   aif2pcm -batch MANIFEST_FILE [-j THREADS] [-cache CACHE_DIR]
+//
+// Each line of the manifest is one conversion, with the same arguments as on
+// the command line, except that the output file has to be given. Blank lines
+// and lines starting with # are ignored. Conversions whose input doesn't exist
+// are skipped, so that a manifest made with `make -n` can include files that
+// make builds some other way.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "global.h"
+#include "batch.h"
+
+// Bump this if cached outputs need to be thrown away for some reason other
+// than aif2pcm itself changing, which is already part of every key.
+#define BATCH_CACHE_VERSION 1
+
+enum batch_result
+{
+	BATCH_CACHED,
+	BATCH_CONVERTED,
+	BATCH_SKIPPED,
+};
+
+struct batch_job
+{
+	int argc;
+	char **argv;
+};
+
+struct cache_key
+{
+	uint64_t a;
+	uint64_t b;
+};
+
+struct batch
+{
+	struct batch_job *jobs;
+	int job_count;
+	convert_function convert;
+	char *cache_dir;
+	struct cache_key tool_key;
+	pthread_mutex_t mutex;
+	int next_job;
+	int results[3];
+};
+
+static unsigned char *read_file_if_exists(const char *path, long *size)
+{
+	FILE *fp = fopen(path, "rb");
+
+	if (fp == NULL)
+		return NULL;
+
+	fseek(fp, 0, SEEK_END);
+	*size = ftell(fp);
+	rewind(fp);
+
+	unsigned char *buffer = malloc(*size + 1);
+
+	if (buffer == NULL)
+		FATAL_ERROR("Failed to allocate memory for reading '%s'!\n", path);
+
+	if (*size != 0 && fread(buffer, *size, 1, fp) != 1)
+		FATAL_ERROR("Failed to read data from '%s'!\n", path);
+
+	buffer[*size] = 0;
+	fclose(fp);
+	return buffer;
+}
+
+static void write_whole_file(const char *path, const unsigned char *data, long size)
+{
+	FILE *fp = fopen(path, "wb");
+
+	if (fp == NULL)
+		FATAL_ERROR("Failed to open '%s' for writing!\n", path);
+
+	bool written = fwrite(data, 1, size, fp) == (size_t)size;
+
+	if (fclose(fp) != 0 || !written)
+		FATAL_ERROR("Failed to write data to '%s'!\n", path);
+}
+
+// Two 64-bit FNV-1a style hashes with different multipliers, so that a
+// collision would need to hit both.
+static void hash_bytes(struct cache_key *key, const void *data, size_t size)
+{
+	const unsigned char *bytes = data;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		key->a = (key->a ^ bytes[i]) * 0x100000001B3ull;
+		key->b = (key->b ^ bytes[i]) * 0x9E3779B97F4A7C15ull;
+	}
+}
+
+// Hashes the length first, so that adjacent fields can't run into each other.
+static void hash_field(struct cache_key *key, const void *data, size_t size)
+{
+	uint64_t length = size;
+
+	hash_bytes(key, &length, sizeof(length));
+	hash_bytes(key, data, size);
+}
+
+static void hash_string(struct cache_key *key, const char *s)
+{
+	hash_field(key, s, strlen(s));
+}
+
+static const char *get_path_extension(const char *path)
+{
+	const char *slash = strrchr(path, '/');
+	const char *dot = strrchr(path, '.');
+
+	return (dot != NULL && (slash == NULL || dot > slash)) ? dot : "";
+}
+
+// The key covers aif2pcm itself, the input and output types, the options, and
+// the contents of the input. It doesn't cover the paths, so identical samples
+// share an entry.
+static bool get_cache_key(struct batch *batch, struct batch_job *job, struct cache_key *key)
+{
+	long size;
+	unsigned char *contents = read_file_if_exists(job->argv[1], &size);
+
+	if (contents == NULL)
+		return false;
+
+	*key = batch->tool_key;
+	hash_string(key, get_path_extension(job->argv[1]));
+	hash_string(key, get_path_extension(job->argv[2]));
+
+	for (int i = 3; i < job->argc; i++)
+		hash_string(key, job->argv[i]);
+
+	hash_field(key, contents, size);
+	free(contents);
+	return true;
+}
+
+static char *get_cache_path(struct batch *batch, struct cache_key *key, const char *suffix)
+{
+	size_t size = strlen(batch->cache_dir) + 1 + 32 + strlen(suffix) + 1;
+	char *path = malloc(size);
+
+	if (path == NULL)
+		FATAL_ERROR("Failed to allocate cache path!\n");
+
+	snprintf(path, size, "%s/%016llx%016llx%s", batch->cache_dir,
+	         (unsigned long long)key->a, (unsigned long long)key->b, suffix);
+	return path;
+}
+
+// Writes to a temporary file first, so that another aif2pcm reading the same
+// cache never sees half of an entry.
+static void store_in_cache(struct batch *batch, struct cache_key *key, struct batch_job *job, int job_index)
+{
+	long size;
+	unsigned char *output = read_file_if_exists(job->argv[2], &size);
+	char suffix[64];
+
+	if (output == NULL)
+		FATAL_ERROR("Conversion to '%s' didn't write it!\n", job->argv[2]);
+
+	snprintf(suffix, sizeof(suffix), ".%ld.%d.tmp", (long)getpid(), job_index);
+
+	char *temp_path = get_cache_path(batch, key, suffix);
+	char *path = get_cache_path(batch, key, "");
+	FILE *fp = fopen(temp_path, "wb");
+
+	if (fp != NULL)
+	{
+		bool written = fwrite(output, 1, size, fp) == (size_t)size;
+
+		if (fclose(fp) != 0 || !written || rename(temp_path, path) != 0)
+			remove(temp_path);
+	}
+
+	free(temp_path);
+	free(path);
+	free(output);
+}
+
+static enum batch_result run_batch_job(struct batch *batch, int job_index)
+{
+	struct batch_job *job = &batch->jobs[job_index];
+	struct cache_key key;
+	long size;
+
+	if (batch->cache_dir == NULL)
+	{
+		if (access(job->argv[1], F_OK) != 0)
+			return BATCH_SKIPPED;
+
+		batch->convert(job->argc, job->argv);
+		return BATCH_CONVERTED;
+	}
+
+	if (!get_cache_key(batch, job, &key))
+		return BATCH_SKIPPED;
+
+	char *path = get_cache_path(batch, &key, "");
+	unsigned char *cached = read_file_if_exists(path, &size);
+
+	free(path);
+
+	if (cached != NULL)
+	{
+		write_whole_file(job->argv[2], cached, size);
+		free(cached);
+		return BATCH_CACHED;
+	}
+
+	batch->convert(job->argc, job->argv);
+	store_in_cache(batch, &key, job, job_index);
+	return BATCH_CONVERTED;
+}
+
+static void *batch_worker(void *arg)
+{
+	struct batch *batch = arg;
+
+	for (;;)
+	{
+		pthread_mutex_lock(&batch->mutex);
+		int job_index = batch->next_job++;
+		pthread_mutex_unlock(&batch->mutex);
+
+		if (job_index >= batch->job_count)
+			break;
+
+		enum batch_result result = run_batch_job(batch, job_index);
+
+		pthread_mutex_lock(&batch->mutex);
+		batch->results[result]++;
+		pthread_mutex_unlock(&batch->mutex);
+	}
+
+	return NULL;
+}
+
+static int compare_outputs(const void *a, const void *b)
+{
+	return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+static void read_manifest(struct batch *batch, char *manifest_path)
+{
+	long size;
+	char *manifest = (char *)read_file_if_exists(manifest_path, &size);
+	int line_num = 0;
+	int capacity = 0;
+
+	if (manifest == NULL)
+		FATAL_ERROR("Failed to open '%s' for reading!\n", manifest_path);
+
+	batch->jobs = NULL;
+	batch->job_count = 0;
+
+	for (char *line = manifest; line != NULL && *line != 0;)
+	{
+		char *next = strchr(line, '\n');
+		int argc = 1;
+		char **argv;
+
+		if (next != NULL)
+			*next++ = 0;
+
+		line_num++;
+
+		// The arguments point into the manifest, which is never freed.
+		argv = malloc(sizeof(*argv) * (strlen(line) / 2 + 3));
+
+		if (argv == NULL)
+			FATAL_ERROR("Failed to allocate manifest line!\n");
+
+		argv[0] = "aif2pcm";
+
+		for (char *arg = strtok(line, " \t\r"); arg != NULL; arg = strtok(NULL, " \t\r"))
+			argv[argc++] = arg;
+
+		argv[argc] = NULL;
+		line = next;
+
+		if (argc == 1 || argv[1][0] == '#')
+		{
+			free(argv);
+			continue;
+		}
+
+		if (argc < 3 || argv[1][0] == '-' || argv[2][0] == '-')
+			FATAL_ERROR("%s:%d: Expected an input file and an output file!\n", manifest_path, line_num);
+
+		if (batch->job_count == capacity)
+		{
+			capacity = capacity ? capacity * 2 : 256;
+			batch->jobs = realloc(batch->jobs, sizeof(*batch->jobs) * capacity);
+
+			if (batch->jobs == NULL)
+				FATAL_ERROR("Failed to allocate manifest!\n");
+		}
+
+		struct batch_job *job = &batch->jobs[batch->job_count++];
+
+		job->argc = argc;
+		job->argv = argv;
+	}
+}
+
+static void check_outputs(struct batch *batch)
+{
+	char **outputs = malloc(sizeof(*outputs) * (batch->job_count + 1));
+
+	if (outputs == NULL)
+		FATAL_ERROR("Failed to allocate manifest outputs!\n");
+
+	for (int i = 0; i < batch->job_count; i++)
+		outputs[i] = batch->jobs[i].argv[2];
+
+	qsort(outputs, batch->job_count, sizeof(*outputs), compare_outputs);
+
+	for (int i = 1; i < batch->job_count; i++)
+		if (strcmp(outputs[i - 1], outputs[i]) == 0)
+			FATAL_ERROR("'%s' is the output of more than one conversion!\n", outputs[i]);
+
+	free(outputs);
+}
+
+static void make_directory(const char *path)
+{
+	if (mkdir(path, 0777) != 0)
+	{
+		struct stat st;
+
+		if (stat(path, &st) != 0 || !S_ISDIR(st.st_mode))
+			FATAL_ERROR("Failed to create cache directory '%s'!\n", path);
+	}
+}
+
+void handle_batch_command(int argc, char **argv, convert_function convert)
+{
+	struct batch batch;
+	struct timespec start_time, end_time;
+	int thread_count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	long size;
+
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+	memset(&batch, 0, sizeof(batch));
+	batch.convert = convert;
+
+	for (int i = 3; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+		{
+			thread_count = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-cache") == 0 && i + 1 < argc)
+		{
+			batch.cache_dir = argv[++i];
+		}
+		else
+		{
+			FATAL_ERROR("Unrecognized option '%s'!\n", argv[i]);
+		}
+	}
+
+	read_manifest(&batch, argv[2]);
+	check_outputs(&batch);
+
+	if (batch.cache_dir != NULL)
+	{
+		uint32_t version = BATCH_CACHE_VERSION;
+		unsigned char *tool = read_file_if_exists("/proc/self/exe", &size);
+
+		if (tool == NULL)
+			tool = read_file_if_exists(argv[0], &size);
+
+		batch.tool_key.a = 0xCBF29CE484222325ull;
+		batch.tool_key.b = 0x84222325CBF29CE4ull;
+		hash_field(&batch.tool_key, &version, sizeof(version));
+
+		if (tool != NULL)
+		{
+			hash_field(&batch.tool_key, tool, size);
+			free(tool);
+		}
+
+		make_directory(batch.cache_dir);
+	}
+
+	if (thread_count > batch.job_count)
+		thread_count = batch.job_count;
+	if (thread_count < 1)
+		thread_count = 1;
+
+	pthread_t *threads = malloc(sizeof(*threads) * thread_count);
+
+	if (threads == NULL)
+		FATAL_ERROR("Failed to allocate threads!\n");
+
+	pthread_mutex_init(&batch.mutex, NULL);
+
+	for (int i = 1; i < thread_count; i++)
+		if (pthread_create(&threads[i], NULL, batch_worker, &batch) != 0)
+			FATAL_ERROR("Failed to start thread!\n");
+
+	batch_worker(&batch);
+
+	for (int i = 1; i < thread_count; i++)
+		pthread_join(threads[i], NULL);
+
+	pthread_mutex_destroy(&batch.mutex);
+	free(threads);
+
+	clock_gettime(CLOCK_MONOTONIC, &end_time);
+
+	printf("aif2pcm: %d conversions, %d cache hits, %d cache misses, %d skipped in %.2fs\n",
+	       batch.job_count, batch.results[BATCH_CACHED], batch.results[BATCH_CONVERTED], batch.results[BATCH_SKIPPED],
+	       (end_time.tv_sec - start_time.tv_sec) + (end_time.tv_nsec - start_time.tv_nsec) / 1e9);
+}
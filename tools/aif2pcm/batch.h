@@ -0,0 +1,9 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+// Runs one conversion, given the same arguments as the command line.
+typedef void (*convert_function)(int argc, char **argv);
+
+void handle_batch_command(int argc, char **argv, convert_function convert);
+
+#endif // BATCH_H
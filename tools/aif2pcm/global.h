@@ -0,0 +1,27 @@
+#ifndef GLOBAL_H
+#define GLOBAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _MSC_VER
+
+#define FATAL_ERROR(format, ...)           \
+do                                         \
+{                                          \
+	fprintf(stderr, format, __VA_ARGS__);  \
+	exit(1);                               \
+} while (0)
+
+#else
+
+#define FATAL_ERROR(format, ...)            \
+do                                          \
+{                                           \
+	fprintf(stderr, format, ##__VA_ARGS__); \
+	exit(1);                                \
+} while (0)
+
+#endif // _MSC_VER
+
+#endif // GLOBAL_H
@@ -24,31 +24,13 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <limits.h>
+#include "global.h"
+#include "batch.h"
 
 /* extended.c */
 void ieee754_write_extended (double, uint8_t*);
 double ieee754_read_extended (uint8_t*);
 
-#ifdef _MSC_VER
-
-#define FATAL_ERROR(format, ...)           \
-do                                         \
-{                                          \
-	fprintf(stderr, format, __VA_ARGS__);  \
-	exit(1);                               \
-} while (0)
-
-#else
-
-#define FATAL_ERROR(format, ...)            \
-do                                          \
-{                                           \
-	fprintf(stderr, format, ##__VA_ARGS__); \
-	exit(1);                                \
-} while (0)
-
-#endif // _MSC_VER
-
 typedef struct {
 	unsigned long num_samples;
 	union {
@@ -882,16 +864,11 @@ void usage(void)
 {
 	fprintf(stderr, "Usage: aif2pcm bin_file [aif_file]\n");
 	fprintf(stderr, "       aif2pcm aif_file [bin_file] [--compress]\n");
+	fprintf(stderr, "       aif2pcm -batch manifest_file [-j threads] [-cache cache_dir]\n");
 }
 
-int main(int argc, char **argv)
+void convert_file(int argc, char **argv)
 {
-	if (argc < 2)
-	{
-		usage();
-		exit(1);
-	}
-
 	char *input_file = argv[1];
 	char *extension = get_file_extension(input_file);
 	char *output_file;
@@ -940,6 +917,24 @@ int main(int argc, char **argv)
 	{
 		FATAL_ERROR("Input file must be .aif or .bin: '%s'\n", input_file);
 	}
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 2 || (strcmp(argv[1], "-batch") == 0 && argc < 3))
+	{
+		usage();
+		exit(1);
+	}
+
+	if (strcmp(argv[1], "-batch") == 0)
+	{
+		handle_batch_command(argc, argv, convert_file);
+	}
+	else
+	{
+		convert_file(argc, argv);
+	}
 
 	return 0;
 }
@@ -0,0 +1,514 @@
+// Batch mode runs every conversion in a manifest in one process, on a pool of
+// threads. With a cache directory, it also keeps each output under a hash of
+// everything that goes into it, and copies unchanged conversions from the cache
+// instead of redoing them, even if their timestamps changed, like after a
+// branch switch.
+//
+//   gbagfx -batch MANIFEST_PATH [-j THREADS] [-cache CACHE_DIR]
+//
+// Each line of the manifest is one conversion, with the same arguments as on
+// the command line: INPUT_PATH OUTPUT_PATH [options...]. Blank lines and lines
+// starting with # are ignored. A conversion that reads another one's output
+// waits for it. Conversions whose input doesn't exist are skipped, so that a
+// manifest made with `make -n` can include files that make builds some other
+// way.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "global.h"
+#include "batch.h"
+#include "util.h"
+
+// Bump this if cached outputs need to be thrown away for some reason other
+// than gbagfx itself changing, which is already part of every key.
+#define BATCH_CACHE_VERSION 1
+
+enum BatchResult {
+	BATCH_CACHED,
+	BATCH_CONVERTED,
+	BATCH_SKIPPED,
+};
+
+struct BatchJob {
+	int argc;
+	char **argv;
+	int waitingOn;
+	int *dependents;
+	int dependentCount;
+};
+
+struct BatchOutput {
+	const char *path;
+	int jobIndex;
+};
+
+struct CacheKey {
+	uint64_t a;
+	uint64_t b;
+};
+
+struct Batch {
+	struct BatchJob *jobs;
+	int jobCount;
+	ConvertFunction convert;
+	char *cacheDir;
+	struct CacheKey toolKey;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	int *ready;
+	int readyCount;
+	int running;
+	int finished;
+	int results[3];
+};
+
+static unsigned char *ReadFileIfExists(const char *path, long *size)
+{
+	FILE *fp = fopen(path, "rb");
+
+	if (fp == NULL)
+		return NULL;
+
+	fseek(fp, 0, SEEK_END);
+	*size = ftell(fp);
+	rewind(fp);
+
+	unsigned char *buffer = malloc(*size + 1);
+
+	if (buffer == NULL)
+		FATAL_ERROR("Failed to allocate memory for reading \"%s\".\n", path);
+
+	if (*size != 0 && fread(buffer, *size, 1, fp) != 1)
+		FATAL_ERROR("Failed to read \"%s\".\n", path);
+
+	buffer[*size] = 0;
+	fclose(fp);
+	return buffer;
+}
+
+// Two 64-bit FNV-1a style hashes with different multipliers, so that a
+// collision would need to hit both.
+static void HashBytes(struct CacheKey *key, const void *data, size_t size)
+{
+	const unsigned char *bytes = data;
+
+	for (size_t i = 0; i < size; i++) {
+		key->a = (key->a ^ bytes[i]) * 0x100000001B3ull;
+		key->b = (key->b ^ bytes[i]) * 0x9E3779B97F4A7C15ull;
+	}
+}
+
+// Hashes the length first, so that adjacent fields can't run into each other.
+static void HashField(struct CacheKey *key, const void *data, size_t size)
+{
+	uint64_t length = size;
+
+	HashBytes(key, &length, sizeof(length));
+	HashBytes(key, data, size);
+}
+
+static void HashString(struct CacheKey *key, const char *s)
+{
+	HashField(key, s, strlen(s));
+}
+
+static const char *GetPathExtension(const char *path)
+{
+	const char *slash = strrchr(path, '/');
+	const char *dot = strrchr(path, '.');
+
+	return (dot != NULL && (slash == NULL || dot > slash)) ? dot : "";
+}
+
+// The key covers gbagfx itself, the input and output types, the options, and
+// the contents of the input and of any other files named in the options, like
+// palettes. It doesn't cover the paths, so identical files share an entry.
+static bool GetCacheKey(struct Batch *batch, struct BatchJob *job, struct CacheKey *key)
+{
+	long size;
+
+	*key = batch->toolKey;
+	HashString(key, GetPathExtension(job->argv[1]));
+	HashString(key, GetPathExtension(job->argv[2]));
+
+	for (int i = 1; i < job->argc; i++) {
+		unsigned char *contents;
+
+		if (i == 2)
+			continue;
+
+		if (i >= 3)
+			HashString(key, job->argv[i]);
+
+		contents = ReadFileIfExists(job->argv[i], &size);
+
+		if (contents == NULL) {
+			if (i == 1)
+				return false;
+
+			continue;
+		}
+
+		HashField(key, contents, size);
+		free(contents);
+	}
+
+	return true;
+}
+
+static char *GetCachePath(struct Batch *batch, struct CacheKey *key, const char *suffix)
+{
+	size_t size = strlen(batch->cacheDir) + 1 + 32 + strlen(suffix) + 1;
+	char *path = malloc(size);
+
+	if (path == NULL)
+		FATAL_ERROR("Failed to allocate cache path.\n");
+
+	snprintf(path, size, "%s/%016llx%016llx%s", batch->cacheDir,
+	         (unsigned long long)key->a, (unsigned long long)key->b, suffix);
+	return path;
+}
+
+// Writes to a temporary file first, so that another gbagfx reading the same
+// cache never sees half of an entry.
+static void StoreInCache(struct Batch *batch, struct CacheKey *key, struct BatchJob *job, int jobIndex)
+{
+	long size;
+	unsigned char *output = ReadFileIfExists(job->argv[2], &size);
+	char suffix[64];
+
+	if (output == NULL)
+		FATAL_ERROR("Conversion to \"%s\" didn't write it.\n", job->argv[2]);
+
+	snprintf(suffix, sizeof(suffix), ".%ld.%d.tmp", (long)getpid(), jobIndex);
+
+	char *tempPath = GetCachePath(batch, key, suffix);
+	char *path = GetCachePath(batch, key, "");
+	FILE *fp = fopen(tempPath, "wb");
+
+	if (fp != NULL) {
+		bool written = fwrite(output, 1, size, fp) == (size_t)size;
+
+		if (fclose(fp) != 0 || !written || rename(tempPath, path) != 0)
+			remove(tempPath);
+	}
+
+	free(tempPath);
+	free(path);
+	free(output);
+}
+
+static enum BatchResult RunBatchJob(struct Batch *batch, int jobIndex)
+{
+	struct BatchJob *job = &batch->jobs[jobIndex];
+	struct CacheKey key;
+	long size;
+
+	if (batch->cacheDir == NULL) {
+		if (access(job->argv[1], F_OK) != 0)
+			return BATCH_SKIPPED;
+
+		batch->convert(job->argc, job->argv);
+		return BATCH_CONVERTED;
+	}
+
+	if (!GetCacheKey(batch, job, &key))
+		return BATCH_SKIPPED;
+
+	char *path = GetCachePath(batch, &key, "");
+	unsigned char *cached = ReadFileIfExists(path, &size);
+
+	free(path);
+
+	if (cached != NULL) {
+		WriteWholeFile(job->argv[2], cached, size);
+		free(cached);
+		return BATCH_CACHED;
+	}
+
+	batch->convert(job->argc, job->argv);
+	StoreInCache(batch, &key, job, jobIndex);
+	return BATCH_CONVERTED;
+}
+
+static void *BatchWorker(void *arg)
+{
+	struct Batch *batch = arg;
+
+	pthread_mutex_lock(&batch->mutex);
+
+	for (;;) {
+		while (batch->readyCount == 0 && batch->finished < batch->jobCount) {
+			if (batch->running == 0)
+				FATAL_ERROR("The conversions in the manifest wait on each other in a cycle.\n");
+
+			pthread_cond_wait(&batch->cond, &batch->mutex);
+		}
+
+		if (batch->readyCount == 0)
+			break;
+
+		int jobIndex = batch->ready[--batch->readyCount];
+
+		batch->running++;
+		pthread_mutex_unlock(&batch->mutex);
+
+		enum BatchResult result = RunBatchJob(batch, jobIndex);
+		struct BatchJob *job = &batch->jobs[jobIndex];
+
+		pthread_mutex_lock(&batch->mutex);
+		batch->running--;
+		batch->finished++;
+		batch->results[result]++;
+
+		for (int i = 0; i < job->dependentCount; i++) {
+			struct BatchJob *dependent = &batch->jobs[job->dependents[i]];
+
+			if (--dependent->waitingOn == 0)
+				batch->ready[batch->readyCount++] = job->dependents[i];
+		}
+
+		pthread_cond_broadcast(&batch->cond);
+	}
+
+	pthread_mutex_unlock(&batch->mutex);
+	return NULL;
+}
+
+static int CompareOutputs(const void *a, const void *b)
+{
+	return strcmp(((const struct BatchOutput *)a)->path, ((const struct BatchOutput *)b)->path);
+}
+
+static void ReadManifest(struct Batch *batch, char *manifestPath)
+{
+	long size;
+	char *manifest = (char *)ReadFileIfExists(manifestPath, &size);
+	int lineNum = 0;
+	int capacity = 0;
+
+	if (manifest == NULL)
+		FATAL_ERROR("Failed to open \"%s\" for reading.\n", manifestPath);
+
+	batch->jobs = NULL;
+	batch->jobCount = 0;
+
+	for (char *line = manifest; line != NULL && *line != 0;) {
+		char *next = strchr(line, '\n');
+		int argc = 1;
+		char **argv;
+
+		if (next != NULL)
+			*next++ = 0;
+
+		lineNum++;
+
+		// The arguments point into the manifest, which is never freed.
+		argv = malloc(sizeof(*argv) * (strlen(line) / 2 + 3));
+
+		if (argv == NULL)
+			FATAL_ERROR("Failed to allocate manifest line.\n");
+
+		argv[0] = "gbagfx";
+
+		for (char *arg = strtok(line, " \t\r"); arg != NULL; arg = strtok(NULL, " \t\r"))
+			argv[argc++] = arg;
+
+		argv[argc] = NULL;
+		line = next;
+
+		if (argc == 1 || argv[1][0] == '#') {
+			free(argv);
+			continue;
+		}
+
+		if (argc < 3)
+			FATAL_ERROR("%s:%d: Expected an input path and an output path.\n", manifestPath, lineNum);
+
+		if (GetFileExtensionAfterDot(argv[2]) == NULL)
+			FATAL_ERROR("%s:%d: Output path \"%s\" has no extension.\n", manifestPath, lineNum, argv[2]);
+
+		if (batch->jobCount == capacity) {
+			capacity = capacity ? capacity * 2 : 256;
+			batch->jobs = realloc(batch->jobs, sizeof(*batch->jobs) * capacity);
+
+			if (batch->jobs == NULL)
+				FATAL_ERROR("Failed to allocate manifest.\n");
+		}
+
+		struct BatchJob *job = &batch->jobs[batch->jobCount++];
+
+		job->argc = argc;
+		job->argv = argv;
+		job->waitingOn = 0;
+		job->dependents = NULL;
+		job->dependentCount = 0;
+	}
+}
+
+// Makes each conversion wait on the ones that write its input or the other
+// files named in its options.
+static void FindDependencies(struct Batch *batch)
+{
+	struct BatchOutput *outputs = malloc(sizeof(*outputs) * (batch->jobCount + 1));
+
+	if (outputs == NULL)
+		FATAL_ERROR("Failed to allocate manifest outputs.\n");
+
+	for (int i = 0; i < batch->jobCount; i++) {
+		outputs[i].path = batch->jobs[i].argv[2];
+		outputs[i].jobIndex = i;
+	}
+
+	qsort(outputs, batch->jobCount, sizeof(*outputs), CompareOutputs);
+
+	for (int i = 1; i < batch->jobCount; i++)
+		if (strcmp(outputs[i - 1].path, outputs[i].path) == 0)
+			FATAL_ERROR("\"%s\" is the output of more than one conversion.\n", outputs[i].path);
+
+	for (int i = 0; i < batch->jobCount; i++) {
+		struct BatchJob *job = &batch->jobs[i];
+
+		for (int j = 1; j < job->argc; j++) {
+			struct BatchOutput search = { job->argv[j], 0 };
+			struct BatchOutput *found;
+
+			if (j == 2)
+				continue;
+
+			found = bsearch(&search, outputs, batch->jobCount, sizeof(*outputs), CompareOutputs);
+
+			if (found == NULL || found->jobIndex == i)
+				continue;
+
+			struct BatchJob *producer = &batch->jobs[found->jobIndex];
+
+			producer->dependents = realloc(producer->dependents, sizeof(int) * (producer->dependentCount + 1));
+
+			if (producer->dependents == NULL)
+				FATAL_ERROR("Failed to allocate manifest dependencies.\n");
+
+			producer->dependents[producer->dependentCount++] = i;
+			job->waitingOn++;
+		}
+	}
+
+	free(outputs);
+}
+
+static void MakeDirectory(const char *path)
+{
+	if (mkdir(path, 0777) != 0) {
+		struct stat st;
+
+		if (stat(path, &st) != 0 || !S_ISDIR(st.st_mode))
+			FATAL_ERROR("Failed to create cache directory \"%s\".\n", path);
+	}
+}
+
+void HandleBatchCommand(int argc, char **argv, ConvertFunction convert)
+{
+	struct Batch batch;
+	int threadCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	long size;
+
+	memset(&batch, 0, sizeof(batch));
+	batch.convert = convert;
+
+	for (int i = 3; i < argc; i++) {
+		char *option = argv[i];
+
+		if (strcmp(option, "-j") == 0) {
+			if (i + 1 >= argc)
+				FATAL_ERROR("No thread count following \"-j\".\n");
+
+			i++;
+
+			if (!ParseNumber(argv[i], NULL, 10, &threadCount))
+				FATAL_ERROR("Failed to parse thread count.\n");
+		} else if (strcmp(option, "-cache") == 0) {
+			if (i + 1 >= argc)
+				FATAL_ERROR("No directory following \"-cache\".\n");
+
+			i++;
+
+			batch.cacheDir = argv[i];
+		} else {
+			FATAL_ERROR("Unrecognized option \"%s\".\n", option);
+		}
+	}
+
+	if (threadCount < 1)
+		threadCount = 1;
+
+	ReadManifest(&batch, argv[2]);
+	FindDependencies(&batch);
+
+	if (batch.cacheDir != NULL) {
+		uint32_t version = BATCH_CACHE_VERSION;
+		unsigned char *tool = ReadFileIfExists("/proc/self/exe", &size);
+
+		if (tool == NULL)
+			tool = ReadFileIfExists(argv[0], &size);
+
+		batch.toolKey.a = 0xCBF29CE484222325ull;
+		batch.toolKey.b = 0x84222325CBF29CE4ull;
+		HashField(&batch.toolKey, &version, sizeof(version));
+
+		if (tool != NULL) {
+			HashField(&batch.toolKey, tool, size);
+			free(tool);
+		}
+
+		MakeDirectory(batch.cacheDir);
+	}
+
+	// The ready list is a stack, so push in reverse to start at the top of the
+	// manifest. Conversions that were waiting run as soon as they're ready,
+	// while their input is still in the disk cache.
+	batch.ready = malloc(sizeof(int) * (batch.jobCount + 1));
+
+	if (batch.ready == NULL)
+		FATAL_ERROR("Failed to allocate ready list.\n");
+
+	for (int i = batch.jobCount - 1; i >= 0; i--)
+		if (batch.jobs[i].waitingOn == 0)
+			batch.ready[batch.readyCount++] = i;
+
+	if (threadCount > batch.jobCount)
+		threadCount = batch.jobCount > 0 ? batch.jobCount : 1;
+
+	pthread_t *threads = malloc(sizeof(*threads) * threadCount);
+
+	if (threads == NULL)
+		FATAL_ERROR("Failed to allocate threads.\n");
+
+	pthread_mutex_init(&batch.mutex, NULL);
+	pthread_cond_init(&batch.cond, NULL);
+
+	for (int i = 1; i < threadCount; i++)
+		if (pthread_create(&threads[i], NULL, BatchWorker, &batch) != 0)
+			FATAL_ERROR("Failed to start thread.\n");
+
+	BatchWorker(&batch);
+
+	for (int i = 1; i < threadCount; i++)
+		pthread_join(threads[i], NULL);
+
+	pthread_mutex_destroy(&batch.mutex);
+	pthread_cond_destroy(&batch.cond);
+	free(threads);
+
+	printf("gbagfx: %d conversions, %d cache hits, %d cache misses, %d skipped\n",
+	       batch.jobCount,
+	       batch.results[BATCH_CACHED],
+	       batch.results[BATCH_CONVERTED],
+	       batch.results[BATCH_SKIPPED]);
+}
@@ -0,0 +1,9 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+// Runs one conversion, given the same arguments as the command line.
+typedef void (*ConvertFunction)(int argc, char **argv);
+
+void HandleBatchCommand(int argc, char **argv, ConvertFunction convert);
+
+#endif // BATCH_H
@@ -0,0 +1,294 @@
+// Fast LZ is an LZ format that works on whole words instead of bytes. It
+// compresses somewhat worse than LZ77, but the game can decompress it several
+// times faster, since every copy is a word copy and there are no flag bits to
+// test. It's meant for data that's decompressed while the player waits, like
+// Pokémon pics and tilesets. See FastLZDecompress in src/decompress_fast.c.
+//
+// Header, three little-endian words:
+//   FAST_LZ_TAG | (uncompressed size << 8)
+//   byte offset of the match distance stream
+//   byte offset of the literal stream
+// The token stream follows the header.
+//
+// Each token is (literal count << 4) | match length, both in words. A count of
+// 15 is followed by extra bytes in the token stream that are added to it, and
+// while an extra byte is 255 another one follows. The literals are copied from
+// the literal stream, then, if the match length isn't 0, a u16 distance in
+// words is read from the distance stream and the match is copied from that far
+// back in the output.
+
+#include <stdlib.h>
+#include <string.h>
+#include "global.h"
+#include "fastlz.h"
+
+#define FAST_LZ_HEADER_SIZE 12
+#define FAST_LZ_MAX_DISTANCE 0xFFFF
+#define FAST_LZ_HASH_BITS 12
+#define FAST_LZ_MAX_CHAIN 256
+
+// Costs in bytes, for the parse. A match costs its token and its distance,
+// a literal its word, since runs of literals share a token.
+#define FAST_LZ_LITERAL_COST 4
+#define FAST_LZ_MATCH_COST 3
+
+static unsigned int GetWord(const unsigned char *src)
+{
+	return src[0] | (src[1] << 8) | (src[2] << 16) | ((unsigned int)src[3] << 24);
+}
+
+static void PutWord(unsigned char *dest, unsigned int value)
+{
+	dest[0] = (unsigned char)value;
+	dest[1] = (unsigned char)(value >> 8);
+	dest[2] = (unsigned char)(value >> 16);
+	dest[3] = (unsigned char)(value >> 24);
+}
+
+static int ExtraCountBytes(int count)
+{
+	return count < 15 ? 0 : (count - 15) / 255 + 1;
+}
+
+static int PutExtraCount(unsigned char *dest, int destPos, int count)
+{
+	if (count < 15)
+		return destPos;
+
+	count -= 15;
+
+	while (count >= 255) {
+		dest[destPos++] = 255;
+		count -= 255;
+	}
+
+	dest[destPos++] = (unsigned char)count;
+	return destPos;
+}
+
+static int GetExtraCount(unsigned char *src, int srcSize, int *srcPos, int count)
+{
+	if (count < 15)
+		return count;
+
+	for (;;) {
+		if (*srcPos >= srcSize)
+			return -1;
+
+		int extra = src[(*srcPos)++];
+
+		count += extra;
+
+		if (extra != 255)
+			return count;
+	}
+}
+
+unsigned char *FastLZDecompress(unsigned char *src, int srcSize, int *uncompressedSize)
+{
+	if (srcSize < FAST_LZ_HEADER_SIZE || src[0] != FAST_LZ_TAG)
+		goto fail;
+
+	int destSize = (src[3] << 16) | (src[2] << 8) | src[1];
+	int distancePos = GetWord(src + 4);
+	int literalPos = GetWord(src + 8);
+
+	if ((destSize & 3) || (distancePos & 1) || (literalPos & 3) || literalPos > srcSize)
+		goto fail;
+
+	unsigned char *dest = malloc(destSize);
+
+	if (dest == NULL)
+		goto fail;
+
+	int tokenPos = FAST_LZ_HEADER_SIZE;
+	int destPos = 0;
+
+	while (destPos < destSize) {
+		if (tokenPos >= distancePos)
+			goto fail;
+
+		int token = src[tokenPos++];
+		int literals = GetExtraCount(src, distancePos, &tokenPos, token >> 4);
+		int length = GetExtraCount(src, distancePos, &tokenPos, token & 0xF);
+
+		if (literals < 0 || length < 0
+		 || destPos + (literals + length) * 4 > destSize
+		 || literalPos + literals * 4 > srcSize)
+			goto fail;
+
+		memcpy(&dest[destPos], &src[literalPos], literals * 4);
+		destPos += literals * 4;
+		literalPos += literals * 4;
+
+		if (length != 0) {
+			if (distancePos + 2 > srcSize)
+				goto fail;
+
+			int distance = (src[distancePos] | (src[distancePos + 1] << 8)) * 4;
+
+			distancePos += 2;
+
+			if (distance == 0 || distance > destPos)
+				goto fail;
+
+			for (int i = 0; i < length * 4; i++) {
+				dest[destPos] = dest[destPos - distance];
+				destPos++;
+			}
+		}
+	}
+
+	*uncompressedSize = destSize;
+	return dest;
+
+fail:
+	FATAL_ERROR("Fatal error while decompressing fast LZ file.\n");
+}
+
+unsigned char *FastLZCompress(unsigned char *src, int srcSize, int *compressedSize)
+{
+	if (srcSize & 3)
+		FATAL_ERROR("Fast LZ data must be a whole number of words, but it's %d bytes.\n", srcSize);
+
+	int wordCount = srcSize / 4;
+	unsigned int *words = malloc(sizeof(*words) * (wordCount + 1));
+	int *matchLengths = malloc(sizeof(*matchLengths) * (wordCount + 1));
+	int *matchDistances = malloc(sizeof(*matchDistances) * (wordCount + 1));
+	int *costs = malloc(sizeof(*costs) * (wordCount + 1));
+	int *choices = malloc(sizeof(*choices) * (wordCount + 1));
+	int *prev = malloc(sizeof(*prev) * (wordCount + 1));
+	int *head = malloc(sizeof(*head) * (1 << FAST_LZ_HASH_BITS));
+
+	if (words == NULL || matchLengths == NULL || matchDistances == NULL
+	 || costs == NULL || choices == NULL || prev == NULL || head == NULL)
+		FATAL_ERROR("Failed to allocate fast LZ match finder.\n");
+
+	for (int i = 0; i < wordCount; i++)
+		words[i] = GetWord(&src[i * 4]);
+
+	for (int i = 0; i < (1 << FAST_LZ_HASH_BITS); i++)
+		head[i] = -1;
+
+	// Find the longest match at every word, nearest first.
+	for (int i = 0; i < wordCount; i++) {
+		unsigned int hash = (words[i] * 2654435761u) >> (32 - FAST_LZ_HASH_BITS);
+		int bestLength = 0;
+		int bestDistance = 0;
+		int chain = 0;
+
+		for (int candidate = head[hash];
+		     candidate >= 0 && i - candidate <= FAST_LZ_MAX_DISTANCE && chain < FAST_LZ_MAX_CHAIN;
+		     candidate = prev[candidate], chain++) {
+			if (words[candidate] != words[i])
+				continue;
+
+			if (bestLength != 0 && words[candidate + bestLength] != words[i + bestLength])
+				continue;
+
+			int length = 1;
+
+			while (i + length < wordCount && words[candidate + length] == words[i + length])
+				length++;
+
+			if (length > bestLength) {
+				bestLength = length;
+				bestDistance = i - candidate;
+
+				if (i + length == wordCount)
+					break;
+			}
+		}
+
+		matchLengths[i] = bestLength;
+		matchDistances[i] = bestDistance;
+		prev[i] = head[hash];
+		head[hash] = i;
+	}
+
+	// Pick the cheapest way to encode each suffix of the data, preferring
+	// longer matches on ties since they decompress faster.
+	costs[wordCount] = 0;
+
+	for (int i = wordCount - 1; i >= 0; i--) {
+		costs[i] = costs[i + 1] + FAST_LZ_LITERAL_COST;
+		choices[i] = 0;
+
+		for (int length = matchLengths[i]; length > 0; length--) {
+			int cost = costs[i + length] + FAST_LZ_MATCH_COST + ExtraCountBytes(length);
+
+			if (cost < costs[i]) {
+				costs[i] = cost;
+				choices[i] = length;
+			}
+		}
+	}
+
+	// Every word can start a token, plus its extra count bytes.
+	int maxTokenSize = wordCount * 2 + wordCount / 255 + 2;
+	unsigned char *tokens = malloc(maxTokenSize);
+	unsigned char *distances = malloc(wordCount * 2 + 2);
+	unsigned char *literals = malloc(srcSize + 4);
+
+	if (tokens == NULL || distances == NULL || literals == NULL)
+		FATAL_ERROR("Failed to allocate fast LZ streams.\n");
+
+	int tokenSize = 0;
+	int distanceSize = 0;
+	int literalSize = 0;
+	int literalCount = 0;
+
+	for (int i = 0; i < wordCount;) {
+		int length = choices[i];
+
+		if (length == 0) {
+			PutWord(&literals[literalSize], words[i]);
+			literalSize += 4;
+			literalCount++;
+			i++;
+
+			if (i < wordCount)
+				continue;
+		}
+
+		tokens[tokenSize++] = ((literalCount < 15 ? literalCount : 15) << 4) | (length < 15 ? length : 15);
+		tokenSize = PutExtraCount(tokens, tokenSize, literalCount);
+		tokenSize = PutExtraCount(tokens, tokenSize, length);
+		literalCount = 0;
+
+		if (length != 0) {
+			distances[distanceSize++] = (unsigned char)matchDistances[i];
+			distances[distanceSize++] = (unsigned char)(matchDistances[i] >> 8);
+			i += length;
+		}
+	}
+
+	int distancePos = (FAST_LZ_HEADER_SIZE + tokenSize + 1) & ~1;
+	int literalPos = (distancePos + distanceSize + 3) & ~3;
+	int destSize = literalPos + literalSize;
+	unsigned char *dest = calloc(destSize, 1);
+
+	if (dest == NULL)
+		FATAL_ERROR("Failed to allocate fast LZ output.\n");
+
+	PutWord(&dest[0], FAST_LZ_TAG | (srcSize << 8));
+	PutWord(&dest[4], distancePos);
+	PutWord(&dest[8], literalPos);
+	memcpy(&dest[FAST_LZ_HEADER_SIZE], tokens, tokenSize);
+	memcpy(&dest[distancePos], distances, distanceSize);
+	memcpy(&dest[literalPos], literals, literalSize);
+
+	free(words);
+	free(matchLengths);
+	free(matchDistances);
+	free(costs);
+	free(choices);
+	free(prev);
+	free(head);
+	free(tokens);
+	free(distances);
+	free(literals);
+
+	*compressedSize = destSize;
+	return dest;
+}
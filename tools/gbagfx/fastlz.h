@@ -0,0 +1,10 @@
+#ifndef FASTLZ_H
+#define FASTLZ_H
+
+// The first byte of fast LZ data. LZ77 data starts with 0x10.
+#define FAST_LZ_TAG 0x50
+
+unsigned char *FastLZDecompress(unsigned char *src, int srcSize, int *uncompressedSize);
+unsigned char *FastLZCompress(unsigned char *src, int srcSize, int *compressedSize);
+
+#endif // FASTLZ_H
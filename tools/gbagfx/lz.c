@@ -69,7 +69,150 @@ fail:
 	FATAL_ERROR("Fatal error while decompressing LZ file.\n");
 }
 
-unsigned char *LZCompress(unsigned char *src, int srcSize, int *compressedSize, const int minDistance)
+// Matches are found with hash chains over the first three bytes. Each chain
+// is walked from the nearest position outwards, so the match chosen is the
+// same as what trying every distance in order would find.
+#define LZ_MIN_MATCH 3
+#define LZ_MAX_MATCH 18
+#define LZ_MAX_DISTANCE 0x1000
+#define LZ_HASH_BITS 14
+#define LZ_HASH_SIZE (1 << LZ_HASH_BITS)
+
+// Cost of a token in bits, including its flag bit.
+#define LZ_LITERAL_COST 9
+#define LZ_MATCH_COST 17
+
+struct LZMatchFinder {
+	unsigned char *src;
+	int srcSize;
+	int minDistance;
+	int *head;
+	int *prev;
+	int inserted;
+};
+
+static int LZHash(unsigned char *p)
+{
+	unsigned int value = (p[0] << 16) | (p[1] << 8) | p[2];
+
+	return (value * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+static void InitLZMatchFinder(struct LZMatchFinder *finder, unsigned char *src, int srcSize, int minDistance)
+{
+	finder->src = src;
+	finder->srcSize = srcSize;
+	finder->minDistance = minDistance;
+	finder->head = malloc(LZ_HASH_SIZE * sizeof(int));
+	finder->prev = malloc(srcSize * sizeof(int));
+	finder->inserted = 0;
+
+	if (finder->head == NULL || finder->prev == NULL)
+		FATAL_ERROR("Failed to allocate LZ match finder.\n");
+
+	for (int i = 0; i < LZ_HASH_SIZE; i++)
+		finder->head[i] = -1;
+}
+
+static void FreeLZMatchFinder(struct LZMatchFinder *finder)
+{
+	free(finder->head);
+	free(finder->prev);
+}
+
+// Returns the length of the longest match at srcPos, and the nearest distance
+// it occurs at. Positions must be asked for in increasing order.
+static int FindLZMatch(struct LZMatchFinder *finder, int srcPos, int *distance)
+{
+	unsigned char *src = finder->src;
+	int srcSize = finder->srcSize;
+	int bestSize = 0;
+
+	for (; finder->inserted < srcPos; finder->inserted++) {
+		int pos = finder->inserted;
+
+		if (pos + LZ_MIN_MATCH <= srcSize) {
+			int hash = LZHash(&src[pos]);
+
+			finder->prev[pos] = finder->head[hash];
+			finder->head[hash] = pos;
+		}
+	}
+
+	if (srcPos + LZ_MIN_MATCH > srcSize)
+		return 0;
+
+	for (int pos = finder->head[LZHash(&src[srcPos])]; pos >= 0; pos = finder->prev[pos]) {
+		int blockDistance = srcPos - pos;
+		int blockSize = 0;
+
+		if (blockDistance > LZ_MAX_DISTANCE)
+			break;
+
+		if (blockDistance < finder->minDistance)
+			continue;
+
+		// Can't be longer than the best match so far.
+		if (bestSize > 0 && (srcPos + bestSize >= srcSize || src[pos + bestSize] != src[srcPos + bestSize]))
+			continue;
+
+		while (blockSize < LZ_MAX_MATCH
+		    && srcPos + blockSize < srcSize
+		    && src[pos + blockSize] == src[srcPos + blockSize])
+			blockSize++;
+
+		if (blockSize > bestSize) {
+			bestSize = blockSize;
+			*distance = blockDistance;
+
+			if (blockSize == LZ_MAX_MATCH)
+				break;
+		}
+	}
+
+	return bestSize;
+}
+
+// Picks the tokens that give the smallest output, by finding the cheapest
+// path from the end of the data back to the start. A match can be shortened
+// to any length of at least three at the same distance.
+static void ParseLZOptimal(struct LZMatchFinder *finder, int *tokenSizes, int *tokenDistances)
+{
+	int srcSize = finder->srcSize;
+	int *matchSizes = malloc(srcSize * sizeof(int));
+	int *matchDistances = malloc(srcSize * sizeof(int));
+	int *costs = malloc((srcSize + 1) * sizeof(int));
+
+	if (matchSizes == NULL || matchDistances == NULL || costs == NULL)
+		FATAL_ERROR("Failed to allocate LZ parse.\n");
+
+	for (int i = 0; i < srcSize; i++)
+		matchSizes[i] = FindLZMatch(finder, i, &matchDistances[i]);
+
+	costs[srcSize] = 0;
+
+	for (int i = srcSize - 1; i >= 0; i--) {
+		costs[i] = LZ_LITERAL_COST + costs[i + 1];
+		tokenSizes[i] = 1;
+
+		for (int size = LZ_MIN_MATCH; size <= matchSizes[i]; size++) {
+			int cost = LZ_MATCH_COST + costs[i + size];
+
+			// Prefer longer matches on ties, it's fewer tokens to decode.
+			if (cost <= costs[i]) {
+				costs[i] = cost;
+				tokenSizes[i] = size;
+				tokenDistances[i] = matchDistances[i];
+			}
+		}
+	}
+
+	free(matchSizes);
+	free(matchDistances);
+	free(costs);
+}
+
+unsigned char *LZCompress(unsigned char *src, int srcSize, int *compressedSize, const int minDistance, const bool optimal)
 {
 	if (srcSize <= 0)
 		goto fail;
@@ -90,64 +233,65 @@ unsigned char *LZCompress(unsigned char *src, int srcSize, int *compressedSize,
 	dest[2] = (unsigned char)(srcSize >> 8);
 	dest[3] = (unsigned char)(srcSize >> 16);
 
-	int srcPos = 0;
-	int destPos = 4;
-
-	for (;;) {
-		unsigned char *flags = &dest[destPos++];
-		*flags = 0;
-
-		for (int i = 0; i < 8; i++) {
-			int bestBlockDistance = 0;
-			int bestBlockSize = 0;
-			int blockDistance = minDistance;
+	struct LZMatchFinder finder;
+	int *tokenSizes = NULL;
+	int *tokenDistances = NULL;
 
-			while (blockDistance <= srcPos && blockDistance <= 0x1000) {
-				int blockStart = srcPos - blockDistance;
-				int blockSize = 0;
+	InitLZMatchFinder(&finder, src, srcSize, minDistance);
 
-				while (blockSize < 18
-				    && srcPos + blockSize < srcSize
-				    && src[blockStart + blockSize] == src[srcPos + blockSize])
-					blockSize++;
+	if (optimal) {
+		tokenSizes = malloc(srcSize * sizeof(int));
+		tokenDistances = malloc(srcSize * sizeof(int));
 
-				if (blockSize > bestBlockSize) {
-					bestBlockDistance = blockDistance;
-					bestBlockSize = blockSize;
+		if (tokenSizes == NULL || tokenDistances == NULL)
+			goto fail;
 
-					if (blockSize == 18)
-						break;
-				}
+		ParseLZOptimal(&finder, tokenSizes, tokenDistances);
+	}
 
-				blockDistance++;
-			}
+	int srcPos = 0;
+	int destPos = 4;
+	unsigned char *flags = NULL;
 
-			if (bestBlockSize >= 3) {
-				*flags |= (0x80 >> i);
-				srcPos += bestBlockSize;
-				bestBlockSize -= 3;
-				bestBlockDistance--;
-				dest[destPos++] = (bestBlockSize << 4) | ((unsigned int)bestBlockDistance >> 8);
-				dest[destPos++] = (unsigned char)bestBlockDistance;
-			} else {
-				dest[destPos++] = src[srcPos++];
-			}
+	for (int i = 0; srcPos < srcSize; i = (i + 1) % 8) {
+		int blockDistance = 0;
+		int blockSize;
 
-			if (srcPos == srcSize) {
-				// Pad to multiple of 4 bytes.
-				int remainder = destPos % 4;
+		if (i == 0) {
+			flags = &dest[destPos++];
+			*flags = 0;
+		}
 
-				if (remainder != 0) {
-					for (int i = 0; i < 4 - remainder; i++)
-						dest[destPos++] = 0;
-				}
+		if (optimal) {
+			blockSize = tokenSizes[srcPos];
+			blockDistance = tokenDistances[srcPos];
+		} else {
+			blockSize = FindLZMatch(&finder, srcPos, &blockDistance);
+		}
 
-				*compressedSize = destPos;
-				return dest;
-			}
+		if (blockSize >= LZ_MIN_MATCH) {
+			*flags |= (0x80 >> i);
+			srcPos += blockSize;
+			blockSize -= 3;
+			blockDistance--;
+			dest[destPos++] = (blockSize << 4) | ((unsigned int)blockDistance >> 8);
+			dest[destPos++] = (unsigned char)blockDistance;
+		} else {
+			dest[destPos++] = src[srcPos++];
 		}
 	}
 
+	// Pad to multiple of 4 bytes.
+	while (destPos % 4 != 0)
+		dest[destPos++] = 0;
+
+	FreeLZMatchFinder(&finder);
+	free(tokenSizes);
+	free(tokenDistances);
+
+	*compressedSize = destPos;
+	return dest;
+
 fail:
 	FATAL_ERROR("Fatal error while compressing LZ file.\n");
 }
@@ -0,0 +1,197 @@
+// Compresses every file given on the command line with the old brute-force
+// greedy search, the hash-chain greedy search, the optimal parse, and fast LZ.
+// Reports the total time and size for each, and checks that every result
+// decompresses back to the input. Fast LZ only takes whole words, so files
+// that aren't are counted for the LZ77 searches only.
+//
+//   make lz_benchmark
+//   find ../../graphics -name '*.4bpp' -o -name '*.gbapal' | xargs ./lz_benchmark
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "global.h"
+#include "lz.h"
+#include "fastlz.h"
+#include "util.h"
+
+struct LZBenchmark {
+	const char *name;
+	double seconds;
+	long long bytes;
+};
+
+// LZCompress as it was before hash chains, for comparison.
+static unsigned char *LZCompressBruteForce(unsigned char *src, int srcSize, int *compressedSize, const int minDistance)
+{
+	int worstCaseDestSize = (4 + srcSize + ((srcSize + 7) / 8) + 3) & ~3;
+	unsigned char *dest = malloc(worstCaseDestSize);
+
+	if (dest == NULL)
+		FATAL_ERROR("Failed to allocate LZ output.\n");
+
+	dest[0] = 0x10;
+	dest[1] = (unsigned char)srcSize;
+	dest[2] = (unsigned char)(srcSize >> 8);
+	dest[3] = (unsigned char)(srcSize >> 16);
+
+	int srcPos = 0;
+	int destPos = 4;
+
+	for (;;) {
+		unsigned char *flags = &dest[destPos++];
+		*flags = 0;
+
+		for (int i = 0; i < 8; i++) {
+			int bestBlockDistance = 0;
+			int bestBlockSize = 0;
+			int blockDistance = minDistance;
+
+			while (blockDistance <= srcPos && blockDistance <= 0x1000) {
+				int blockStart = srcPos - blockDistance;
+				int blockSize = 0;
+
+				while (blockSize < 18
+				    && srcPos + blockSize < srcSize
+				    && src[blockStart + blockSize] == src[srcPos + blockSize])
+					blockSize++;
+
+				if (blockSize > bestBlockSize) {
+					bestBlockDistance = blockDistance;
+					bestBlockSize = blockSize;
+
+					if (blockSize == 18)
+						break;
+				}
+
+				blockDistance++;
+			}
+
+			if (bestBlockSize >= 3) {
+				*flags |= (0x80 >> i);
+				srcPos += bestBlockSize;
+				bestBlockSize -= 3;
+				bestBlockDistance--;
+				dest[destPos++] = (bestBlockSize << 4) | ((unsigned int)bestBlockDistance >> 8);
+				dest[destPos++] = (unsigned char)bestBlockDistance;
+			} else {
+				dest[destPos++] = src[srcPos++];
+			}
+
+			if (srcPos == srcSize) {
+				while (destPos % 4 != 0)
+					dest[destPos++] = 0;
+
+				*compressedSize = destPos;
+				return dest;
+			}
+		}
+	}
+}
+
+static double Now(void)
+{
+	return (double)clock() / CLOCKS_PER_SEC;
+}
+
+static void CheckRoundTrip(const char *path, const char *name, unsigned char *src, int srcSize, unsigned char *compressed, int compressedSize)
+{
+	int uncompressedSize;
+	unsigned char *uncompressed;
+
+	if (compressed[0] == FAST_LZ_TAG)
+		uncompressed = FastLZDecompress(compressed, compressedSize, &uncompressedSize);
+	else
+		uncompressed = LZDecompress(compressed, compressedSize, &uncompressedSize);
+
+	if (uncompressedSize != srcSize || memcmp(uncompressed, src, srcSize) != 0)
+		FATAL_ERROR("%s: %s output doesn't decompress to the input.\n", path, name);
+
+	free(uncompressed);
+}
+
+int main(int argc, char **argv)
+{
+	struct LZBenchmark benchmarks[] = {
+		{ "brute force", 0, 0 },
+		{ "hash chain", 0, 0 },
+		{ "optimal", 0, 0 },
+		{ "fast", 0, 0 },
+	};
+	long long inputBytes = 0;
+	long long fastInputBytes = 0;
+	long long fastLZ77Bytes = 0;
+	int files = 0;
+
+	if (argc < 2)
+		FATAL_ERROR("Usage: lz_benchmark FILE...\n");
+
+	for (int i = 1; i < argc; i++) {
+		int srcSize;
+		unsigned char *src = ReadWholeFile(argv[i], &srcSize);
+		unsigned char *outputs[4];
+		int outputSizes[4];
+		double start;
+
+		if (srcSize == 0) {
+			free(src);
+			continue;
+		}
+
+		start = Now();
+		outputs[0] = LZCompressBruteForce(src, srcSize, &outputSizes[0], 2);
+		benchmarks[0].seconds += Now() - start;
+
+		start = Now();
+		outputs[1] = LZCompress(src, srcSize, &outputSizes[1], 2, false);
+		benchmarks[1].seconds += Now() - start;
+
+		start = Now();
+		outputs[2] = LZCompress(src, srcSize, &outputSizes[2], 2, true);
+		benchmarks[2].seconds += Now() - start;
+
+		if (outputSizes[0] != outputSizes[1] || memcmp(outputs[0], outputs[1], outputSizes[0]) != 0)
+			FATAL_ERROR("%s: hash chain output differs from brute force.\n", argv[i]);
+
+		if (srcSize % 4 == 0) {
+			start = Now();
+			outputs[3] = FastLZCompress(src, srcSize, &outputSizes[3]);
+			benchmarks[3].seconds += Now() - start;
+
+			CheckRoundTrip(argv[i], benchmarks[3].name, src, srcSize, outputs[3], outputSizes[3]);
+			benchmarks[3].bytes += outputSizes[3];
+			fastInputBytes += srcSize;
+			fastLZ77Bytes += outputSizes[2];
+			free(outputs[3]);
+		}
+
+		for (int j = 0; j < 3; j++) {
+			CheckRoundTrip(argv[i], benchmarks[j].name, src, srcSize, outputs[j], outputSizes[j]);
+			benchmarks[j].bytes += outputSizes[j];
+			free(outputs[j]);
+		}
+
+		inputBytes += srcSize;
+		files++;
+		free(src);
+	}
+
+	printf("%d files, %lld bytes\n", files, inputBytes);
+
+	for (int j = 0; j < 3; j++)
+		printf("%-12s %8.3f s %10lld bytes (%.2f%%)\n",
+		       benchmarks[j].name,
+		       benchmarks[j].seconds,
+		       benchmarks[j].bytes,
+		       100.0 * benchmarks[j].bytes / benchmarks[0].bytes);
+
+	if (fastInputBytes != 0)
+		printf("%-12s %8.3f s %10lld bytes (%.2f%% of optimal LZ77 for the same %lld bytes)\n",
+		       benchmarks[3].name,
+		       benchmarks[3].seconds,
+		       benchmarks[3].bytes,
+		       100.0 * benchmarks[3].bytes / fastLZ77Bytes,
+		       fastInputBytes);
+
+	return 0;
+}
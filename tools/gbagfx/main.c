@@ -10,9 +10,11 @@
 #include "convert_png.h"
 #include "jasc_pal.h"
 #include "lz.h"
+#include "fastlz.h"
 #include "rl.h"
 #include "font.h"
 #include "huff.h"
+#include "batch.h"
 
 struct CommandHandler
 {
@@ -426,6 +428,8 @@ void HandleLZCompressCommand(char *inputPath, char *outputPath, int argc, char *
 {
     int overflowSize = 0;
     int minDistance = 2; // default, for compatibility with LZ77UnCompVram()
+    bool optimal = false;
+    bool fast = false;
 
     for (int i = 3; i < argc; i++)
     {
@@ -457,6 +461,14 @@ void HandleLZCompressCommand(char *inputPath, char *outputPath, int argc, char *
             if (minDistance < 1)
                 FATAL_ERROR("LZ min search distance must be positive.\n");
         }
+        else if (strcmp(option, "-optimal") == 0)
+        {
+            optimal = true;
+        }
+        else if (strcmp(option, "-fast") == 0)
+        {
+            fast = true;
+        }
         else
         {
             FATAL_ERROR("Unrecognized option \"%s\".\n", option);
@@ -469,11 +481,26 @@ void HandleLZCompressCommand(char *inputPath, char *outputPath, int argc, char *
     // reflect the expected size. This will cause an overflow when decompressing
     // the data.
 
+    if (fast && (overflowSize != 0 || minDistance != 2))
+        FATAL_ERROR("\"-fast\" can't be combined with \"-overflow\" or \"-search\".\n");
+
     int fileSize;
     unsigned char *buffer = ReadWholeFileZeroPadded(inputPath, &fileSize, overflowSize);
 
+    if (fast)
+    {
+        // Fast LZ data is always optimally parsed.
+        int compressedSize;
+        unsigned char *compressedData = FastLZCompress(buffer, fileSize, &compressedSize);
+
+        free(buffer);
+        WriteWholeFile(outputPath, compressedData, compressedSize);
+        free(compressedData);
+        return;
+    }
+
     int compressedSize;
-    unsigned char *compressedData = LZCompress(buffer, fileSize + overflowSize, &compressedSize, minDistance);
+    unsigned char *compressedData = LZCompress(buffer, fileSize + overflowSize, &compressedSize, minDistance, optimal);
 
     compressedData[1] = (unsigned char)fileSize;
     compressedData[2] = (unsigned char)(fileSize >> 8);
@@ -492,7 +519,12 @@ void HandleLZDecompressCommand(char *inputPath, char *outputPath, int argc UNUSE
     unsigned char *buffer = ReadWholeFile(inputPath, &fileSize);
 
     int uncompressedSize;
-    unsigned char *uncompressedData = LZDecompress(buffer, fileSize, &uncompressedSize);
+    unsigned char *uncompressedData;
+
+    if (fileSize > 0 && buffer[0] == FAST_LZ_TAG)
+        uncompressedData = FastLZDecompress(buffer, fileSize, &uncompressedSize);
+    else
+        uncompressedData = LZDecompress(buffer, fileSize, &uncompressedSize);
 
     free(buffer);
 
@@ -586,13 +618,10 @@ void HandleHuffDecompressCommand(char *inputPath, char *outputPath, int argc UNU
     free(uncompressedData);
 }
 
-int main(int argc, char **argv)
+static void ConvertFile(int argc, char **argv)
 {
     char converted = 0;
 
-    if (argc < 3)
-        FATAL_ERROR("Usage: gbagfx INPUT_PATH OUTPUT_PATH [options...]\n");
-
     struct CommandHandler handlers[] =
     {
         { "1bpp", "png", HandleGbaToPngCommand },
@@ -613,6 +642,7 @@ int main(int argc, char **argv)
         { "png", "fwjpnfont", HandlePngToFullwidthJapaneseFontCommand },
         { NULL, "huff", HandleHuffCompressCommand },
         { NULL, "lz", HandleLZCompressCommand },
+        { NULL, "lz77", HandleLZCompressCommand },
         { "huff", NULL, HandleHuffDecompressCommand },
         { "lz", NULL, HandleLZDecompressCommand },
         { NULL, "rl", HandleRLCompressCommand },
@@ -672,6 +702,18 @@ int main(int argc, char **argv)
 
     if (!converted)
         FATAL_ERROR("Don't know how to convert \"%s\" to \"%s\".\n", argv[1], argv[2]);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+        FATAL_ERROR("Usage: gbagfx INPUT_PATH OUTPUT_PATH [options...]\n"
+                    "       gbagfx -batch MANIFEST_PATH [-j THREADS] [-cache CACHE_DIR]\n");
+
+    if (strcmp(argv[1], "-batch") == 0)
+        HandleBatchCommand(argc, argv, ConvertFile);
+    else
+        ConvertFile(argc, argv);
 
     return 0;
 }
@@ -7,6 +7,24 @@
 #include <string>
 using std::string; using std::to_string;
 
+#include <vector>
+using std::vector;
+
+#include <atomic>
+using std::atomic;
+
+#include <thread>
+using std::thread;
+
+#include <fstream>
+using std::ifstream; using std::ofstream;
+
+#include <iostream>
+using std::cin; using std::cout;
+
+#include <sstream>
+using std::istringstream; using std::ostringstream;
+
 #include <algorithm>
 using std::replace_if;
 
@@ -14,7 +32,10 @@ using std::replace_if;
 using namespace inja;
 using json = nlohmann::json;
 
-std::map<string, string> customVars;
+// Each thread renders one output at a time, so these are per thread.
+thread_local std::map<string, string> customVars;
+thread_local string currentJsonFilepath;
+thread_local string currentTemplateFilepath;
 
 void set_custom_var(string key, string value)
 {
@@ -26,21 +47,20 @@ string get_custom_var(string key)
     return customVars[key];
 }
 
-int main(int argc, char *argv[])
+struct Job
 {
-    if (argc != 4)
-        FATAL_ERROR("USAGE: jsonproc <json-filepath> <template-filepath> <output-filepath>\n");
-
-    string jsonfilepath = argv[1];
-    string templateFilepath = argv[2];
-    string outputFilepath = argv[3];
-
-    Environment env;
-    env.set_trim_blocks(true);
+    string jsonFilepath;
+    string templateFilepath;
+    string outputFilepath;
+};
 
+void add_callbacks(Environment& env)
+{
     // Add custom command callbacks.
-    env.add_callback("doNotModifyHeader", 0, [jsonfilepath, templateFilepath](Arguments& args) {
-        return "//\n// DO NOT MODIFY THIS FILE! It is auto-generated from " + jsonfilepath +" and Inja template " + templateFilepath + "\n//\n";
+    // Callbacks are bound when a template is parsed, so this reads the paths
+    // of whatever is being rendered instead of capturing them.
+    env.add_callback("doNotModifyHeader", 0, [](Arguments& args) {
+        return "//\n// DO NOT MODIFY THIS FILE! It is auto-generated from " + currentJsonFilepath +" and Inja template " + currentTemplateFilepath + "\n//\n";
     });
 
     env.add_callback("subtract", 2, [](Arguments& args) {
@@ -117,15 +137,166 @@ int main(int argc, char *argv[])
         }
         return str;
     });
+}
+
+// Leaves the file alone if it already has this text, so that make doesn't
+// rebuild what depends on it.
+bool write_text_file_if_changed(string filepath, const string& text)
+{
+    ifstream inFile(filepath, std::ifstream::binary);
+
+    if (inFile.is_open())
+    {
+        ostringstream oldText;
+        oldText << inFile.rdbuf();
+        if (oldText.str() == text)
+            return false;
+        inFile.close();
+    }
+
+    string tempFilepath = filepath + ".tmp";
+    ofstream outFile(tempFilepath, std::ofstream::binary);
+
+    if (!outFile.is_open())
+        FATAL_ERROR("Cannot open file %s for writing.\n", tempFilepath.c_str());
+
+    outFile << text;
+    outFile.close();
+
+    if (outFile.fail())
+        FATAL_ERROR("Failed to write %s.\n", tempFilepath.c_str());
+
+    std::remove(filepath.c_str());
+
+    if (std::rename(tempFilepath.c_str(), filepath.c_str()) != 0)
+        FATAL_ERROR("Failed to rename %s to %s.\n", tempFilepath.c_str(), filepath.c_str());
+
+    return true;
+}
+
+// Reads lines of "<json-filepath> <template-filepath> <output-filepath>".
+// Blank lines and lines starting with # are skipped. "-" reads stdin.
+vector<Job> read_manifest(string manifestFilepath)
+{
+    ifstream manifestFile;
+    std::istream *in = &cin;
+
+    if (manifestFilepath != "-")
+    {
+        manifestFile.open(manifestFilepath);
+        if (!manifestFile.is_open())
+            FATAL_ERROR("Cannot open file %s for reading.\n", manifestFilepath.c_str());
+        in = &manifestFile;
+    }
+
+    vector<Job> jobs;
+    string line;
+    int lineNum = 0;
+
+    while (std::getline(*in, line))
+    {
+        lineNum++;
+
+        istringstream fields(line);
+        Job job;
+        string extra;
+
+        if (!(fields >> job.jsonFilepath) || job.jsonFilepath[0] == '#')
+            continue;
+        if (!(fields >> job.templateFilepath >> job.outputFilepath) || (fields >> extra))
+            FATAL_ERROR("%s:%d: expected <json-filepath> <template-filepath> <output-filepath>\n", manifestFilepath.c_str(), lineNum);
+
+        jobs.push_back(job);
+    }
+
+    return jobs;
+}
+
+// Renders every job in one run. Each JSON file and template is only parsed
+// once, however many outputs use it, and the outputs are rendered on
+// separate threads.
+void process_jobs(const vector<Job>& jobs, unsigned numThreads)
+{
+    Environment env;
+    env.set_trim_blocks(true);
+    add_callbacks(env);
+
+    std::map<string, json> jsonData;
+    std::map<string, Template> templates;
 
     try
     {
-        env.write_with_json_file(templateFilepath, jsonfilepath, outputFilepath);
+        for (const Job& job : jobs)
+        {
+            if (jsonData.find(job.jsonFilepath) == jsonData.end())
+                jsonData[job.jsonFilepath] = env.load_json(job.jsonFilepath);
+            if (templates.find(job.templateFilepath) == templates.end())
+                templates.emplace(job.templateFilepath, env.parse_template(job.templateFilepath));
+        }
     }
     catch (const std::exception& e)
     {
         FATAL_ERROR("JSONPROC_ERROR: %s\n", e.what());
     }
 
+    atomic<size_t> nextJob(0);
+    atomic<int> numWritten(0);
+
+    auto process_next_jobs = [&]() {
+        size_t i;
+        while ((i = nextJob++) < jobs.size())
+        {
+            const Job& job = jobs[i];
+            string output;
+
+            customVars.clear();
+            currentJsonFilepath = job.jsonFilepath;
+            currentTemplateFilepath = job.templateFilepath;
+
+            try
+            {
+                output = env.render(templates.at(job.templateFilepath), jsonData.at(job.jsonFilepath));
+            }
+            catch (const std::exception& e)
+            {
+                FATAL_ERROR("JSONPROC_ERROR: %s: %s\n", job.outputFilepath.c_str(), e.what());
+            }
+
+            numWritten += write_text_file_if_changed(job.outputFilepath, output);
+        }
+    };
+
+    vector<thread> threads;
+    for (unsigned i = 1; i < numThreads && i < jobs.size(); i++)
+        threads.push_back(thread(process_next_jobs));
+    process_next_jobs();
+    for (thread &t : threads)
+        t.join();
+
+    if (jobs.size() > 1)
+        cout << "jsonproc: " << jobs.size() << " outputs, wrote " << numWritten << "\n";
+}
+
+int main(int argc, char *argv[])
+{
+    const char *usage = "USAGE: jsonproc <json-filepath> <template-filepath> <output-filepath>\n"
+                        "       jsonproc -manifest <manifest-filepath> [-j <threads>]\n";
+
+    if (argc > 1 && string(argv[1]) == "-manifest")
+    {
+        unsigned numThreads = thread::hardware_concurrency();
+
+        if (argc != 3 && !(argc == 5 && string(argv[3]) == "-j" && (numThreads = std::atoi(argv[4])) != 0))
+            FATAL_ERROR("%s", usage);
+
+        process_jobs(read_manifest(argv[2]), numThreads ? numThreads : 1);
+        return 0;
+    }
+
+    if (argc != 4)
+        FATAL_ERROR("%s", usage);
+
+    process_jobs({ { argv[1], argv[2], argv[3] } }, 1);
+
     return 0;
 }
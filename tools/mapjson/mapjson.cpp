@@ -24,6 +24,12 @@ using std::ostringstream;
 #include <limits>
 using std::numeric_limits;
 
+#include <atomic>
+using std::atomic;
+
+#include <thread>
+using std::thread;
+
 #include "json11.h"
 using json11::Json;
 
@@ -61,6 +67,22 @@ void write_text_file(string filepath, string text) {
     out_file.close();
 }
 
+// Leaves the file alone if it already has this text, so that make doesn't
+// rebuild what depends on it.
+bool write_text_file_if_changed(string filepath, string text) {
+    ifstream in_file(filepath, std::ifstream::binary);
+
+    if (in_file.is_open()) {
+        ostringstream old_text;
+        old_text << in_file.rdbuf();
+        if (old_text.str() == text)
+            return false;
+    }
+
+    write_text_file(filepath, text);
+    return true;
+}
+
 
 string json_to_string(const Json &data, const string &field = "", bool silent = false) {
     const Json value = !field.empty() ? data[field] : data;
@@ -94,7 +116,7 @@ string json_to_string(const Json &data, const string &field = "", bool silent =
     return output;
 }
 
-string generate_map_header_text(Json map_data, Json layouts_data) {
+Json find_map_layout(Json map_data, Json layouts_data) {
     string map_layout_id = json_to_string(map_data, "layout");
 
     vector<Json> matched;
@@ -107,8 +129,10 @@ string generate_map_header_text(Json map_data, Json layouts_data) {
     if (matched.size() != 1)
         FATAL_ERROR("Failed to find matching layout for %s.\n", map_layout_id.c_str());
 
-    Json layout = matched[0];
+    return matched[0];
+}
 
+string generate_map_header_text(Json map_data, Json layout) {
     ostringstream text;
 
     string mapName = json_to_string(map_data, "name");
@@ -350,7 +374,7 @@ void process_map(string map_filepath, string layouts_filepath) {
     if (layouts_data == Json())
         FATAL_ERROR("%s\n", layouts_err.c_str());
 
-    string header_text = generate_map_header_text(map_data, layouts_data);
+    string header_text = generate_map_header_text(map_data, find_map_layout(map_data, layouts_data));
     string events_text = generate_map_events_text(map_data);
     string connections_text = generate_map_connections_text(map_data);
 
@@ -360,6 +384,59 @@ void process_map(string map_filepath, string layouts_filepath) {
     write_text_file(files_dir + "connections.inc", connections_text);
 }
 
+// Like process_map for every map at once, so layouts.json is only read once.
+// Maps are spread across threads, and files that wouldn't change aren't written.
+void process_maps(vector<string> map_filepaths, string layouts_filepath, unsigned num_threads) {
+    string layouts_err;
+
+    Json layouts_data = Json::parse(read_text_file(layouts_filepath), layouts_err);
+    if (layouts_data == Json())
+        FATAL_ERROR("%s\n", layouts_err.c_str());
+
+    // Layouts by id. An id that's used more than once maps to null, to fail
+    // the same way find_map_layout does.
+    map<string, Json> layouts_by_id;
+    for (auto &layout : layouts_data["layouts"].array_items()) {
+        string id = json_to_string(layout, "id", true);
+        if (layouts_by_id.find(id) == layouts_by_id.end())
+            layouts_by_id[id] = layout;
+        else
+            layouts_by_id[id] = Json();
+    }
+
+    atomic<size_t> next_map(0);
+    atomic<int> num_written(0);
+
+    auto process_next_maps = [&]() {
+        size_t i;
+        while ((i = next_map++) < map_filepaths.size()) {
+            string mapdata_err;
+            Json map_data = Json::parse(read_text_file(map_filepaths[i]), mapdata_err);
+            if (map_data == Json())
+                FATAL_ERROR("%s: %s\n", map_filepaths[i].c_str(), mapdata_err.c_str());
+
+            string map_layout_id = json_to_string(map_data, "layout");
+            auto layout = layouts_by_id.find(map_layout_id);
+            if (layout == layouts_by_id.end() || layout->second == Json())
+                FATAL_ERROR("Failed to find matching layout for %s.\n", map_layout_id.c_str());
+
+            string files_dir = get_directory_name(map_filepaths[i]);
+            num_written += write_text_file_if_changed(files_dir + "header.inc", generate_map_header_text(map_data, layout->second));
+            num_written += write_text_file_if_changed(files_dir + "events.inc", generate_map_events_text(map_data));
+            num_written += write_text_file_if_changed(files_dir + "connections.inc", generate_map_connections_text(map_data));
+        }
+    };
+
+    vector<thread> threads;
+    for (unsigned i = 1; i < num_threads && i < map_filepaths.size(); i++)
+        threads.push_back(thread(process_next_maps));
+    process_next_maps();
+    for (thread &t : threads)
+        t.join();
+
+    cout << "mapjson: " << map_filepaths.size() << " maps, wrote " << num_written << " of " << map_filepaths.size() * 3 << " files\n";
+}
+
 string generate_groups_text(Json groups_data) {
     ostringstream text;
 
@@ -630,8 +707,8 @@ int main(int argc, char *argv[]) {
 
     char *mode_arg = argv[1];
     string mode(mode_arg);
-    if (mode != "layouts" && mode != "map" && mode != "groups")
-        FATAL_ERROR("ERROR: <mode> must be 'layouts', 'map', or 'groups'.\n");
+    if (mode != "layouts" && mode != "map" && mode != "maps" && mode != "groups")
+        FATAL_ERROR("ERROR: <mode> must be 'layouts', 'map', 'maps', or 'groups'.\n");
 
     if (mode == "map") {
         if (argc != 5)
@@ -642,6 +719,27 @@ int main(int argc, char *argv[]) {
 
         process_map(filepath, layouts_filepath);
     }
+    else if (mode == "maps") {
+        const char *usage = "USAGE: mapjson maps <game-version> <layouts_file> [-j <threads>] <map_file>...\n";
+        if (argc < 4)
+            FATAL_ERROR("%s", usage);
+
+        string layouts_filepath(argv[3]);
+        unsigned num_threads = thread::hardware_concurrency();
+        vector<string> map_filepaths;
+
+        for (int i = 4; i < argc; i++) {
+            string arg(argv[i]);
+            if (arg == "-j") {
+                if (++i == argc || (num_threads = std::atoi(argv[i])) == 0)
+                    FATAL_ERROR("%s", usage);
+            } else {
+                map_filepaths.push_back(arg);
+            }
+        }
+
+        process_maps(map_filepaths, layouts_filepath, num_threads ? num_threads : 1);
+    }
     else if (mode == "groups") {
         if (argc != 4)
             FATAL_ERROR("USAGE: mapjson groups <game-version> <groups_file>\n");
@@ -13,6 +13,22 @@
  * P/K/F/A: Sets the result to the remaining of the line, flushes any
  *    output since the previous P/K/F/A and increment the number of
  *    passes/known fails/assumption fails/fails.
+ * D: The runner finished its shard.
+ *
+ * SHARDS
+ * The tests are split into more shards than there are processes, and
+ * each process takes the next shard from a queue when it finishes one,
+ * so processes whose shards run quickly take on more of the work. If a
+ * process dies before it finishes its shard, the test it was running is
+ * reported as a crash, and the rest of the shard goes back on the queue
+ * to resume after the tests that already have results.
+ *
+ * TIMINGS
+ * If given a timings file, Hydra records how long each test took in
+ * it, and uses the timings from previous runs to assign those tests to
+ * shards, longest first, so that the shards take about the same time.
+ * The assignments are patched into the ROM, which greedily assigns the
+ * tests without timings on top of them.
  */
 #include <fcntl.h>
 #include <math.h>
@@ -30,13 +46,18 @@
 #endif
 #include <sys/stat.h>
 #include <sys/wait.h>
+#include <time.h>
 #include <unistd.h>
+#include "../patchelf/elf.h"
 
 #define min(a, b) ((a) < (b) ? (a) : (b))
 
-#define MAX_PROCESSES               32 // See also test/test.h
+#define MAX_PROCESSES               32
+#define MAX_SHARDS                  128 // See also test/test.h
+#define SHARDS_PER_PROCESS          4
 #define MAX_SUMMARY_TESTS_TO_LIST   50
 #define MAX_TEST_LIST_BUFFER_LENGTH 256
+#define MAX_TEST_ASSIGNMENTS        8192 // See also test/test.h
 
 #define ARRAY_COUNT(arr) (sizeof((arr)) / sizeof((arr)[0]))
 
@@ -59,14 +80,83 @@ struct Runner
     int assumptionFails;
     int fails;
     int results;
+    unsigned shard;
+    int shardResults;
+    bool shardDone;
+    char timing_name[256];
+    struct timespec test_start;
     char failedTestNames[MAX_SUMMARY_TESTS_TO_LIST][MAX_TEST_LIST_BUFFER_LENGTH];
     char knownFailingPassedTestNames[MAX_SUMMARY_TESTS_TO_LIST][MAX_TEST_LIST_BUFFER_LENGTH];
 };
 
+struct Shard
+{
+    unsigned resume; // Tests that already have results.
+};
+
 static unsigned nrunners = 0;
 static unsigned runners_digits = 0;
 static struct Runner *runners = NULL;
 
+static unsigned nshards = 0;
+static struct Shard *shards = NULL;
+static unsigned *shard_queue = NULL;
+static unsigned shard_queue_head = 0;
+static unsigned shard_queue_size = 0;
+
+struct Timing
+{
+    char *name;
+    unsigned ms;
+};
+
+struct ShardCost
+{
+    unsigned cost;
+    unsigned shard;
+};
+
+static char **hydra_argv = NULL;
+static void *elf = NULL;
+static struct stat elfst;
+static pid_t parent_pid;
+
+static size_t ntimings = 0;
+static size_t timings_capacity = 0;
+static struct Timing *timings = NULL;
+static size_t nmeasurements = 0;
+static size_t measurements_capacity = 0;
+static struct Timing *measurements = NULL;
+
+static void add_timing(struct Timing **array, size_t *size, size_t *capacity, const char *name, unsigned ms)
+{
+    if (*size == *capacity)
+    {
+        *capacity = *capacity ? *capacity * 2 : 1024;
+        *array = realloc(*array, *capacity * sizeof(**array));
+        if (!*array)
+        {
+            perror("realloc timings failed");
+            exit(2);
+        }
+    }
+    (*array)[*size].name = strdup(name);
+    if (!(*array)[*size].name)
+    {
+        perror("strdup timing name failed");
+        exit(2);
+    }
+    (*array)[*size].ms = ms;
+    (*size)++;
+}
+
+static unsigned elapsed_ms(const struct timespec *start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000 + (now.tv_nsec - start->tv_nsec) / 1000000;
+}
+
 static void handle_read(int i, struct Runner *runner)
 {
     char *sol = runner->input_buffer;
@@ -101,6 +191,17 @@ static void handle_read(int i, struct Runner *runner)
                     }
                     strncpy(runner->test_name, soc, eol - soc - 1);
                     runner->test_name[eol - soc - 1] = '\0';
+                    // Tests rename themselves as they go, e.g. for each
+                    // parameter, so only the first name is the test's.
+                    if (runner->timing_name[0] == '\0')
+                    {
+                        strcpy(runner->timing_name, runner->test_name);
+                        clock_gettime(CLOCK_MONOTONIC, &runner->test_start);
+                    }
+                    break;
+
+                case 'D':
+                    runner->shardDone = true;
                     break;
 
                 case 'P':
@@ -126,6 +227,12 @@ static void handle_read(int i, struct Runner *runner)
                     runner->fails++;
 add_to_results:
                     runner->results++;
+                    runner->shardResults++;
+                    if (runner->timing_name[0] != '\0')
+                    {
+                        add_timing(&measurements, &nmeasurements, &measurements_capacity, runner->timing_name, elapsed_ms(&runner->test_start));
+                        runner->timing_name[0] = '\0';
+                    }
                     soc += 2;
                     fprintf(stdout, "[%0*d] %s: ", runners_digits, i, runner->test_name);
                     fwrite(soc, 1, eol - soc, stdout);
@@ -214,11 +321,470 @@ int compare_strings(const void * a, const void * b)
     return strcmp(arg1, arg2);
 }
 
+static void push_shard(unsigned shard)
+{
+    shard_queue[(shard_queue_head + shard_queue_size) % nshards] = shard;
+    shard_queue_size++;
+}
+
+static unsigned pop_shard(void)
+{
+    unsigned shard = shard_queue[shard_queue_head];
+    shard_queue_head = (shard_queue_head + 1) % nshards;
+    shard_queue_size--;
+    return shard;
+}
+
+static void start_shard(int i, unsigned shard)
+{
+    int pipefds[2];
+    if (pipe(pipefds) == -1)
+    {
+        perror("pipe failed");
+        exit(2);
+    }
+    pid_t pid = fork();
+    if (pid == -1) {
+        perror("fork mgba-rom-test failed");
+        exit(2);
+    } else if (pid == 0) {
+        #ifndef __APPLE__
+        if (prctl(PR_SET_PDEATHSIG, SIGTERM) == -1)
+        {
+            perror("prctl failed");
+            _exit(2);
+        }
+        #endif
+        if (getppid() != parent_pid) // Parent died.
+        {
+            _exit(2);
+        }
+        if (close(pipefds[0]) == -1)
+        {
+            perror("close pipefds[0] failed");
+            _exit(2);
+        }
+        if (dup2(pipefds[1], STDOUT_FILENO) == -1)
+        {
+            perror("dup2 stdout failed");
+            _exit(2);
+        }
+        if (close(pipefds[1]) == -1)
+        {
+            perror("close pipefds[1] failed");
+            _exit(2);
+        }
+        char rom_path[FILENAME_MAX];
+        sprintf(rom_path, "/tmp/mgba-rom-test-hydra-%05d", getpid());
+        int tmpfd;
+        if ((tmpfd = open(rom_path, O_WRONLY | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR)) == -1)
+        {
+            perror("open tmpfd failed");
+            _exit(2);
+        }
+        if ((write(tmpfd, elf, elfst.st_size)) == -1)
+        {
+            perror("write tmpfd failed");
+            _exit(2);
+        }
+        pid_t patchelfpid = fork();
+        if (patchelfpid == -1)
+        {
+            perror("fork patchelf failed");
+            _exit(2);
+        }
+        else if (patchelfpid == 0)
+        {
+            char n_arg[5], i_arg[5], resume_arg[9];
+            snprintf(n_arg, sizeof(n_arg), "\\x%02x", nshards);
+            snprintf(i_arg, sizeof(i_arg), "\\x%02x", shard);
+            snprintf(resume_arg, sizeof(resume_arg), "\\x%02x\\x%02x", shards[shard].resume & 0xFF, (shards[shard].resume >> 8) & 0xFF);
+            if (execlp("tools/patchelf/patchelf", "tools/patchelf/patchelf", rom_path, "gTestRunnerN", n_arg, "gTestRunnerI", i_arg, "gTestRunnerResume", resume_arg, NULL) == -1)
+            {
+                perror("execlp patchelf failed");
+                _exit(2);
+            }
+        }
+        else
+        {
+            int wstatus;
+            if (waitpid(patchelfpid, &wstatus, 0) == -1)
+            {
+                perror("waitpid patchelfpid failed");
+                _exit(2);
+            }
+            if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0)
+            {
+                fprintf(stderr, "patchelf exited with an error\n");
+                _exit(2);
+            }
+        }
+#ifdef __APPLE__
+        pid_t objcopypid = fork();
+        if (objcopypid == -1)
+        {
+            perror("fork objcopy failed");
+            _exit(2);
+        }
+        else if (objcopypid == 0)
+        {
+            if (execlp(hydra_argv[2], hydra_argv[2], "-O", "binary", rom_path, rom_path, NULL) == -1)
+            {
+                perror("execlp objcopy failed");
+                _exit(2);
+            }
+        }
+        else
+        {
+            int wstatus;
+            if (waitpid(objcopypid, &wstatus, 0) == -1)
+            {
+                perror("waitpid objcopy failed");
+                _exit(2);
+            }
+            if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0)
+            {
+                fprintf(stderr, "objcopy exited with an error\n");
+                _exit(2);
+            }
+        }
+#endif
+        // stdbuf is required because otherwise mgba never flushes
+        // stdout.
+        if (execlp("stdbuf", "stdbuf", "-oL", hydra_argv[1], "-l15", "-ClogLevel.gba.dma=16", "-Rr0", rom_path, NULL) == -1)
+        {
+            perror("execl stdbuf mgba-rom-test failed");
+            _exit(2);
+        }
+    } else {
+        runners[i].pid = pid;
+        sprintf(runners[i].rom_path, "/tmp/mgba-rom-test-hydra-%05d", runners[i].pid);
+        runners[i].outfd = pipefds[0];
+        runners[i].input_buffer_size = 0;
+        runners[i].shard = shard;
+        runners[i].shardResults = 0;
+        runners[i].shardDone = false;
+        runners[i].timing_name[0] = '\0';
+        strcpy(runners[i].test_name, "WAITING...");
+        if (close(pipefds[1]) == -1)
+        {
+            perror("close pipefds[1] failed");
+            exit(2);
+        }
+    }
+}
+
+static int read_runner(int i, struct Runner *runner)
+{
+    int n;
+    if ((n = read(runner->outfd, runner->input_buffer + runner->input_buffer_size, runner->input_buffer_capacity - runner->input_buffer_size)) == -1)
+    {
+        perror("read runner->outfd failed");
+        exit(2);
+    }
+    runner->input_buffer_size += n;
+    handle_read(i, runner);
+    return n;
+}
+
+// Reaps the process running the runner's shard. If it died before
+// finishing the shard, reports the test it was running as a crash and
+// puts the rest of the shard back on the queue.
+static void finish_shard(int i, struct Runner *runner, int *exit_code)
+{
+    int wstatus;
+    if (waitpid(runner->pid, &wstatus, 0) == -1)
+    {
+        perror("waitpid runners[i] failed");
+        exit(2);
+    }
+    if (runner->output_buffer_size > 0)
+        fwrite(runner->output_buffer, 1, runner->output_buffer_size, stdout);
+    runner->output_buffer_size = 0;
+    if (unlink(runner->rom_path) == -1)
+        perror("unlink rom_path failed");
+    runner->rom_path[0] = '\0';
+
+    if (runner->shardDone)
+    {
+        if (WIFEXITED(wstatus) && WEXITSTATUS(wstatus) > *exit_code)
+            *exit_code = WEXITSTATUS(wstatus);
+        return;
+    }
+
+    bool crashed_in_test = strcmp(runner->test_name, "WAITING...") != 0;
+    if (crashed_in_test)
+    {
+        if (runner->fails < MAX_SUMMARY_TESTS_TO_LIST)
+            strcpy(runner->failedTestNames[runner->fails], runner->test_name);
+        runner->fails++;
+        runner->results++;
+        fprintf(stdout, "[%0*d] %s: \e[31mCRASH\e[0m\n", runners_digits, i, runner->test_name);
+        strcpy(runner->test_name, "WAITING...");
+        runner->timing_name[0] = '\0';
+        if (*exit_code < 1)
+            *exit_code = 1;
+    }
+
+    // Only retry shards that made progress, so that one that can't even
+    // start doesn't retry forever.
+    if (crashed_in_test || runner->shardResults > 0)
+    {
+        shards[runner->shard].resume += runner->shardResults + crashed_in_test;
+        push_shard(runner->shard);
+    }
+    else
+    {
+        fprintf(stderr, "shard %u exited without running any tests\n", runner->shard);
+        *exit_code = 2;
+    }
+}
+
+static int compare_timing_names(const void *a, const void *b)
+{
+    return strcmp(((const struct Timing *)a)->name, ((const struct Timing *)b)->name);
+}
+
+static int compare_timing_costs(const void *a, const void *b)
+{
+    const struct Timing *arg1 = a, *arg2 = b;
+    if (arg1->ms != arg2->ms)
+        return arg1->ms < arg2->ms ? 1 : -1;
+    return strcmp(arg1->name, arg2->name);
+}
+
+static int compare_assignments(const void *a, const void *b)
+{
+    uint32_t arg1 = ((const uint32_t *)a)[0], arg2 = ((const uint32_t *)b)[0];
+    return arg1 < arg2 ? -1 : arg1 > arg2;
+}
+
+// Each line is "MS NAME".
+static void read_timings(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return; // No timings yet.
+
+    char line[32 + MAX_TEST_LIST_BUFFER_LENGTH];
+    while (fgets(line, sizeof(line), f))
+    {
+        char *name;
+        unsigned long ms = strtoul(line, &name, 10);
+        if (name == line || *name != ' ')
+            continue;
+        name++;
+        name[strcspn(name, "\n")] = '\0';
+        add_timing(&timings, &ntimings, &timings_capacity, name, ms);
+    }
+    fclose(f);
+}
+
+// Averages the new timings into the old ones. A run of every test also
+// forgets the timings of tests that no longer exist.
+static void write_timings(const char *path, bool full_run)
+{
+    char temp_path[FILENAME_MAX];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+    FILE *f = fopen(temp_path, "w");
+    if (!f)
+    {
+        perror("fopen timings failed");
+        exit(2);
+    }
+
+    qsort(timings, ntimings, sizeof(*timings), compare_timing_names);
+    qsort(measurements, nmeasurements, sizeof(*measurements), compare_timing_names);
+    size_t i = 0, j = 0;
+    while (i < ntimings || j < nmeasurements)
+    {
+        int order;
+        if (i == ntimings)
+            order = 1;
+        else if (j == nmeasurements)
+            order = -1;
+        else
+            order = strcmp(timings[i].name, measurements[j].name);
+
+        const char *name = order <= 0 ? timings[i].name : measurements[j].name;
+        unsigned long long total = 0;
+        unsigned count = 0;
+        for (; j < nmeasurements && strcmp(measurements[j].name, name) == 0; j++, count++)
+            total += measurements[j].ms;
+
+        if (order <= 0 && count > 0)
+            fprintf(f, "%llu %s\n", (timings[i].ms + total / count + 1) / 2, name);
+        else if (count > 0)
+            fprintf(f, "%llu %s\n", total / count, name);
+        else if (!full_run)
+            fprintf(f, "%u %s\n", timings[i].ms, name);
+
+        for (; order <= 0 && i + 1 < ntimings && strcmp(timings[i + 1].name, name) == 0; i++)
+            ;
+        if (order <= 0)
+            i++;
+    }
+
+    if (fclose(f) != 0 || rename(temp_path, path) == -1)
+    {
+        perror("write timings failed");
+        exit(2);
+    }
+}
+
+static void *find_symbol(const char *name, size_t size)
+{
+    const char *f = elf;
+    const Elf32_Ehdr *ehdr = (const Elf32_Ehdr *)f;
+    const Elf32_Shdr *shdrs = (const Elf32_Shdr *)(f + ehdr->e_shoff);
+    const char *shstr = f + shdrs[ehdr->e_shstrndx].sh_offset;
+    const Elf32_Shdr *shdr_symtab = NULL;
+    const Elf32_Shdr *shdr_strtab = NULL;
+    for (int i = 0; i < ehdr->e_shnum; i++)
+    {
+        const char *sh_name = shstr + shdrs[i].sh_name;
+        if (strcmp(sh_name, ".symtab") == 0)
+            shdr_symtab = &shdrs[i];
+        else if (strcmp(sh_name, ".strtab") == 0)
+            shdr_strtab = &shdrs[i];
+    }
+    if (shdr_symtab && shdr_strtab)
+    {
+        const Elf32_Sym *symtab = (const Elf32_Sym *)(f + shdr_symtab->sh_offset);
+        const char *strtab = f + shdr_strtab->sh_offset;
+        for (int i = 0; i < shdr_symtab->sh_size / shdr_symtab->sh_entsize; i++)
+        {
+            if (symtab[i].st_name == 0) continue;
+            if (symtab[i].st_shndx > ehdr->e_shnum) continue;
+            if (strcmp(strtab + symtab[i].st_name, name) != 0) continue;
+            if (symtab[i].st_size != size)
+            {
+                fprintf(stderr, "%s is %u bytes, expected %zu\n", name, symtab[i].st_size, size);
+                exit(2);
+            }
+            const Elf32_Shdr *shdr = &shdrs[symtab[i].st_shndx];
+            return (char *)elf + shdr->sh_offset + symtab[i].st_value - shdr->sh_addr;
+        }
+    }
+    fprintf(stderr, "%s not found\n", name);
+    exit(2);
+}
+
+static void write_u32(void *dest, uint32_t value)
+{
+    unsigned char *bytes = dest;
+    bytes[0] = value;
+    bytes[1] = value >> 8;
+    bytes[2] = value >> 16;
+    bytes[3] = value >> 24;
+}
+
+static uint32_t hash_test_name(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    while (*name)
+    {
+        hash ^= (unsigned char)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool shard_cost_less(const struct ShardCost *a, const struct ShardCost *b)
+{
+    return a->cost < b->cost || (a->cost == b->cost && a->shard < b->shard);
+}
+
+static void sift_down_shard_cost(struct ShardCost *heap, unsigned n, unsigned i)
+{
+    while (true)
+    {
+        unsigned child = 2 * i + 1;
+        if (child >= n)
+            break;
+        if (child + 1 < n && shard_cost_less(&heap[child + 1], &heap[child]))
+            child++;
+        if (!shard_cost_less(&heap[child], &heap[i]))
+            break;
+        struct ShardCost temp = heap[i];
+        heap[i] = heap[child];
+        heap[child] = temp;
+        i = child;
+    }
+}
+
+// Assigns the tests with timings to shards, longest first, each to the
+// shard with the least work so far, and patches the assignments into the
+// ROM.
+static void assign_timed_tests(const char *prefix)
+{
+    struct Timing *tests = calloc(ntimings + 1, sizeof(*tests));
+    struct ShardCost *heap = calloc(nshards, sizeof(*heap));
+    uint32_t (*assignments)[2] = calloc(MAX_TEST_ASSIGNMENTS, sizeof(*assignments));
+    if (!tests || !heap || !assignments)
+    {
+        perror("calloc assignments failed");
+        exit(2);
+    }
+
+    size_t ntests = 0;
+    for (size_t i = 0; i < ntimings; i++)
+    {
+        if (strncmp(timings[i].name, prefix, strlen(prefix)) == 0)
+            tests[ntests++] = timings[i];
+    }
+    qsort(tests, ntests, sizeof(*tests), compare_timing_costs);
+    if (ntests > MAX_TEST_ASSIGNMENTS)
+        ntests = MAX_TEST_ASSIGNMENTS;
+
+    for (unsigned i = 0; i < nshards; i++)
+    {
+        heap[i].cost = 0;
+        heap[i].shard = i;
+    }
+    for (size_t i = 0; i < ntests; i++)
+    {
+        assignments[i][0] = hash_test_name(tests[i].name);
+        assignments[i][1] = heap[0].shard;
+        heap[0].cost += tests[i].ms > 0 ? tests[i].ms : 1;
+        sift_down_shard_cost(heap, nshards, 0);
+    }
+
+    // Tests whose names hash the same all go where the first one went.
+    qsort(assignments, ntests, sizeof(*assignments), compare_assignments);
+    size_t nassignments = 0;
+    for (size_t i = 0; i < ntests; i++)
+    {
+        if (nassignments == 0 || assignments[nassignments - 1][0] != assignments[i][0])
+        {
+            assignments[nassignments][0] = assignments[i][0];
+            assignments[nassignments][1] = assignments[i][1];
+            nassignments++;
+        }
+    }
+
+    unsigned char *patch = find_symbol("gTestRunnerAssignments", MAX_TEST_ASSIGNMENTS * 8);
+    for (size_t i = 0; i < nassignments; i++)
+    {
+        write_u32(patch + i * 8, assignments[i][0]);
+        write_u32(patch + i * 8 + 4, assignments[i][1]);
+    }
+    write_u32(find_symbol("gTestRunnerAssignmentsCount", 4), nassignments);
+    write_u32(find_symbol("gTestRunnerDefaultCost", 4), ntests > 0 && tests[ntests / 2].ms > 0 ? tests[ntests / 2].ms : 1);
+    patch = find_symbol("gTestRunnerProcessCosts", MAX_SHARDS * 4);
+    for (unsigned i = 0; i < nshards; i++)
+        write_u32(patch + heap[i].shard * 4, heap[i].cost);
+
+    free(tests);
+    free(heap);
+    free(assignments);
+}
+
 int main(int argc, char *argv[])
 {
     if (argc < 4)
     {
-        fprintf(stderr, "usage %s mgba-rom-test objcopy rom\n", argv[0]);
+        fprintf(stderr, "usage %s mgba-rom-test objcopy rom [timings]\n", argv[0]);
         exit(2);
     }
 
@@ -244,6 +810,9 @@ int main(int argc, char *argv[])
         setvbuf(stdout, NULL, _IONBF, 0);
     }
 
+    hydra_argv = argv;
+    parent_pid = getpid();
+
     int elffd;
     if ((elffd = open(argv[3], O_RDONLY)) == -1)
     {
@@ -251,15 +820,13 @@ int main(int argc, char *argv[])
         exit(2);
     }
 
-    struct stat elfst;
     if (fstat(elffd, &elfst) == -1)
     {
         perror("stat elffd failed");
         exit(2);
     }
 
-    void *elf;
-    if ((elf = mmap(NULL, elfst.st_size, PROT_READ, MAP_PRIVATE, elffd, 0)) == MAP_FAILED)
+    if ((elf = mmap(NULL, elfst.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, elffd, 0)) == MAP_FAILED)
     {
         perror("mmap elffd failed");
         exit(2);
@@ -291,6 +858,24 @@ int main(int argc, char *argv[])
     if (nrunners > MAX_PROCESSES)
         nrunners = MAX_PROCESSES;
     runners_digits = ceil(log10(nrunners));
+    nshards = nrunners == 1 ? 1 : min(nrunners * SHARDS_PER_PROCESS, MAX_SHARDS);
+    shards = calloc(nshards, sizeof(*shards));
+    shard_queue = calloc(nshards, sizeof(*shard_queue));
+    if (!shards || !shard_queue)
+    {
+        perror("calloc shards failed");
+        exit(2);
+    }
+    for (int i = 0; i < nshards; i++)
+        push_shard(i);
+
+    const char *prefix = NULL;
+    if (argc > 4)
+    {
+        prefix = find_symbol("gTestRunnerArgv", 256);
+        read_timings(argv[4]);
+        assign_timed_tests(prefix);
+    }
     runners = calloc(nrunners, sizeof(*runners));
     if (!runners)
     {
@@ -313,140 +898,12 @@ int main(int argc, char *argv[])
     signal(SIGTERM, exit2);
 
     // Start test runners.
-    pid_t parent_pid = getpid();
     for (int i = 0; i < nrunners; i++)
-    {
-        int pipefds[2];
-        if (pipe(pipefds) == -1)
-        {
-            perror("pipe failed");
-            exit(2);
-        }
-        pid_t pid = fork();
-        if (pid == -1) {
-            perror("fork mgba-rom-test failed");
-            exit(2);
-        } else if (pid == 0) {
-            #ifndef __APPLE__
-            if (prctl(PR_SET_PDEATHSIG, SIGTERM) == -1)
-            {
-                perror("prctl failed");
-                _exit(2);
-            }
-            #endif
-            if (getppid() != parent_pid) // Parent died.
-            {
-                _exit(2);
-            }
-            if (close(pipefds[0]) == -1)
-            {
-                perror("close pipefds[0] failed");
-                _exit(2);
-            }
-            if (dup2(pipefds[1], STDOUT_FILENO) == -1)
-            {
-                perror("dup2 stdout failed");
-                _exit(2);
-            }
-            if (close(pipefds[1]) == -1)
-            {
-                perror("close pipefds[1] failed");
-                _exit(2);
-            }
-            char rom_path[FILENAME_MAX];
-            sprintf(rom_path, "/tmp/mgba-rom-test-hydra-%05d", getpid());
-            int tmpfd;
-            if ((tmpfd = open(rom_path, O_WRONLY | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR)) == -1)
-            {
-                perror("open tmpfd failed");
-                _exit(2);
-            }
-            if ((write(tmpfd, elf, elfst.st_size)) == -1)
-            {
-                perror("write tmpfd failed");
-                _exit(2);
-            }
-            pid_t patchelfpid = fork();
-            if (patchelfpid == -1)
-            {
-                perror("fork patchelf failed");
-                _exit(2);
-            }
-            else if (patchelfpid == 0)
-            {
-                char n_arg[5], i_arg[5];
-                snprintf(n_arg, sizeof(n_arg), "\\x%02x", nrunners);
-                snprintf(i_arg, sizeof(i_arg), "\\x%02x", i);
-                if (execlp("tools/patchelf/patchelf", "tools/patchelf/patchelf", rom_path, "gTestRunnerN", n_arg, "gTestRunnerI", i_arg, NULL) == -1)
-                {
-                    perror("execlp patchelf failed");
-                    _exit(2);
-                }
-            }
-            else
-            {
-                int wstatus;
-                if (waitpid(patchelfpid, &wstatus, 0) == -1)
-                {
-                    perror("waitpid patchelfpid failed");
-                    _exit(2);
-                }
-                if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0)
-                {
-                    fprintf(stderr, "patchelf exited with an error\n");
-                    _exit(2);
-                }
-            }
-#ifdef __APPLE__
-            pid_t objcopypid = fork();
-            if (objcopypid == -1)
-            {
-                perror("fork objcopy failed");
-                _exit(2);
-            }
-            else if (objcopypid == 0)
-            {
-                if (execlp(argv[2], argv[2], "-O", "binary", rom_path, rom_path, NULL) == -1)
-                {
-                    perror("execlp objcopy failed");
-                    _exit(2);
-                }
-            }
-            else
-            {
-                int wstatus;
-                if (waitpid(objcopypid, &wstatus, 0) == -1)
-                {
-                    perror("waitpid objcopy failed");
-                    _exit(2);
-                }
-                if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0)
-                {
-                    fprintf(stderr, "objcopy exited with an error\n");
-                    _exit(2);
-                }
-            }
-#endif
-            // stdbuf is required because otherwise mgba never flushes
-            // stdout.
-            if (execlp("stdbuf", "stdbuf", "-oL", argv[1], "-l15", "-ClogLevel.gba.dma=16", "-Rr0", rom_path, NULL) == -1)
-            {
-                perror("execl stdbuf mgba-rom-test failed");
-                _exit(2);
-            }
-        } else {
-            runners[i].pid = pid;
-            sprintf(runners[i].rom_path, "/tmp/mgba-rom-test-hydra-%05d", runners[i].pid);
-            runners[i].outfd = pipefds[0];
-            if (close(pipefds[1]) == -1)
-            {
-                perror("close pipefds[1] failed");
-                exit(2);
-            }
-        }
-    }
+        start_shard(i, pop_shard());
 
-    // Process test runner output.
+    // Process test runner output, and start the next shard whenever a
+    // runner finishes one.
+    int exit_code = 0;
     int openfds = nrunners;
     struct pollfd *pollfds = calloc(nrunners, sizeof(*pollfds));
     if (!pollfds)
@@ -487,26 +944,29 @@ int main(int argc, char *argv[])
         for (int i = 0; i < nrunners; i++)
         {
             if (pollfds[i].revents & POLLIN)
-            {
-                int n;
-                if ((n = read(pollfds[i].fd, runners[i].input_buffer + runners[i].input_buffer_size, runners[i].input_buffer_capacity - runners[i].input_buffer_size)) == -1)
-                {
-                    perror("read pollfds[i] failed");
-                    exit(2);
-                }
-                runners[i].input_buffer_size += n;
-                handle_read(i, &runners[i]);
-            }
+                read_runner(i, &runners[i]);
 
             if (pollfds[i].revents & (POLLERR | POLLHUP))
             {
+                // Whether the shard finished depends on its last output.
+                while (read_runner(i, &runners[i]) > 0)
+                    ;
                 if (close(pollfds[i].fd) == -1)
                 {
                     perror("close pollfds[i] failed");
                     exit(2);
                 }
                 runners[i].outfd = pollfds[i].fd = -pollfds[i].fd;
-                openfds--;
+                finish_shard(i, &runners[i], &exit_code);
+                if (shard_queue_size > 0)
+                {
+                    start_shard(i, pop_shard());
+                    pollfds[i].fd = runners[i].outfd;
+                }
+                else
+                {
+                    openfds--;
+                }
             }
         }
 
@@ -522,8 +982,7 @@ int main(int argc, char *argv[])
         }
     }
 
-    // Reap test runners and collate exit codes.
-    int exit_code = 0;
+    // Collate results.
     int passes = 0;
     int knownFails = 0;
     int knownFailsPassing = 0;
@@ -537,16 +996,6 @@ int main(int argc, char *argv[])
 
     for (int i = 0; i < nrunners; i++)
     {
-        int wstatus;
-        if (waitpid(runners[i].pid, &wstatus, 0) == -1)
-        {
-            perror("waitpid runners[i] failed");
-            exit(2);
-        }
-        if (runners[i].output_buffer_size > 0)
-            fwrite(runners[i].output_buffer, 1, runners[i].output_buffer_size, stdout);
-        if (WIFEXITED(wstatus) && WEXITSTATUS(wstatus) > exit_code)
-            exit_code = WEXITSTATUS(wstatus);
         passes += runners[i].passes;
         knownFails += runners[i].knownFails;
         for (int j = 0; j < runners[i].knownFailsPassing; j++)
@@ -614,6 +1063,9 @@ int main(int argc, char *argv[])
     }
     fprintf(stdout, "\n");
 
+    if (argc > 4)
+        write_timings(argv[4], prefix[0] == '\0');
+
     fflush(stdout);
     return exit_code;
 }
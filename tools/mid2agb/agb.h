@@ -28,6 +28,6 @@ void PrintAgbHeader();
 void PrintAgbTrack(std::vector<Event>& events);
 void PrintAgbFooter();
 
-extern int g_agbTrack;
+extern thread_local int g_agbTrack;
 
 #endif // AGB_H
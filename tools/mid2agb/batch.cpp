@@ -0,0 +1,311 @@
+// Batch mode runs every conversion in a manifest in one process, on a pool of
+// threads. With a cache directory, it also keeps each output under a hash of
+// everything that goes into it, and copies unchanged conversions from the cache
+// instead of redoing them, even if their timestamps changed, like after a
+// branch switch or a clean.
+//
+//   mid2agb -batch MANIFEST_FILE [-j THREADS] [-cache CACHE_DIR]
+//
+// Each line of the manifest is one conversion, with the same arguments as on
+// the command line, except that the input and output files have to come first.
+// Blank lines and lines starting with # are ignored. Conversions whose input
+// doesn't exist are skipped, so that a manifest made with `make -n` can include
+// files that make builds some other way.
+
+#include <sys/stat.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "batch.h"
+#include "error.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+// Bump this if cached outputs need to be thrown away for some reason other
+// than mid2agb itself changing, which is already part of every key.
+static const std::uint32_t kCacheVersion = 1;
+
+enum BatchResult
+{
+    Cached,
+    Converted,
+    Skipped,
+};
+
+struct CacheKey
+{
+    std::uint64_t a;
+    std::uint64_t b;
+};
+
+struct BatchJob
+{
+    std::vector<std::string> args;
+};
+
+static bool ReadWholeFile(const std::string& path, std::string& contents)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.is_open())
+        return false;
+
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    contents = stream.str();
+    return true;
+}
+
+// Two 64-bit FNV-1a style hashes with different multipliers, so that a
+// collision would need to hit both. The length goes first, so that adjacent
+// fields can't run into each other.
+static void HashField(CacheKey& key, const void* data, std::size_t size)
+{
+    std::uint64_t length = size;
+    const unsigned char* fields[2] = { (const unsigned char*)&length, (const unsigned char*)data };
+    std::size_t sizes[2] = { sizeof(length), size };
+
+    for (int i = 0; i < 2; i++)
+    {
+        for (std::size_t j = 0; j < sizes[i]; j++)
+        {
+            key.a = (key.a ^ fields[i][j]) * 0x100000001B3ull;
+            key.b = (key.b ^ fields[i][j]) * 0x9E3779B97F4A7C15ull;
+        }
+    }
+}
+
+static void HashString(CacheKey& key, const std::string& s)
+{
+    HashField(key, s.data(), s.size());
+}
+
+// The label defaults to the output's base name, so that's part of the key,
+// but the directory isn't.
+static std::string GetFileName(const std::string& path)
+{
+    std::size_t slash = path.find_last_of("/\\");
+
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+static std::string GetCachePath(const std::string& cacheDir, const CacheKey& key, const std::string& suffix)
+{
+    char name[33];
+
+    std::snprintf(name, sizeof(name), "%016llx%016llx", (unsigned long long)key.a, (unsigned long long)key.b);
+    return cacheDir + "/" + name + suffix;
+}
+
+static void WriteWholeFile(const std::string& path, const std::string& contents)
+{
+    FILE* fp = std::fopen(path.c_str(), "wb");
+
+    if (fp == nullptr)
+        RaiseError("failed to open \"%s\" for writing", path.c_str());
+
+    bool written = std::fwrite(contents.data(), 1, contents.size(), fp) == contents.size();
+
+    if (std::fclose(fp) != 0 || !written)
+        RaiseError("failed to write \"%s\"", path.c_str());
+}
+
+// Each conversion gets a thread of its own, so that it starts with the same
+// fresh state a separate process would have.
+static void Convert(ConvertFunction convert, const BatchJob& job)
+{
+    std::thread thread([&]()
+    {
+        std::vector<char*> argv;
+
+        argv.push_back((char*)"mid2agb");
+        for (const std::string& arg : job.args)
+            argv.push_back((char*)arg.c_str());
+        argv.push_back(nullptr);
+
+        g_errorFilename = job.args[0].c_str();
+        convert(argv.size() - 1, argv.data());
+    });
+
+    thread.join();
+}
+
+static BatchResult RunBatchJob(ConvertFunction convert, const BatchJob& job, const std::string& cacheDir, const CacheKey& toolKey, int jobIndex)
+{
+    const std::string& inputPath = job.args[0];
+    const std::string& outputPath = job.args[1];
+    std::string input;
+
+    if (!ReadWholeFile(inputPath, input))
+        return Skipped;
+
+    if (cacheDir.empty())
+    {
+        Convert(convert, job);
+        return Converted;
+    }
+
+    CacheKey key = toolKey;
+
+    HashField(key, input.data(), input.size());
+    HashString(key, GetFileName(outputPath));
+    for (std::size_t i = 2; i < job.args.size(); i++)
+        HashString(key, job.args[i]);
+
+    std::string output;
+
+    if (ReadWholeFile(GetCachePath(cacheDir, key, ""), output))
+    {
+        WriteWholeFile(outputPath, output);
+        return Cached;
+    }
+
+    Convert(convert, job);
+
+    // Writes to a temporary file first, so that another mid2agb reading the
+    // same cache never sees half of an entry.
+    if (!ReadWholeFile(outputPath, output))
+        RaiseError("conversion to \"%s\" didn't write it", outputPath.c_str());
+
+    std::string tempPath = GetCachePath(cacheDir, key, "." + std::to_string(getpid()) + "." + std::to_string(jobIndex) + ".tmp");
+    FILE* fp = std::fopen(tempPath.c_str(), "wb");
+
+    if (fp != nullptr)
+    {
+        bool written = std::fwrite(output.data(), 1, output.size(), fp) == output.size();
+
+        if (std::fclose(fp) != 0 || !written || std::rename(tempPath.c_str(), GetCachePath(cacheDir, key, "").c_str()) != 0)
+            std::remove(tempPath.c_str());
+    }
+
+    return Converted;
+}
+
+static std::vector<BatchJob> ReadManifest(const char* manifestPath)
+{
+    std::ifstream file(manifestPath);
+
+    if (!file.is_open())
+        RaiseError("failed to open \"%s\" for reading", manifestPath);
+
+    std::vector<BatchJob> jobs;
+    std::set<std::string> outputPaths;
+    std::string line;
+    int lineNum = 0;
+
+    while (std::getline(file, line))
+    {
+        std::istringstream words(line);
+        BatchJob job;
+        std::string word;
+
+        lineNum++;
+
+        while (words >> word)
+            job.args.push_back(word);
+
+        if (job.args.empty() || job.args[0][0] == '#')
+            continue;
+
+        if (job.args.size() < 2 || job.args[0][0] == '-' || job.args[1][0] == '-')
+            RaiseError("%s:%d: expected an input file and an output file", manifestPath, lineNum);
+
+        if (!outputPaths.insert(job.args[1]).second)
+            RaiseError("\"%s\" is the output of more than one conversion", job.args[1].c_str());
+
+        jobs.push_back(job);
+    }
+
+    return jobs;
+}
+
+static void MakeDirectory(const std::string& path)
+{
+#ifdef _WIN32
+    int result = _mkdir(path.c_str());
+#else
+    int result = mkdir(path.c_str(), 0777);
+#endif
+    struct stat st;
+
+    if (result != 0 && (stat(path.c_str(), &st) != 0 || !(st.st_mode & S_IFDIR)))
+        RaiseError("failed to create cache directory \"%s\"", path.c_str());
+}
+
+void RunBatch(int argc, char** argv, ConvertFunction convert)
+{
+    auto startTime = std::chrono::steady_clock::now();
+    int threadCount = std::thread::hardware_concurrency();
+    std::string cacheDir;
+
+    for (int i = 3; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+            threadCount = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "-cache") == 0 && i + 1 < argc)
+            cacheDir = argv[++i];
+        else
+            RaiseError("unrecognized option \"%s\"", argv[i]);
+    }
+
+    std::vector<BatchJob> jobs = ReadManifest(argv[2]);
+    CacheKey toolKey = { 0xCBF29CE484222325ull, 0x84222325CBF29CE4ull };
+
+    if (!cacheDir.empty())
+    {
+        std::string tool;
+
+        HashField(toolKey, &kCacheVersion, sizeof(kCacheVersion));
+        if (ReadWholeFile("/proc/self/exe", tool) || ReadWholeFile(argv[0], tool))
+            HashString(toolKey, tool);
+
+        MakeDirectory(cacheDir);
+    }
+
+    if (threadCount > (int)jobs.size())
+        threadCount = jobs.size();
+    if (threadCount < 1)
+        threadCount = 1;
+
+    std::atomic<std::size_t> nextJob(0);
+    std::atomic<int> results[3];
+
+    for (std::atomic<int>& result : results)
+        result = 0;
+
+    auto worker = [&]()
+    {
+        std::size_t i;
+
+        while ((i = nextJob++) < jobs.size())
+            results[RunBatchJob(convert, jobs[i], cacheDir, toolKey, i)]++;
+    };
+
+    std::vector<std::thread> threads;
+
+    for (int i = 1; i < threadCount; i++)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (std::thread& thread : threads)
+        thread.join();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    std::printf("mid2agb: %d conversions, %d cache hits, %d cache misses, %d skipped in %.2fs\n",
+                (int)jobs.size(), (int)results[Cached], (int)results[Converted], (int)results[Skipped], elapsed.count());
+}
@@ -0,0 +1,8 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+typedef void (*ConvertFunction)(int argc, char** argv);
+
+void RunBatch(int argc, char** argv, ConvertFunction convert);
+
+#endif // BATCH_H
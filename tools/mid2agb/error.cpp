@@ -22,6 +22,9 @@
 #include <cstdlib>
 #include <cstdarg>
 
+// Batch mode sets this to the file being converted, to say which one failed.
+thread_local const char* g_errorFilename = nullptr;
+
 // Reports an error diagnostic and terminates the program.
 [[noreturn]] void RaiseError(const char* format, ...)
 {
@@ -30,7 +33,10 @@
     std::va_list args;
     va_start(args, format);
     std::vsnprintf(buffer, bufferSize, format, args);
-    std::fprintf(stderr, "error: %s\n", buffer);
+    if (g_errorFilename != nullptr)
+        std::fprintf(stderr, "error: %s: %s\n", g_errorFilename, buffer);
+    else
+        std::fprintf(stderr, "error: %s\n", buffer);
     va_end(args);
     std::exit(1);
 }
@@ -23,4 +23,6 @@
 
 [[noreturn]] void RaiseError(const char* format, ...);
 
+extern thread_local const char* g_errorFilename;
+
 #endif // ERROR_H
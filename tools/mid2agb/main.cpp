@@ -29,23 +29,25 @@
 #include "error.h"
 #include "midi.h"
 #include "agb.h"
+#include "batch.h"
 
-FILE* g_inputFile = nullptr;
-FILE* g_outputFile = nullptr;
+thread_local FILE* g_inputFile = nullptr;
+thread_local FILE* g_outputFile = nullptr;
 
-std::string g_asmLabel;
-int g_masterVolume = 127;
-int g_voiceGroup = 0;
-int g_priority = 0;
-int g_reverb = -1;
-int g_clocksPerBeat = 1;
-bool g_exactGateTime = false;
-bool g_compressionEnabled = true;
+thread_local std::string g_asmLabel;
+thread_local int g_masterVolume = 127;
+thread_local int g_voiceGroup = 0;
+thread_local int g_priority = 0;
+thread_local int g_reverb = -1;
+thread_local int g_clocksPerBeat = 1;
+thread_local bool g_exactGateTime = false;
+thread_local bool g_compressionEnabled = true;
 
 [[noreturn]] static void PrintUsage()
 {
     std::printf(
         "Usage: MID2AGB name [options]\n"
+        "       MID2AGB -batch manifest_file [-j threads] [-cache cache_dir]\n"
         "\n"
         "    input_file  filename(.mid) of MIDI file\n"
         "   output_file  filename(.s) for AGB file (default:input_file)\n"
@@ -127,7 +129,7 @@ static const char *GetArgument(int argc, char **argv, int& index)
     }
 }
 
-int main(int argc, char** argv)
+void ConvertMidiFile(int argc, char** argv)
 {
     std::string inputFilename;
     std::string outputFilename;
@@ -228,6 +230,21 @@ int main(int argc, char** argv)
 
     std::fclose(g_inputFile);
     std::fclose(g_outputFile);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "-batch") == 0)
+    {
+        if (argc < 3)
+            PrintUsage();
+
+        RunBatch(argc, argv, ConvertMidiFile);
+    }
+    else
+    {
+        ConvertMidiFile(argc, argv);
+    }
 
     return 0;
 }
@@ -24,16 +24,16 @@
 #include <cstdio>
 #include <string>
 
-extern FILE* g_inputFile;
-extern FILE* g_outputFile;
+extern thread_local FILE* g_inputFile;
+extern thread_local FILE* g_outputFile;
 
-extern std::string g_asmLabel;
-extern int g_masterVolume;
-extern int g_voiceGroup;
-extern int g_priority;
-extern int g_reverb;
-extern int g_clocksPerBeat;
-extern bool g_exactGateTime;
-extern bool g_compressionEnabled;
+extern thread_local std::string g_asmLabel;
+extern thread_local int g_masterVolume;
+extern thread_local int g_voiceGroup;
+extern thread_local int g_priority;
+extern thread_local int g_reverb;
+extern thread_local int g_clocksPerBeat;
+extern thread_local bool g_exactGateTime;
+extern thread_local bool g_compressionEnabled;
 
 #endif // MAIN_H
@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 #include <cstdio>
+#include <cstring>
 #include <cassert>
 #include <string>
 #include <vector>
@@ -38,52 +39,72 @@ enum class MidiEventCategory
     Invalid,
 };
 
-MidiFormat g_midiFormat;
-std::int_fast32_t g_midiTrackCount;
-std::int16_t g_midiTimeDiv;
+thread_local MidiFormat g_midiFormat;
+thread_local std::int_fast32_t g_midiTrackCount;
+thread_local std::int16_t g_midiTimeDiv;
 
-int g_midiChan;
-std::int32_t g_initialWait;
+thread_local int g_midiChan;
+thread_local std::int32_t g_initialWait;
 
-static long s_trackDataStart;
-static std::vector<Event> s_seqEvents;
-static std::vector<Event> s_trackEvents;
-static std::int32_t s_absoluteTime;
-static int s_blockCount = 0;
-static int s_minNote;
-static int s_maxNote;
-static int s_runningStatus;
+static thread_local long s_trackDataStart;
+static thread_local std::vector<Event> s_seqEvents;
+static thread_local std::vector<Event> s_trackEvents;
+static thread_local std::int32_t s_absoluteTime;
+static thread_local int s_blockCount = 0;
+static thread_local int s_minNote;
+static thread_local int s_maxNote;
+static thread_local int s_runningStatus;
+
+// The tracks are read once per MIDI channel, seeking to the end of every note
+// and past every other channel's events, so the whole file is read into memory
+// up front instead of going through stdio for each of those.
+static thread_local std::vector<std::uint8_t> s_fileData;
+static thread_local long s_filePos;
+
+static void ReadWholeFile()
+{
+    std::uint8_t buffer[4096];
+    std::size_t count;
+
+    s_fileData.clear();
+    s_filePos = 0;
+
+    while ((count = std::fread(buffer, 1, sizeof(buffer), g_inputFile)) > 0)
+        s_fileData.insert(s_fileData.end(), buffer, buffer + count);
+}
 
 void Seek(long offset)
 {
-    if (std::fseek(g_inputFile, offset, SEEK_SET) != 0)
+    if (offset < 0)
         RaiseError("failed to seek to %l", offset);
+
+    s_filePos = offset;
 }
 
 void Skip(long offset)
 {
-    if (std::fseek(g_inputFile, offset, SEEK_CUR) != 0)
+    if (s_filePos + offset < 0)
         RaiseError("failed to skip %l bytes", offset);
+
+    s_filePos += offset;
 }
 
 std::string ReadSignature()
 {
-    char signature[4];
-
-    if (std::fread(signature, 4, 1, g_inputFile) != 1)
+    if (s_filePos + 4 > (long)s_fileData.size())
         RaiseError("failed to read signature");
 
-    return std::string(signature, 4);
+    s_filePos += 4;
+
+    return std::string((const char *)&s_fileData[s_filePos - 4], 4);
 }
 
 std::uint32_t ReadInt8()
 {
-    int c = std::fgetc(g_inputFile);
-
-    if (c < 0)
+    if (s_filePos >= (long)s_fileData.size())
         RaiseError("unexpected EOF");
 
-    return c;
+    return s_fileData[s_filePos++];
 }
 
 std::uint32_t ReadInt16()
@@ -130,7 +151,7 @@ std::uint32_t ReadVLQ()
 
 void ReadMidiFileHeader()
 {
-    Seek(0);
+    ReadWholeFile();
 
     if (ReadSignature() != "MThd")
         RaiseError("MIDI file header signature didn't match \"MThd\"");
@@ -162,7 +183,7 @@ long ReadMidiTrackHeader(long offset)
 
     long size = ReadInt32();
 
-    s_trackDataStart = std::ftell(g_inputFile);
+    s_trackDataStart = s_filePos;
 
     return size + 8;
 }
@@ -186,7 +207,7 @@ void DetermineEventCategory(MidiEventCategory& category, int& typeChan, int& siz
     if (typeChan < 0x80)
     {
         // If data byte was found, use the running status.
-        ungetc(typeChan, g_inputFile);
+        s_filePos--;
         typeChan = s_runningStatus;
     }
 
@@ -238,8 +259,12 @@ std::string ReadEventText()
 
     if (length <= 2)
     {
-        if (fread(buffer, length, 1, g_inputFile) != 1)
+        // A zero length fails too, like the fread this replaced.
+        if (length == 0 || s_filePos + (long)length > (long)s_fileData.size())
             RaiseError("failed to read event text");
+
+        std::memcpy(buffer, &s_fileData[s_filePos], length);
+        s_filePos += length;
     }
     else
     {
@@ -435,7 +460,7 @@ void FindNoteEnd(Event& event)
 {
     // Save the current file position and running status
     // which get modified by CheckNoteEnd.
-    long startPos = ftell(g_inputFile);
+    long startPos = s_filePos;
     int savedRunningStatus = s_runningStatus;
 
     event.param2 = 0;
@@ -509,7 +509,8 @@ void AsmFile::OutputLine()
         if (m_pos >= m_size)
         {
             RaiseWarning("file doesn't end with newline");
-            puts(&m_buffer[m_lineStart]);
+            std::fputs(&m_buffer[m_lineStart], g_asmOutput);
+            std::fputc('\n', g_asmOutput);
         }
         else
         {
@@ -519,7 +520,8 @@ void AsmFile::OutputLine()
     else
     {
         m_buffer[m_pos] = 0;
-        puts(&m_buffer[m_lineStart]);
+        std::fputs(&m_buffer[m_lineStart], g_asmOutput);
+        std::fputc('\n', g_asmOutput);
         m_buffer[m_pos] = '\n';
         m_pos++;
         m_lineStart = m_pos;
@@ -566,7 +568,7 @@ bool AsmFile::IsAtEnd()
 // Output the current location to set gas's logical file and line numbers.
 void AsmFile::OutputLocation()
 {
-    std::printf("# %ld \"%s\"\n", m_lineNum, m_filename.c_str());
+    std::fprintf(g_asmOutput, "# %ld \"%s\"\n", m_lineNum, m_filename.c_str());
 }
 
 // Reports a diagnostic message.
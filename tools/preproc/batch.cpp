@@ -0,0 +1,109 @@
+// Batch mode preprocesses many assembly files in one run, so the charmap is
+// only loaded once, and writes each one to a file instead of stdout:
+//
+//   preproc -batch CHARMAP_FILE OUT_DIR [-j N] [-cache CACHE_FILE] SRC_FILE...
+//
+// Each output is written to a temporary file first and only replaces the old
+// one if it changed, so make doesn't reassemble files whose output is the same.
+
+#include <atomic>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "preproc.h"
+#include "batch.h"
+
+static bool ReadWholeFile(const std::string& path, std::string& contents)
+{
+    FILE *fp = std::fopen(path.c_str(), "rb");
+
+    if (fp == NULL)
+        return false;
+
+    char buffer[4096];
+    std::size_t count;
+
+    contents.clear();
+    while ((count = std::fread(buffer, 1, sizeof(buffer), fp)) > 0)
+        contents.append(buffer, count);
+
+    std::fclose(fp);
+    return true;
+}
+
+static std::string GetOutputPath(const std::string& srcPath, const std::string& outDir)
+{
+    std::size_t slash = srcPath.rfind('/');
+
+    if (slash == std::string::npos)
+        return outDir + "/" + srcPath;
+    else
+        return outDir + srcPath.substr(slash);
+}
+
+static void PreprocAsmFileTo(const std::string& srcPath, const std::string& outPath)
+{
+    std::string tempPath = outPath + ".tmp";
+    FILE *fp = std::fopen(tempPath.c_str(), "wb");
+
+    if (fp == NULL)
+        FATAL_ERROR("Failed to open \"%s\" for writing.\n", tempPath.c_str());
+
+    g_asmOutput = fp;
+    PreprocAsmFile(srcPath);
+    g_asmOutput = stdout;
+
+    if (std::fclose(fp) != 0)
+        FATAL_ERROR("Failed to write \"%s\".\n", tempPath.c_str());
+
+    std::string oldContents, newContents;
+
+    if (ReadWholeFile(outPath, oldContents) && ReadWholeFile(tempPath, newContents) && oldContents == newContents)
+    {
+        std::remove(tempPath.c_str());
+        return;
+    }
+
+    std::remove(outPath.c_str());
+
+    if (std::rename(tempPath.c_str(), outPath.c_str()) != 0)
+        FATAL_ERROR("Failed to rename \"%s\" to \"%s\".\n", tempPath.c_str(), outPath.c_str());
+}
+
+void PreprocAsmBatch(const std::vector<std::string>& srcPaths, const std::string& outDir, int numThreads)
+{
+    std::vector<std::string> outPaths;
+    std::set<std::string> seenOutPaths;
+
+    for (const std::string& srcPath : srcPaths)
+    {
+        outPaths.push_back(GetOutputPath(srcPath, outDir));
+        if (!seenOutPaths.insert(outPaths.back()).second)
+            FATAL_ERROR("More than one source would be written to \"%s\".\n", outPaths.back().c_str());
+    }
+
+    if (numThreads > (int)srcPaths.size())
+        numThreads = srcPaths.size();
+    if (numThreads < 1)
+        numThreads = 1;
+
+    // The charmap is only read once it's loaded, so the threads share it.
+    std::atomic<std::size_t> nextIndex(0);
+    auto worker = [&]()
+    {
+        std::size_t i;
+
+        while ((i = nextIndex++) < srcPaths.size())
+            PreprocAsmFileTo(srcPaths[i], outPaths[i]);
+    };
+
+    std::vector<std::thread> threads;
+
+    for (int i = 1; i < numThreads; i++)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (std::thread& thread : threads)
+        thread.join();
+}
@@ -0,0 +1,12 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <string>
+#include <vector>
+
+// Preprocesses every assembly file in srcPaths into outDir, under the same
+// file name, using up to numThreads threads. Outputs whose contents didn't
+// change are left alone.
+void PreprocAsmBatch(const std::vector<std::string>& srcPaths, const std::string& outDir, int numThreads);
+
+#endif // BATCH_H
@@ -241,8 +241,16 @@ void CFile::TryConvertString()
                 RaiseError(e.what());
             }
 
+            char buffer[kMaxStringLength * sizeof("0xFF, ")];
+            char *out = buffer;
+
             for (int i = 0; i < length; i++)
-                printf("0x%02X, ", s[i]);
+            {
+                out = WriteHexByte(out, s[i]);
+                *out++ = ',';
+                *out++ = ' ';
+            }
+            std::fwrite(buffer, 1, out - buffer, stdout);
         }
         else if (m_buffer[m_pos] == ')')
         {
@@ -321,9 +329,13 @@ int ExtractData(const std::unique_ptr<unsigned char[]>& buffer, int offset, int
 
 void CFile::TryConvertIncbin()
 {
-    std::string idents[8] = { "INCBIN_S8", "INCBIN_U8", "INCBIN_S16", "INCBIN_U16", "INCBIN_S32", "INCBIN_U32", "DUMMY", "INCBIN_COMP"};
+    // This is tried at every character, so it's quick to rule them out.
+    static const std::string idents[8] = { "INCBIN_S8", "INCBIN_U8", "INCBIN_S16", "INCBIN_U16", "INCBIN_S32", "INCBIN_U32", "DUMMY", "INCBIN_COMP"};
     int incbinType = -1;
 
+    if (m_buffer[m_pos] != 'I' && m_buffer[m_pos] != 'D')
+        return;
+
     for (int i = 0; i < 8; i++)
     {
         if (CheckIdentifier(idents[i]))
@@ -68,4 +68,17 @@ inline bool IsIdentifierChar(unsigned char c)
     return IsAsciiAlphanum(c) || c == '_';
 }
 
+// Writes a byte as "0xAB" and returns where it stopped, which is much faster
+// than printf for the many bytes strings are output as.
+inline char* WriteHexByte(char* s, unsigned char byte)
+{
+    static const char digits[] = "0123456789ABCDEF";
+
+    s[0] = '0';
+    s[1] = 'x';
+    s[2] = digits[byte >> 4];
+    s[3] = digits[byte & 0xF];
+    return s + 4;
+}
+
 #endif // CHAR_UTIL_H
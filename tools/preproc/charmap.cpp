@@ -21,6 +21,14 @@
 #include <cstdio>
 #include <cstdint>
 #include <cstdarg>
+#include <algorithm>
+#include <cstring>
+#ifdef _MSC_VER
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
 #include "preproc.h"
 #include "charmap.h"
 #include "char_util.h"
@@ -369,7 +377,329 @@ void CharmapReader::SkipWhitespace()
         m_pos++;
 }
 
-Charmap::Charmap(std::string filename)
+// The cache is the parsed charmap in a compact binary form, which is much
+// faster to load than parsing the text, and the hash of the text it came from.
+// Bump the magic whenever the format changes.
+static const char kCacheMagic[8] = { 'P', 'P', 'C', 'M', 'A', 'P', '0', '1' };
+
+// FNV-1a
+static std::uint64_t HashFile(const std::string& filename)
+{
+    FILE *fp = std::fopen(filename.c_str(), "rb");
+
+    if (fp == NULL)
+        FATAL_ERROR("Failed to open \"%s\" for reading.\n", filename.c_str());
+
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    unsigned char buffer[4096];
+    std::size_t count;
+
+    while ((count = std::fread(buffer, 1, sizeof(buffer), fp)) > 0)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            hash ^= buffer[i];
+            hash *= 0x100000001B3ULL;
+        }
+    }
+
+    std::fclose(fp);
+    return hash;
+}
+
+class CacheWriter
+{
+public:
+    void Bytes(const void* data, std::size_t size)
+    {
+        m_data.append(static_cast<const char*>(data), size);
+    }
+
+    void U32(std::uint32_t value)
+    {
+        Bytes(&value, sizeof(value));
+    }
+
+    void String(const std::string& s)
+    {
+        U32(s.length());
+        Bytes(s.data(), s.length());
+    }
+
+    const std::string& Data()
+    {
+        return m_data;
+    }
+
+private:
+    std::string m_data;
+};
+
+class CacheReader
+{
+public:
+    CacheReader(const std::string& data) : m_data(data), m_pos(0), m_ok(true) {}
+
+    bool Bytes(void* out, std::size_t size)
+    {
+        if (!m_ok || m_data.size() - m_pos < size)
+            return m_ok = false;
+
+        std::memcpy(out, m_data.data() + m_pos, size);
+        m_pos += size;
+        return true;
+    }
+
+    std::uint32_t U32()
+    {
+        std::uint32_t value = 0;
+        Bytes(&value, sizeof(value));
+        return value;
+    }
+
+    std::string String()
+    {
+        std::uint32_t length = U32();
+
+        if (!m_ok || m_data.size() - m_pos < length)
+        {
+            m_ok = false;
+            return std::string();
+        }
+
+        m_pos += length;
+        return m_data.substr(m_pos - length, length);
+    }
+
+    bool AtEnd()
+    {
+        return m_ok && m_pos == m_data.size();
+    }
+
+    bool Ok()
+    {
+        return m_ok;
+    }
+
+private:
+    const std::string& m_data;
+    std::size_t m_pos;
+    bool m_ok;
+};
+
+Charmap::Charmap(std::string filename, std::string cachePath)
+{
+    if (cachePath.empty())
+    {
+        Parse(filename);
+    }
+    else
+    {
+        std::uint64_t hash = HashFile(filename);
+
+        if (!LoadCache(cachePath, hash))
+        {
+            Parse(filename);
+            SaveCache(cachePath, hash);
+        }
+    }
+
+    Compile();
+}
+
+static CharmapSequence MakeSequence(const std::string& bytes)
+{
+    CharmapSequence sequence = {};
+
+    sequence.length = bytes.length();
+    std::memcpy(sequence.bytes, bytes.data(), bytes.length());
+    return sequence;
+}
+
+// Builds the node for keys[lo..hi), which are sorted and share their first
+// depth bytes, and returns its index. Since they're sorted, a key that ends
+// here comes first.
+int Charmap::Trie::Build(const std::vector<std::pair<std::string, int>>& keys, std::size_t lo, std::size_t hi, std::size_t depth)
+{
+    int node = nodes.size();
+
+    nodes.push_back(Node{ -1, 0, 1, 0 });
+
+    if (lo < hi && keys[lo].first.length() == depth)
+        nodes[node].sequence = keys[lo++].second;
+
+    if (lo == hi)
+        return node;
+
+    unsigned char first = keys[lo].first[depth];
+    unsigned char last = keys[hi - 1].first[depth];
+    int childBase = children.size();
+
+    nodes[node].first = first;
+    nodes[node].last = last;
+    nodes[node].childBase = childBase;
+    children.resize(childBase + last - first + 1, -1);
+
+    while (lo < hi)
+    {
+        unsigned char byte = keys[lo].first[depth];
+        std::size_t end = lo;
+
+        while (end < hi && (unsigned char)keys[end].first[depth] == byte)
+            end++;
+
+        int child = Build(keys, lo, end, depth + 1);
+        children[childBase + byte - first] = child;
+        lo = end;
+    }
+
+    return node;
+}
+
+// Compiles the charmap into tables for ASCII chars and escapes, and tries for
+// the UTF-8 encodings of the other chars and for constants.
+void Charmap::Compile()
+{
+    std::vector<std::pair<std::string, int>> charKeys;
+    std::vector<std::pair<std::string, int>> constantKeys;
+
+    for (int i = 0; i < 128; i++)
+    {
+        m_escapeSequences[i] = MakeSequence(m_escapes[i]);
+        m_asciiChars[i] = MakeSequence(m_chars.count(i) != 0 ? m_chars[i] : std::string());
+    }
+
+    for (const auto& it : m_chars)
+    {
+        char encoding[4];
+        int length = EncodeUtf8(it.first, encoding);
+
+        if (it.first < 128 || length == 0)
+            continue;
+
+        charKeys.push_back(std::make_pair(std::string(encoding, length), (int)m_sequences.size()));
+        m_sequences.push_back(MakeSequence(it.second));
+    }
+
+    // The map is already sorted by name.
+    for (const auto& it : m_constants)
+    {
+        constantKeys.push_back(std::make_pair(it.first, (int)m_sequences.size()));
+        m_sequences.push_back(MakeSequence(it.second));
+    }
+
+    std::sort(charKeys.begin(), charKeys.end());
+    m_charTrie.Build(charKeys, 0, charKeys.size(), 0);
+    m_constantTrie.Build(constantKeys, 0, constantKeys.size(), 0);
+}
+
+const CharmapSequence* Charmap::Char(std::int32_t code)
+{
+    if (code >= 0 && code < 128)
+        return m_asciiChars[code].length != 0 ? &m_asciiChars[code] : nullptr;
+
+    char encoding[5] = {};
+    int length;
+
+    if (EncodeUtf8(code, encoding) == 0)
+        return nullptr;
+
+    return MatchChar(encoding, length);
+}
+
+bool Charmap::LoadCache(const std::string& path, std::uint64_t hash)
+{
+    FILE *fp = std::fopen(path.c_str(), "rb");
+
+    if (fp == NULL)
+        return false;
+
+    std::string data;
+    char buffer[4096];
+    std::size_t count;
+
+    while ((count = std::fread(buffer, 1, sizeof(buffer), fp)) > 0)
+        data.append(buffer, count);
+    std::fclose(fp);
+
+    CacheReader reader(data);
+    char magic[sizeof(kCacheMagic)];
+    std::uint64_t cacheHash;
+
+    if (!reader.Bytes(magic, sizeof(magic)) || std::memcmp(magic, kCacheMagic, sizeof(magic)) != 0
+     || !reader.Bytes(&cacheHash, sizeof(cacheHash)) || cacheHash != hash)
+        return false;
+
+    std::uint32_t charCount = reader.U32();
+
+    for (std::uint32_t i = 0; i < charCount && reader.Ok(); i++)
+    {
+        std::int32_t code = reader.U32();
+        m_chars[code] = reader.String();
+    }
+
+    for (std::string& escape : m_escapes)
+        escape = reader.String();
+
+    std::uint32_t constantCount = reader.U32();
+
+    for (std::uint32_t i = 0; i < constantCount && reader.Ok(); i++)
+    {
+        std::string name = reader.String();
+        m_constants[name] = reader.String();
+    }
+
+    if (reader.AtEnd())
+        return true;
+
+    // Corrupt, so start over from the text.
+    m_chars.clear();
+    for (std::string& escape : m_escapes)
+        escape.clear();
+    m_constants.clear();
+    return false;
+}
+
+// Several preprocs may be compiling the same cache at once, so each writes its
+// own temporary file and renames it into place. A cache that can't be written
+// isn't an error, since the charmap has already been parsed.
+void Charmap::SaveCache(const std::string& path, std::uint64_t hash)
+{
+    CacheWriter writer;
+
+    writer.Bytes(kCacheMagic, sizeof(kCacheMagic));
+    writer.Bytes(&hash, sizeof(hash));
+
+    writer.U32(m_chars.size());
+    for (const auto& it : m_chars)
+    {
+        writer.U32(it.first);
+        writer.String(it.second);
+    }
+
+    for (const std::string& escape : m_escapes)
+        writer.String(escape);
+
+    writer.U32(m_constants.size());
+    for (const auto& it : m_constants)
+    {
+        writer.String(it.first);
+        writer.String(it.second);
+    }
+
+    std::string tempPath = path + ".tmp" + std::to_string(getpid());
+    FILE *fp = std::fopen(tempPath.c_str(), "wb");
+
+    if (fp == NULL)
+        return;
+
+    bool ok = std::fwrite(writer.Data().data(), writer.Data().size(), 1, fp) == 1;
+
+    if (std::fclose(fp) != 0 || !ok || std::rename(tempPath.c_str(), path.c_str()) != 0)
+        std::remove(tempPath.c_str());
+}
+
+void Charmap::Parse(std::string filename)
 {
     CharmapReader reader(filename);
 
@@ -26,39 +26,120 @@
 #include <map>
 #include <vector>
 
+const unsigned long kMaxCharmapSequenceLength = 16;
+
+// The bytes a char, escape or constant maps to. A length of zero means it
+// isn't mapped.
+struct CharmapSequence
+{
+    unsigned char length;
+    unsigned char bytes[kMaxCharmapSequenceLength];
+};
+
 class Charmap
 {
 public:
-    Charmap(std::string filename);
+    // If cachePath isn't empty, the charmap is loaded from a compiled copy
+    // there when one matches the file, and compiled there when none does.
+    Charmap(std::string filename, std::string cachePath = std::string());
+
+    const CharmapSequence* Char(std::int32_t code);
 
-    std::string Char(std::int32_t code)
+    // Looks up the char whose UTF-8 encoding starts s, and sets length to
+    // the length of that encoding. Returns nullptr if there's no such char,
+    // including when s doesn't start with valid UTF-8.
+    const CharmapSequence* MatchChar(const char* s, int& length)
     {
-        auto it = m_chars.find(code);
+        unsigned char c = s[0];
+
+        if (c < 128)
+        {
+            length = 1;
+            return m_asciiChars[c].length != 0 ? &m_asciiChars[c] : nullptr;
+        }
 
-        if (it == m_chars.end())
-            return std::string();
+        int node = 0;
 
-        return it->second;
+        for (length = 0; node != -1; length++)
+        {
+            if (m_charTrie.nodes[node].sequence != -1)
+                return &m_sequences[m_charTrie.nodes[node].sequence];
+
+            node = m_charTrie.Child(node, s[length]);
+        }
+
+        return nullptr;
+    }
+
+    const CharmapSequence* Escape(unsigned char code)
+    {
+        return m_escapeSequences[code].length != 0 ? &m_escapeSequences[code] : nullptr;
     }
 
-    std::string Escape(unsigned char code)
+    // Constants are looked up one character at a time as they're read, starting
+    // from ConstantRoot(). A node of -1 means no constant starts that way.
+    int ConstantRoot()
     {
-        return m_escapes[code];
+        return 0;
     }
 
-    std::string Constant(std::string identifier)
+    int NextConstantNode(int node, char c)
     {
-        auto it = m_constants.find(identifier);
+        return node != -1 ? m_constantTrie.Child(node, c) : -1;
+    }
 
-        if (it == m_constants.end())
-            return std::string();
+    const CharmapSequence* Constant(int node)
+    {
+        if (node == -1 || m_constantTrie.nodes[node].sequence == -1)
+            return nullptr;
 
-        return it->second;
+        return &m_sequences[m_constantTrie.nodes[node].sequence];
     }
 private:
+    // A byte trie whose nodes keep their children in a table covering the
+    // range of bytes they have children for.
+    struct Trie
+    {
+        struct Node
+        {
+            int sequence;
+            int childBase;
+            unsigned char first;
+            unsigned char last;
+        };
+
+        std::vector<Node> nodes;
+        std::vector<int> children;
+
+        int Child(int node, char c)
+        {
+            const Node& n = nodes[node];
+            unsigned char byte = c;
+
+            if (byte < n.first || byte > n.last)
+                return -1;
+
+            return children[n.childBase + byte - n.first];
+        }
+
+        int Build(const std::vector<std::pair<std::string, int>>& keys, std::size_t lo, std::size_t hi, std::size_t depth);
+    };
+
     std::map<std::int32_t, std::string> m_chars;
     std::string m_escapes[128];
     std::map<std::string, std::string> m_constants;
+
+    // Compiled from the above for fast lookups.
+    CharmapSequence m_escapeSequences[128];
+    CharmapSequence m_asciiChars[128];
+    std::vector<CharmapSequence> m_sequences;
+    Trie m_charTrie;
+    Trie m_constantTrie;
+
+    void Parse(std::string filename);
+    void Compile();
+    bool LoadCache(const std::string& path, std::uint64_t hash);
+    void SaveCache(const std::string& path, std::uint64_t hash);
 };
 
 #endif // CHARMAP_H
@@ -18,28 +18,42 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#include <cstring>
 #include <string>
 #include <stack>
+#include <thread>
+#include <vector>
 #include "preproc.h"
 #include "asm_file.h"
+#include "batch.h"
 #include "c_file.h"
+#include "char_util.h"
 #include "charmap.h"
 
 Charmap* g_charmap;
+thread_local std::FILE* g_asmOutput;
 
 void PrintAsmBytes(unsigned char *s, int length)
 {
     if (length > 0)
     {
-        std::printf("\t.byte ");
+        char buffer[sizeof("\t.byte \n") + kMaxStringLength * sizeof("0xFF, ")];
+        char *out = buffer;
+
+        std::memcpy(out, "\t.byte ", 7);
+        out += 7;
         for (int i = 0; i < length; i++)
         {
-            std::printf("0x%02X", s[i]);
+            out = WriteHexByte(out, s[i]);
 
             if (i < length - 1)
-                std::printf(", ");
+            {
+                *out++ = ',';
+                *out++ = ' ';
+            }
         }
-        std::putchar('\n');
+        *out++ = '\n';
+        std::fwrite(buffer, 1, out - buffer, g_asmOutput);
     }
 }
 
@@ -90,7 +104,7 @@ void PreprocAsmFile(std::string filename)
             if (globalLabel.length() != 0)
             {
                 const char *s = globalLabel.c_str();
-                std::printf("%s: ; .global %s\n", s, s);
+                std::fprintf(g_asmOutput, "%s: ; .global %s\n", s, s);
             }
             else
             {
@@ -130,15 +144,66 @@ char* GetFileExtension(char* filename)
     return extension;
 }
 
+static void Usage(const char *program)
+{
+    std::fprintf(stderr,
+        "Usage: %s SRC_FILE CHARMAP_FILE [-i] [-cache CACHE_FILE]\n"
+        "       %s -batch CHARMAP_FILE OUT_DIR [-j N] [-cache CACHE_FILE] SRC_FILE...\n"
+        "where -i denotes if input is from stdin, and -cache keeps a compiled\n"
+        "copy of the charmap that loads faster\n", program, program);
+    std::exit(1);
+}
+
+static int BatchMain(int argc, char **argv)
+{
+    if (argc < 4)
+        Usage(argv[0]);
+
+    std::string charmapPath = argv[2];
+    std::string outDir = argv[3];
+    std::string cachePath;
+    std::vector<std::string> srcPaths;
+    int numThreads = std::thread::hardware_concurrency();
+
+    for (int i = 4; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+            numThreads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "-cache") == 0 && i + 1 < argc)
+            cachePath = argv[++i];
+        else
+            srcPaths.push_back(argv[i]);
+    }
+
+    g_charmap = new Charmap(charmapPath, cachePath);
+    PreprocAsmBatch(srcPaths, outDir, numThreads);
+    return 0;
+}
+
 int main(int argc, char **argv)
 {
-    if (argc < 3 || argc > 4)
+    g_asmOutput = stdout;
+
+    if (argc >= 2 && std::strcmp(argv[1], "-batch") == 0)
+        return BatchMain(argc, argv);
+
+    if (argc < 3)
+        Usage(argv[0]);
+
+    bool isStdin = false;
+    std::string cachePath;
+
+    for (int i = 3; i < argc; i++)
     {
-        std::fprintf(stderr, "Usage: %s SRC_FILE CHARMAP_FILE [-i]\nwhere -i denotes if input is from stdin\n", argv[0]);
-        return 1;
+        if (std::strcmp(argv[i], "-i") == 0)
+            isStdin = true;
+        else if (std::strcmp(argv[i], "-cache") == 0 && i + 1 < argc)
+            cachePath = argv[++i];
+        else
+            FATAL_ERROR("unknown argument flag \"%s\".\n", argv[i]);
     }
 
-    g_charmap = new Charmap(argv[2]);
+    g_charmap = new Charmap(argv[2], cachePath);
 
     char* extension = GetFileExtension(argv[1]);
 
@@ -147,17 +212,9 @@ int main(int argc, char **argv)
 
     if ((extension[0] == 's') && extension[1] == 0)
         PreprocAsmFile(argv[1]);
-    else if ((extension[0] == 'c' || extension[0] == 'i') && extension[1] == 0) {
-        if (argc == 4) {
-            if (argv[3][0] == '-' && argv[3][1] == 'i' && argv[3][2] == '\0') {
-                PreprocCFile(argv[1], true);
-            } else {
-                FATAL_ERROR("unknown argument flag \"%s\".\n", argv[3]);
-            }
-        } else {
-            PreprocCFile(argv[1], false);
-        }
-    } else
+    else if ((extension[0] == 'c' || extension[0] == 'i') && extension[1] == 0)
+        PreprocCFile(argv[1], isStdin);
+    else
         FATAL_ERROR("\"%s\" has an unknown file extension of \"%s\".\n", argv[1], extension);
 
     return 0;
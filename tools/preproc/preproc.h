@@ -23,6 +23,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <string>
 #include "charmap.h"
 
 #ifdef _MSC_VER
@@ -47,8 +48,15 @@ do                                               \
 
 const int kMaxPath = 256;
 const int kMaxStringLength = 1024;
-const unsigned long kMaxCharmapSequenceLength = 16;
 
 extern Charmap* g_charmap;
 
+// Where preprocessed assembly is written. It's stdout unless a batch is
+// running, which points each of its threads at the file it's writing. It's
+// set in main rather than initialized, since a thread_local with a dynamic
+// initializer is slower to access.
+extern thread_local std::FILE* g_asmOutput;
+
+void PreprocAsmFile(std::string filename);
+
 #endif // PREPROC_H
@@ -20,6 +20,7 @@
 
 #include <cstdio>
 #include <cstdarg>
+#include <cstring>
 #include <stdexcept>
 #include "preproc.h"
 #include "string_parser.h"
@@ -27,9 +28,18 @@
 #include "utf8.h"
 
 // Reads a charmap char or escape sequence.
-std::string StringParser::ReadCharOrEscape()
+const CharmapSequence* StringParser::ReadCharOrEscape()
 {
-    std::string sequence;
+    const CharmapSequence* sequence;
+    int length;
+
+    // Fast path for chars that are mapped. The rest are handled below, which
+    // also reports what's wrong with them.
+    if (m_buffer[m_pos] != '\\' && (sequence = g_charmap->MatchChar(&m_buffer[m_pos], length)) != nullptr)
+    {
+        m_pos += length;
+        return sequence;
+    }
 
     bool isEscape = (m_buffer[m_pos] == '\\');
 
@@ -41,7 +51,7 @@ std::string StringParser::ReadCharOrEscape()
         {
             sequence = g_charmap->Char('"');
 
-            if (sequence.length() == 0)
+            if (sequence == nullptr)
                 RaiseError("no mapping exists for double quote");
 
             return sequence;
@@ -50,7 +60,7 @@ std::string StringParser::ReadCharOrEscape()
         {
             sequence = g_charmap->Char('\\');
 
-            if (sequence.length() == 0)
+            if (sequence == nullptr)
                 RaiseError("no mapping exists for backslash");
 
             return sequence;
@@ -82,7 +92,7 @@ std::string StringParser::ReadCharOrEscape()
 
     sequence = isEscape ? g_charmap->Escape(code) : g_charmap->Char(code);
 
-    if (sequence.length() == 0)
+    if (sequence == nullptr)
     {
         if (isEscape)
             RaiseError("unknown escape '\\%c'", code);
@@ -107,21 +117,22 @@ std::string StringParser::ReadBracketedConstants()
         if (IsIdentifierStartingChar(m_buffer[m_pos]))
         {
             long startPos = m_pos;
+            int node = g_charmap->ConstantRoot();
 
-            m_pos++;
-
+            // The constant is looked up as its identifier is read, and only
+            // matches if the whole identifier is one.
             while (IsIdentifierChar(m_buffer[m_pos]))
-                m_pos++;
+                node = g_charmap->NextConstantNode(node, m_buffer[m_pos++]);
 
-            std::string sequence = g_charmap->Constant(std::string(&m_buffer[startPos], m_pos - startPos));
+            const CharmapSequence* sequence = g_charmap->Constant(node);
 
-            if (sequence.length() == 0)
+            if (sequence == nullptr)
             {
                 m_buffer[m_pos] = 0;
                 RaiseError("unknown constant '%s'", &m_buffer[startPos]);
             }
 
-            totalSequence += sequence;
+            totalSequence.append(reinterpret_cast<const char*>(sequence->bytes), sequence->length);
         }
         else if (IsAsciiDigit(m_buffer[m_pos]))
         {
@@ -165,6 +176,15 @@ std::string StringParser::ReadBracketedConstants()
     return totalSequence;
 }
 
+void StringParser::AppendToDest(const unsigned char* bytes, int length, unsigned char* dest, int& destLength)
+{
+    if (destLength + length > kMaxStringLength)
+        RaiseError("mapped string longer than %d bytes", kMaxStringLength);
+
+    std::memcpy(dest + destLength, bytes, length);
+    destLength += length;
+}
+
 // Reads a charmap string.
 int StringParser::ParseString(long srcPos, unsigned char* dest, int& destLength)
 {
@@ -181,14 +201,15 @@ int StringParser::ParseString(long srcPos, unsigned char* dest, int& destLength)
 
     while (m_buffer[m_pos] != '"')
     {
-        std::string sequence = (m_buffer[m_pos] == '{') ? ReadBracketedConstants() : ReadCharOrEscape();
-
-        for (const char& c : sequence)
+        if (m_buffer[m_pos] == '{')
         {
-            if (destLength == kMaxStringLength)
-                RaiseError("mapped string longer than %d bytes", kMaxStringLength);
-
-            dest[destLength++] = c;
+            std::string sequence = ReadBracketedConstants();
+            AppendToDest(reinterpret_cast<const unsigned char*>(sequence.data()), sequence.length(), dest, destLength);
+        }
+        else
+        {
+            const CharmapSequence* sequence = ReadCharOrEscape();
+            AppendToDest(sequence->bytes, sequence->length, dest, destLength);
         }
     }
 
@@ -45,8 +45,9 @@ private:
     Integer ReadInteger();
     Integer ReadDecimal();
     Integer ReadHex();
-    std::string ReadCharOrEscape();
+    const CharmapSequence* ReadCharOrEscape();
     std::string ReadBracketedConstants();
+    void AppendToDest(const unsigned char* bytes, int length, unsigned char* dest, int& destLength);
     void SkipWhitespace();
     void SkipRestOfInteger(int radix);
     void RaiseError(const char* format, ...);
@@ -90,3 +90,38 @@ UnicodeChar DecodeUtf8(const char* s)
 
     return unicodeChar;
 }
+
+// Encodes "code" as UTF-8 at "s", which must have room for 4 bytes, and returns
+// the length of the encoding, or 0 if it isn't a valid code point.
+int EncodeUtf8(std::int32_t code, char* s)
+{
+    if (code < 0 || (code >= 0xD800 && code <= 0xDFFF) || code > 0x10FFFF)
+        return 0;
+
+    if (code < 0x80)
+    {
+        s[0] = code;
+        return 1;
+    }
+    else if (code < 0x800)
+    {
+        s[0] = 0xC0 | (code >> 6);
+        s[1] = 0x80 | (code & 0x3F);
+        return 2;
+    }
+    else if (code < 0x10000)
+    {
+        s[0] = 0xE0 | (code >> 12);
+        s[1] = 0x80 | ((code >> 6) & 0x3F);
+        s[2] = 0x80 | (code & 0x3F);
+        return 3;
+    }
+    else
+    {
+        s[0] = 0xF0 | (code >> 18);
+        s[1] = 0x80 | ((code >> 12) & 0x3F);
+        s[2] = 0x80 | ((code >> 6) & 0x3F);
+        s[3] = 0x80 | (code & 0x3F);
+        return 4;
+    }
+}
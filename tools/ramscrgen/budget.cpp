@@ -0,0 +1,546 @@
+// Budget mode reports how much of each memory region a linked build uses, and
+// which object files and subsystems the bytes belong to:
+//
+//   ramscrgen -budget ELF_FILE MAP_FILE BUDGET_FILE [-baseline USAGE_FILE] [-save USAGE_FILE]
+//
+// The linker map says which object file each input section came from. The ELF
+// says which output sections are NOLOAD, since the map gives a load address in
+// ROM for those too. Bytes the map doesn't attribute to an input section, such
+// as space reserved by the sym_*.txt files, go to the linker script symbol at
+// their start, or to *fill* if there isn't one.
+//
+// The budget file has one rule per line:
+//
+//   budget REGION BYTES             fail if REGION uses more than BYTES
+//   growth REGION BYTES             fail if REGION grew by more than BYTES
+//                                   since the baseline
+//   subsystem NAME PREFIX...        files starting with any PREFIX belong to
+//                                   NAME (the first matching rule wins)
+//
+// Files that no rule matches belong to the first directory in their path.
+// -save writes what each file uses so that a later build can be compared
+// against it with -baseline.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ramscrgen.h"
+#include "elf.h"
+#include "budget.h"
+
+struct MemoryRegion
+{
+    std::string name;
+    std::uint32_t origin;
+    std::uint32_t length;
+    std::uint32_t end;
+};
+
+struct OutputSection
+{
+    std::uint32_t address;
+    std::uint32_t size;
+    std::uint32_t loadAddress;
+    bool loaded;
+    std::uint32_t cursor;
+    std::string label;
+};
+
+struct Usage
+{
+    // Bytes from the start of each region to the end of the last thing in it.
+    std::map<std::string, long> used;
+    std::map<std::string, long> lengths;
+    // Bytes each file uses in each region.
+    std::map<std::string, std::map<std::string, long>> files;
+};
+
+struct Budget
+{
+    std::map<std::string, long> limits;
+    std::map<std::string, long> maxGrowth;
+    std::vector<std::pair<std::string, std::vector<std::string>>> subsystems;
+};
+
+static std::vector<std::string> SplitWords(const std::string& line)
+{
+    std::istringstream in(line);
+    std::vector<std::string> words;
+    std::string word;
+
+    while (in >> word)
+        words.push_back(word);
+
+    return words;
+}
+
+static bool ParseHex(const std::string& s, std::uint32_t& value)
+{
+    if (s.size() < 3 || s[0] != '0' || s[1] != 'x')
+        return false;
+
+    char *end;
+    value = std::strtoul(s.c_str() + 2, &end, 16);
+    return *end == 0;
+}
+
+static bool ParseSize(const std::string& s, long& value)
+{
+    char *end;
+    value = std::strtol(s.c_str(), &end, 0);
+    return !s.empty() && *end == 0 && value >= 0;
+}
+
+// Paths in the map are relative to the build directory, which is two levels
+// down from the root of the repository.
+static std::string CleanPath(std::string path)
+{
+    while (path.compare(0, 3, "../") == 0)
+        path = path.substr(3);
+
+    return path;
+}
+
+static MemoryRegion *FindRegion(std::vector<MemoryRegion>& regions, std::uint32_t address)
+{
+    for (MemoryRegion& region : regions)
+    {
+        if (address >= region.origin && address - region.origin < region.length)
+            return &region;
+    }
+
+    return nullptr;
+}
+
+static void AddBytes(Usage& usage, std::vector<MemoryRegion>& regions, const OutputSection& section, std::uint32_t address, std::uint32_t size, const std::string& owner)
+{
+    if (size == 0)
+        return;
+
+    MemoryRegion *region = FindRegion(regions, address);
+
+    if (region != nullptr)
+    {
+        usage.files[region->name][owner] += size;
+        region->end = std::max(region->end, address + size);
+    }
+
+    if (section.loaded)
+    {
+        std::uint32_t loadAddress = section.loadAddress + (address - section.address);
+        MemoryRegion *loadRegion = FindRegion(regions, loadAddress);
+
+        if (loadRegion != nullptr && loadRegion != region)
+        {
+            usage.files[loadRegion->name][owner] += size;
+            loadRegion->end = std::max(loadRegion->end, loadAddress + size);
+        }
+    }
+}
+
+// Attributes the bytes between the last thing in the section and address.
+static void FillTo(Usage& usage, std::vector<MemoryRegion>& regions, OutputSection& section, std::uint32_t address)
+{
+    if (address > section.cursor)
+    {
+        AddBytes(usage, regions, section, section.cursor, address - section.cursor, section.label.empty() ? "*fill*" : section.label);
+        section.cursor = address;
+    }
+
+    section.label.clear();
+}
+
+// Long section names are on a line of their own, with the rest of the entry
+// on the next line. This puts them back together.
+static std::vector<std::string> GetEntryWords(const std::vector<std::string>& lines, std::size_t& i)
+{
+    std::vector<std::string> words = SplitWords(lines[i]);
+    std::uint32_t address;
+
+    if (words.size() == 1 && i + 1 < lines.size())
+    {
+        std::vector<std::string> nextWords = SplitWords(lines[i + 1]);
+
+        if (nextWords.size() >= 2 && ParseHex(nextWords[0], address) && ParseHex(nextWords[1], address))
+        {
+            words.insert(words.end(), nextWords.begin(), nextWords.end());
+            i++;
+        }
+    }
+
+    return words;
+}
+
+static Usage ReadMapFile(std::string mapPath, const std::vector<ElfSection>& elfSections)
+{
+    std::ifstream file(mapPath);
+
+    if (!file.is_open())
+        FATAL_ERROR("error: failed to open \"%s\" for reading\n", mapPath.c_str());
+
+    std::vector<std::string> lines;
+    std::string line;
+
+    while (std::getline(file, line))
+        lines.push_back(line);
+
+    std::map<std::string, std::uint32_t> sectionTypes;
+
+    for (const ElfSection& elfSection : elfSections)
+        sectionTypes[elfSection.name] = elfSection.type;
+
+    Usage usage;
+    std::vector<MemoryRegion> regions;
+    std::size_t i = 0;
+
+    while (i < lines.size() && lines[i].compare(0, 20, "Memory Configuration") != 0)
+        i++;
+
+    for (i += 3; i < lines.size() && !lines[i].empty(); i++)
+    {
+        std::vector<std::string> words = SplitWords(lines[i]);
+        MemoryRegion region;
+
+        if (words.size() < 3 || words[0][0] == '*' || !ParseHex(words[1], region.origin) || !ParseHex(words[2], region.length))
+            continue;
+
+        region.name = words[0];
+        region.end = region.origin;
+        regions.push_back(region);
+    }
+
+    if (regions.empty())
+        FATAL_ERROR("error: no memory regions in \"%s\"\n", mapPath.c_str());
+
+    bool inSection = false;
+    OutputSection section;
+
+    for (; i < lines.size(); i++)
+    {
+        if (lines[i].empty())
+            continue;
+
+        bool indented = lines[i][0] == ' ';
+        bool inputIndent = indented && lines[i].size() > 1 && lines[i][1] != ' ';
+        std::vector<std::string> words = GetEntryWords(lines, i);
+        std::uint32_t address, size;
+
+        if (!indented && words.size() >= 3 && ParseHex(words[1], address) && ParseHex(words[2], size))
+        {
+            // An output section
+            if (inSection)
+                FillTo(usage, regions, section, section.address + section.size);
+
+            section.address = address;
+            section.size = size;
+            section.cursor = address;
+            section.label.clear();
+            section.loaded = false;
+
+            if (words.size() >= 6 && words[3] == "load" && words[4] == "address" && ParseHex(words[5], section.loadAddress))
+                section.loaded = sectionTypes.count(words[0]) == 0 || sectionTypes[words[0]] != SHT_NOBITS;
+
+            inSection = true;
+        }
+        else if (!indented)
+        {
+            if (inSection)
+                FillTo(usage, regions, section, section.address + section.size);
+
+            inSection = false;
+        }
+        else if (!inSection)
+        {
+            continue;
+        }
+        else if (inputIndent && words.size() >= 3 && ParseHex(words[1], address) && ParseHex(words[2], size))
+        {
+            // An input section, or padding. The linker writes space reserved
+            // after a symbol as padding too.
+            std::string label = address == section.cursor ? section.label : "";
+
+            FillTo(usage, regions, section, address);
+
+            if (words[0] == "*fill*")
+            {
+                AddBytes(usage, regions, section, address, size, label.empty() ? "*fill*" : label);
+            }
+            else
+            {
+                std::string owner = words[3];
+
+                for (std::size_t j = 4; j < words.size(); j++)
+                    owner += " " + words[j];
+
+                AddBytes(usage, regions, section, address, size, CleanPath(owner));
+            }
+
+            section.cursor = std::max(section.cursor, address + size);
+        }
+        else if (words.size() == 4 && words[2] == "=" && words[3] == "." && ParseHex(words[0], address))
+        {
+            // A linker script symbol, which owns any space reserved after it
+            if (address >= section.cursor && address <= section.address + section.size)
+            {
+                FillTo(usage, regions, section, address);
+                section.label = words[1];
+            }
+        }
+    }
+
+    if (inSection)
+        FillTo(usage, regions, section, section.address + section.size);
+
+    for (const MemoryRegion& region : regions)
+    {
+        usage.used[region.name] = region.end - region.origin;
+        usage.lengths[region.name] = region.length;
+    }
+
+    return usage;
+}
+
+static Budget ReadBudgetFile(std::string budgetPath)
+{
+    std::ifstream file(budgetPath);
+
+    if (!file.is_open())
+        FATAL_ERROR("error: failed to open \"%s\" for reading\n", budgetPath.c_str());
+
+    Budget budget;
+    std::string line;
+    int lineNum = 0;
+
+    while (std::getline(file, line))
+    {
+        lineNum++;
+
+        std::vector<std::string> words = SplitWords(line.substr(0, line.find('#')));
+        long size;
+
+        if (words.empty())
+            continue;
+
+        if ((words[0] == "budget" || words[0] == "growth") && words.size() == 3)
+        {
+            if (!ParseSize(words[2], size))
+                FATAL_ERROR("error: %s:%d: invalid size \"%s\"\n", budgetPath.c_str(), lineNum, words[2].c_str());
+
+            if (words[0] == "budget")
+                budget.limits[words[1]] = size;
+            else
+                budget.maxGrowth[words[1]] = size;
+        }
+        else if (words[0] == "subsystem" && words.size() >= 3)
+        {
+            budget.subsystems.push_back({ words[1], std::vector<std::string>(words.begin() + 2, words.end()) });
+        }
+        else
+        {
+            FATAL_ERROR("error: %s:%d: expected \"budget REGION BYTES\", \"growth REGION BYTES\" or \"subsystem NAME PREFIX...\"\n", budgetPath.c_str(), lineNum);
+        }
+    }
+
+    return budget;
+}
+
+static Usage ReadUsageFile(std::string usagePath)
+{
+    std::ifstream file(usagePath);
+
+    if (!file.is_open())
+        FATAL_ERROR("error: failed to open \"%s\" for reading\n", usagePath.c_str());
+
+    Usage usage;
+    std::string line;
+    int lineNum = 0;
+
+    while (std::getline(file, line))
+    {
+        lineNum++;
+
+        std::istringstream in(line);
+        std::string type, region, owner;
+        long size;
+
+        if (!(in >> type))
+            continue;
+
+        if (type == "region" && in >> region >> size)
+        {
+            usage.used[region] = size;
+        }
+        else if (type == "file" && in >> region >> size && std::getline(in >> std::ws, owner))
+        {
+            usage.files[region][owner] = size;
+        }
+        else
+        {
+            FATAL_ERROR("error: %s:%d: invalid usage line\n", usagePath.c_str(), lineNum);
+        }
+    }
+
+    return usage;
+}
+
+static void WriteUsageFile(std::string usagePath, const Usage& usage)
+{
+    FILE *fp = std::fopen(usagePath.c_str(), "w");
+
+    if (fp == NULL)
+        FATAL_ERROR("error: failed to open \"%s\" for writing\n", usagePath.c_str());
+
+    for (const auto& used : usage.used)
+        std::fprintf(fp, "region %s %ld\n", used.first.c_str(), used.second);
+
+    for (const auto& region : usage.files)
+    {
+        for (const auto& file : region.second)
+            std::fprintf(fp, "file %s %ld %s\n", region.first.c_str(), file.second, file.first.c_str());
+    }
+
+    if (std::fclose(fp) != 0)
+        FATAL_ERROR("error: failed to write \"%s\"\n", usagePath.c_str());
+}
+
+static std::string GetSubsystem(const Budget& budget, const std::string& file)
+{
+    for (const auto& subsystem : budget.subsystems)
+    {
+        for (const std::string& prefix : subsystem.second)
+        {
+            if (file.compare(0, prefix.size(), prefix) == 0)
+                return subsystem.first;
+        }
+    }
+
+    std::size_t slash = file.find('/');
+
+    return slash == std::string::npos ? file : file.substr(0, slash);
+}
+
+static std::vector<std::pair<std::string, long>> SortBySize(const std::map<std::string, long>& sizes)
+{
+    std::vector<std::pair<std::string, long>> sorted(sizes.begin(), sizes.end());
+
+    std::stable_sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, long>& a, const std::pair<std::string, long>& b) {
+        return std::labs(a.second) > std::labs(b.second);
+    });
+
+    return sorted;
+}
+
+static void PrintShares(const char *title, const std::string& region, const std::map<std::string, long>& sizes, long total, std::size_t maxLines)
+{
+    std::vector<std::pair<std::string, long>> sorted = SortBySize(sizes);
+
+    std::printf("\n%s %s:\n", region.c_str(), title);
+
+    for (std::size_t i = 0; i < sorted.size() && i < maxLines; i++)
+        std::printf("  %9ld  %5.1f%%  %s\n", sorted[i].second, total ? 100.0 * sorted[i].second / total : 0.0, sorted[i].first.c_str());
+
+    if (sorted.size() > maxLines)
+        std::printf("  (%lu more)\n", (unsigned long)(sorted.size() - maxLines));
+}
+
+bool CheckMemoryBudget(std::string elfPath, std::string mapPath, std::string budgetPath, std::string baselinePath, std::string savePath)
+{
+    Budget budget = ReadBudgetFile(budgetPath);
+    Usage usage = ReadMapFile(mapPath, GetElfSections(elfPath));
+    bool hasBaseline = !baselinePath.empty();
+    Usage baseline;
+
+    if (hasBaseline)
+        baseline = ReadUsageFile(baselinePath);
+
+    if (!savePath.empty())
+        WriteUsageFile(savePath, usage);
+
+    std::printf("%-8s %10s %10s %10s%s\n", "Region", "Used", "Budget", "Length", hasBaseline ? "     Change" : "");
+
+    for (const auto& used : usage.used)
+    {
+        auto limit = budget.limits.find(used.first);
+
+        std::printf("%-8s %10ld ", used.first.c_str(), used.second);
+        if (limit != budget.limits.end())
+            std::printf("%10ld ", limit->second);
+        else
+            std::printf("%10s ", "-");
+        std::printf("%10ld", usage.lengths[used.first]);
+        if (hasBaseline)
+            std::printf(" %+10ld", used.second - baseline.used[used.first]);
+        std::printf("\n");
+    }
+
+    for (const auto& region : usage.files)
+    {
+        std::map<std::string, long> subsystems;
+
+        for (const auto& file : region.second)
+            subsystems[GetSubsystem(budget, file.first)] += file.second;
+
+        PrintShares("by subsystem", region.first, subsystems, usage.used[region.first], 20);
+        PrintShares("largest files", region.first, region.second, usage.used[region.first], 20);
+
+        if (hasBaseline)
+        {
+            std::map<std::string, long> changes;
+
+            for (const auto& file : region.second)
+                changes[file.first] = file.second;
+            for (const auto& file : baseline.files[region.first])
+                changes[file.first] -= file.second;
+            for (auto it = changes.begin(); it != changes.end();)
+                it = it->second == 0 ? changes.erase(it) : std::next(it);
+
+            std::printf("\n%s changes since the baseline:\n", region.first.c_str());
+            if (changes.empty())
+                std::printf("  none\n");
+            for (const auto& change : SortBySize(changes))
+                std::printf("  %+9ld  %s\n", change.second, change.first.c_str());
+        }
+    }
+
+    std::fflush(stdout);
+
+    bool ok = true;
+
+    for (const auto& limit : budget.limits)
+    {
+        if (usage.used.count(limit.first) == 0)
+            FATAL_ERROR("error: %s: no memory region named \"%s\"\n", budgetPath.c_str(), limit.first.c_str());
+
+        if (usage.used[limit.first] > limit.second)
+        {
+            std::fprintf(stderr, "error: %s uses %ld bytes, over its budget of %ld by %ld\n", limit.first.c_str(), usage.used[limit.first], limit.second, usage.used[limit.first] - limit.second);
+            ok = false;
+        }
+    }
+
+    for (const auto& maxGrowth : budget.maxGrowth)
+    {
+        if (usage.used.count(maxGrowth.first) == 0)
+            FATAL_ERROR("error: %s: no memory region named \"%s\"\n", budgetPath.c_str(), maxGrowth.first.c_str());
+
+        if (!hasBaseline)
+            continue;
+
+        long growth = usage.used[maxGrowth.first] - baseline.used[maxGrowth.first];
+
+        if (growth > maxGrowth.second)
+        {
+            std::fprintf(stderr, "error: %s grew by %ld bytes since the baseline, more than the %ld allowed\n", maxGrowth.first.c_str(), growth, maxGrowth.second);
+            ok = false;
+        }
+    }
+
+    return ok;
+}
@@ -0,0 +1,8 @@
+#ifndef BUDGET_H
+#define BUDGET_H
+
+#include <string>
+
+bool CheckMemoryBudget(std::string elfPath, std::string mapPath, std::string budgetPath, std::string baselinePath, std::string savePath);
+
+#endif // BUDGET_H
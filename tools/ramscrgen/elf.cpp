@@ -270,3 +270,39 @@ std::map<std::string, std::uint32_t> GetCommonSymbols(std::string sourcePath, st
 
     return GetCommonSymbols_Shared();
 }
+
+std::vector<ElfSection> GetElfSections(std::string path)
+{
+    s_elfFileOffset = 0;
+    s_elfPath = path;
+    s_file = std::fopen(s_elfPath.c_str(), "rb");
+
+    if (s_file == NULL)
+        FATAL_ERROR("error: failed to open \"%s\" for reading\n", path.c_str());
+
+    VerifyElfIdent();
+    ReadElfHeader();
+
+    Seek(s_sectionHeaderOffset + s_sectionHeaderEntrySize * s_shstrtabIndex + 0x10);
+    std::uint32_t shstrtabOffset = ReadInt32();
+
+    std::vector<ElfSection> sections;
+
+    for (int i = 0; i < s_sectionCount; i++)
+    {
+        ElfSection section;
+        section.name = GetSectionName(shstrtabOffset, i);
+        Seek(s_sectionHeaderOffset + s_sectionHeaderEntrySize * i + 4);
+        section.type = ReadInt32();
+        Skip(4);
+        section.address = ReadInt32();
+        Skip(4);
+        section.size = ReadInt32();
+        sections.push_back(section);
+    }
+
+    std::fclose(s_file);
+    s_file = NULL;
+
+    return sections;
+}
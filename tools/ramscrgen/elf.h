@@ -24,7 +24,19 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
+
+#define SHT_NOBITS 8
+
+struct ElfSection
+{
+    std::string name;
+    std::uint32_t type;
+    std::uint32_t address;
+    std::uint32_t size;
+};
 
 std::map<std::string, std::uint32_t> GetCommonSymbols(std::string sourcePath, std::string path);
+std::vector<ElfSection> GetElfSections(std::string path);
 
 #endif // ELF_H
@@ -24,6 +24,7 @@
 #include "ramscrgen.h"
 #include "sym_file.h"
 #include "elf.h"
+#include "budget.h"
 
 void HandleCommonInclude(std::string filename, std::string sourcePath, std::string symOrderPath, std::string lang)
 {
@@ -140,11 +141,39 @@ void ConvertSymFile(std::string filename, std::string sectionName, std::string l
     }
 }
 
+int BudgetMain(int argc, char **argv)
+{
+    if (argc < 5)
+    {
+        fprintf(stderr, "Usage: %s -budget ELF_FILE MAP_FILE BUDGET_FILE [-baseline USAGE_FILE] [-save USAGE_FILE]\n", argv[0]);
+        return 1;
+    }
+
+    std::string baselinePath;
+    std::string savePath;
+
+    for (int i = 5; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "-baseline") == 0 && i + 1 < argc)
+            baselinePath = argv[++i];
+        else if (std::strcmp(argv[i], "-save") == 0 && i + 1 < argc)
+            savePath = argv[++i];
+        else
+            FATAL_ERROR("error: unrecognized argument \"%s\"\n", argv[i]);
+    }
+
+    return CheckMemoryBudget(argv[2], argv[3], argv[4], baselinePath, savePath) ? 0 : 1;
+}
+
 int main(int argc, char **argv)
 {
+    if (argc > 1 && std::strcmp(argv[1], "-budget") == 0)
+        return BudgetMain(argc, argv);
+
     if (argc < 4)
     {
-        fprintf(stderr, "Usage: %s SECTION_NAME SYM_FILE LANG [-c SRC_PATH,COMMON_SYM_PATH]", argv[0]);
+        fprintf(stderr, "Usage: %s SECTION_NAME SYM_FILE LANG [-c SRC_PATH,COMMON_SYM_PATH]\n", argv[0]);
+        fprintf(stderr, "       %s -budget ELF_FILE MAP_FILE BUDGET_FILE [-baseline USAGE_FILE] [-save USAGE_FILE]\n", argv[0]);
         return 1;
     }
 
@@ -0,0 +1,399 @@
+// Batch mode scans many sources in one run, so the headers they share are only
+// parsed once, and writes all of their dependencies to a makefile:
+//
+//   scaninc [-I INCLUDE_PATH]... -M DEPS_PATH [-cache CACHE_PATH] FILE_PATH...
+//
+// With a cache, each file's includes and incbins are kept between runs, along
+// with its size, mtime and a hash of its contents. A file whose size and mtime
+// haven't changed isn't read at all, and one that hashes the same as before
+// isn't parsed again. Includes are still looked up in the include paths on
+// every run, since adding a header can change which file an include finds.
+
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "scaninc.h"
+#include "source_file.h"
+#include "batch.h"
+
+// Bump this whenever the cache format or what the parsers find changes.
+#define CACHE_HEADER "scaninc cache 1"
+
+struct CacheEntry
+{
+    long long mtime;
+    long long size;
+    std::uint64_t hash;
+    long long verified; // when the contents were last checked against hash
+    std::vector<std::string> includes;
+    std::vector<std::string> incbins;
+    bool used;
+};
+
+struct Edge
+{
+    int node;
+    bool follow; // an include that exists, whose own dependencies are needed too
+};
+
+struct Node
+{
+    std::string path;
+    bool expanded;
+    std::vector<Edge> edges;
+};
+
+class BatchScanner
+{
+public:
+    BatchScanner(const std::vector<std::string>& includeDirs);
+    void LoadCache(const std::string& path);
+    void SaveCache(const std::string& path);
+    std::vector<std::string> Scan(const std::string& sourcePath);
+
+private:
+    std::vector<std::string> m_includeDirs;
+    std::map<std::string, CacheEntry> m_cache;
+    bool m_cacheDirty;
+    long long m_runStart;
+    std::vector<Node> m_nodes;
+    std::unordered_map<std::string, int> m_nodeIds;
+    std::unordered_map<std::string, Edge> m_resolved;
+    std::vector<unsigned> m_seen;
+    unsigned m_scanCount;
+
+    int GetNode(const std::string& path);
+    const CacheEntry& GetEntry(const std::string& path);
+    Edge Resolve(const std::string& srcDir, const std::string& include, bool isAsm);
+    void Expand(int nodeId);
+};
+
+static bool ReadWholeFile(const std::string& path, std::string& contents)
+{
+    FILE *fp = std::fopen(path.c_str(), "rb");
+
+    if (fp == NULL)
+        return false;
+
+    char buffer[4096];
+    std::size_t count;
+
+    contents.clear();
+    while ((count = std::fread(buffer, 1, sizeof(buffer), fp)) > 0)
+        contents.append(buffer, count);
+
+    std::fclose(fp);
+    return true;
+}
+
+// Writes the file only if it would change, through a temporary file so that
+// an interrupted run can't leave half of one behind.
+static void WriteFileIfChanged(const std::string& path, const std::string& contents)
+{
+    std::string oldContents;
+
+    if (ReadWholeFile(path, oldContents) && oldContents == contents)
+        return;
+
+    std::string tempPath = path + ".tmp";
+    FILE *fp = std::fopen(tempPath.c_str(), "wb");
+
+    if (fp == NULL)
+        FATAL_ERROR("Failed to open \"%s\" for writing.\n", tempPath.c_str());
+
+    if (!contents.empty() && std::fwrite(contents.data(), contents.size(), 1, fp) != 1)
+        FATAL_ERROR("Failed to write \"%s\".\n", tempPath.c_str());
+
+    std::fclose(fp);
+    std::remove(path.c_str());
+
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0)
+        FATAL_ERROR("Failed to rename \"%s\" to \"%s\".\n", tempPath.c_str(), path.c_str());
+}
+
+// FNV-1a
+static std::uint64_t HashContents(const std::string& contents)
+{
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+
+    for (unsigned char c : contents)
+    {
+        hash ^= c;
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+static std::string GetDir(const std::string& path)
+{
+    std::size_t slash = path.rfind('/');
+
+    if (slash != std::string::npos)
+        return path.substr(0, slash + 1);
+    else
+        return std::string("");
+}
+
+static bool IsAsmPath(std::string path)
+{
+    SourceFileType type = GetFileType(path);
+
+    return type == SourceFileType::Asm || type == SourceFileType::Inc;
+}
+
+BatchScanner::BatchScanner(const std::vector<std::string>& includeDirs)
+    : m_includeDirs(includeDirs), m_cacheDirty(false), m_runStart(std::time(NULL)), m_scanCount(0)
+{
+}
+
+void BatchScanner::LoadCache(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::string line;
+
+    if (!std::getline(file, line) || line != CACHE_HEADER)
+    {
+        // Missing, or from another version of scaninc.
+        m_cacheDirty = true;
+        return;
+    }
+
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        CacheEntry entry;
+        std::size_t includeCount, incbinCount;
+        std::string entryPath;
+
+        fields >> entry.mtime >> entry.size >> std::hex >> entry.hash >> std::dec >> entry.verified >> includeCount >> incbinCount;
+        fields.get();
+        if (!fields || !std::getline(fields, entryPath))
+            FATAL_ERROR("Malformed line in scaninc cache \"%s\". Delete it to start over.\n", path.c_str());
+
+        entry.includes.resize(includeCount);
+        entry.incbins.resize(incbinCount);
+        for (std::string& include : entry.includes)
+            std::getline(file, include);
+        for (std::string& incbin : entry.incbins)
+            std::getline(file, incbin);
+
+        entry.used = false;
+        m_cache[entryPath] = entry;
+    }
+}
+
+void BatchScanner::SaveCache(const std::string& path)
+{
+    std::ostringstream file;
+
+    // Drop the files that weren't seen this run, like deleted headers.
+    for (auto it = m_cache.begin(); it != m_cache.end();)
+    {
+        if (it->second.used)
+        {
+            it++;
+        }
+        else
+        {
+            it = m_cache.erase(it);
+            m_cacheDirty = true;
+        }
+    }
+
+    if (!m_cacheDirty)
+        return;
+
+    file << CACHE_HEADER << "\n";
+    for (const auto& it : m_cache)
+    {
+        const CacheEntry& entry = it.second;
+
+        file << entry.mtime << " " << entry.size << " " << std::hex << entry.hash << std::dec << " " << entry.verified << " "
+             << entry.includes.size() << " " << entry.incbins.size() << " " << it.first << "\n";
+        for (const std::string& include : entry.includes)
+            file << include << "\n";
+        for (const std::string& incbin : entry.incbins)
+            file << incbin << "\n";
+    }
+
+    WriteFileIfChanged(path, file.str());
+}
+
+// Returns the includes and incbins of a file, only parsing it if it isn't
+// cached. An mtime can only be trusted if it's older than when the entry was
+// last verified, since a file written in that same second could have changed
+// without its mtime changing.
+const CacheEntry& BatchScanner::GetEntry(const std::string& path)
+{
+    CacheEntry& entry = m_cache[path];
+
+    if (entry.used)
+        return entry;
+
+    struct stat st;
+    bool statOk = stat(path.c_str(), &st) == 0;
+
+    entry.used = true;
+    if (statOk && entry.verified != 0
+     && (long long)st.st_mtime == entry.mtime
+     && (long long)st.st_size == entry.size
+     && entry.mtime < entry.verified)
+        return entry;
+
+    std::string contents;
+    std::uint64_t hash = 0;
+
+    if (ReadWholeFile(path, contents))
+        hash = HashContents(contents);
+
+    m_cacheDirty = true;
+    if (statOk && entry.verified != 0 && (long long)contents.size() == entry.size && hash == entry.hash)
+    {
+        entry.mtime = st.st_mtime;
+        entry.verified = m_runStart;
+        return entry;
+    }
+
+    SourceFile file(path);
+
+    entry.mtime = statOk ? (long long)st.st_mtime : 0;
+    entry.size = contents.size();
+    entry.hash = hash;
+    entry.verified = m_runStart;
+    entry.includes.assign(file.GetIncludes().begin(), file.GetIncludes().end());
+    entry.incbins.assign(file.GetIncbins().begin(), file.GetIncbins().end());
+    return entry;
+}
+
+int BatchScanner::GetNode(const std::string& path)
+{
+    auto it = m_nodeIds.find(path);
+
+    if (it != m_nodeIds.end())
+        return it->second;
+
+    int nodeId = m_nodes.size();
+    m_nodes.push_back(Node{path, false, {}});
+    m_seen.push_back(0);
+    m_nodeIds[path] = nodeId;
+    return nodeId;
+}
+
+// Finds an include the way the single-file mode does: in each include path,
+// then in the including file's directory. An include that isn't found is a
+// dependency on the path it was last looked for at, or for assembly, on the
+// path as written, so that make complains about it.
+Edge BatchScanner::Resolve(const std::string& srcDir, const std::string& include, bool isAsm)
+{
+    std::string key = srcDir + '\n' + include + (isAsm ? "\na" : "\nc");
+    auto it = m_resolved.find(key);
+
+    if (it != m_resolved.end())
+        return it->second;
+
+    bool exists = false;
+    std::string path;
+
+    for (const std::string& includeDir : m_includeDirs)
+    {
+        path = includeDir + include;
+        if (CanOpenFile(path))
+        {
+            exists = true;
+            break;
+        }
+    }
+    if (!exists)
+    {
+        path = srcDir + include;
+        exists = CanOpenFile(path);
+    }
+    if (!exists && isAsm)
+        path = include;
+
+    Edge edge = {GetNode(path), exists};
+    m_resolved[key] = edge;
+    return edge;
+}
+
+void BatchScanner::Expand(int nodeId)
+{
+    if (m_nodes[nodeId].expanded)
+        return;
+
+    std::string path = m_nodes[nodeId].path;
+    std::string srcDir = GetDir(path);
+    bool isAsm = IsAsmPath(path);
+    const CacheEntry& entry = GetEntry(path);
+    std::vector<Edge> edges;
+
+    for (const std::string& incbin : entry.incbins)
+        edges.push_back(Edge{GetNode(incbin), false});
+    for (const std::string& include : entry.includes)
+        edges.push_back(Resolve(srcDir, include, isAsm));
+
+    m_nodes[nodeId].edges = edges;
+    m_nodes[nodeId].expanded = true;
+}
+
+std::vector<std::string> BatchScanner::Scan(const std::string& sourcePath)
+{
+    std::vector<int> filesToProcess;
+    std::vector<std::string> dependencies;
+
+    m_scanCount++;
+    filesToProcess.push_back(GetNode(sourcePath));
+
+    while (!filesToProcess.empty())
+    {
+        int nodeId = filesToProcess.back();
+        filesToProcess.pop_back();
+
+        Expand(nodeId);
+        for (const Edge& edge : m_nodes[nodeId].edges)
+        {
+            if (m_seen[edge.node] == m_scanCount)
+                continue;
+
+            m_seen[edge.node] = m_scanCount;
+            dependencies.push_back(m_nodes[edge.node].path);
+            if (edge.follow)
+                filesToProcess.push_back(edge.node);
+        }
+    }
+
+    std::sort(dependencies.begin(), dependencies.end());
+    return dependencies;
+}
+
+void ScanBatch(const std::vector<std::string>& includeDirs, const std::vector<std::string>& sourcePaths,
+               const std::string& depsPath, const std::string& cachePath)
+{
+    BatchScanner scanner(includeDirs);
+    std::string deps = "# Generated by scaninc -M. Do not edit.\n";
+
+    if (!cachePath.empty())
+        scanner.LoadCache(cachePath);
+
+    for (const std::string& sourcePath : sourcePaths)
+    {
+        deps += "SCANINC_DEPS_" + sourcePath + " :=";
+        for (const std::string& dependency : scanner.Scan(sourcePath))
+            deps += " " + dependency;
+        deps += "\n";
+    }
+
+    WriteFileIfChanged(depsPath, deps);
+
+    if (!cachePath.empty())
+        scanner.SaveCache(cachePath);
+}
@@ -0,0 +1,13 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <string>
+#include <vector>
+
+// Scans every path in sourcePaths and writes a makefile to depsPath that sets
+// SCANINC_DEPS_<path> to each source's dependencies. If cachePath isn't empty,
+// each file's includes and incbins are kept there between runs.
+void ScanBatch(const std::vector<std::string>& includeDirs, const std::vector<std::string>& sourcePaths,
+               const std::string& depsPath, const std::string& cachePath);
+
+#endif // BATCH_H
@@ -26,6 +26,7 @@
 #include <string>
 #include "scaninc.h"
 #include "source_file.h"
+#include "batch.h"
 
 bool CanOpenFile(std::string path)
 {
@@ -38,7 +39,8 @@ bool CanOpenFile(std::string path)
     return true;
 }
 
-const char *const USAGE = "Usage: scaninc [-I INCLUDE_PATH] FILE_PATH\n";
+const char *const USAGE = "Usage: scaninc [-I INCLUDE_PATH]... FILE_PATH\n"
+                          "       scaninc [-I INCLUDE_PATH]... -M DEPS_PATH [-cache CACHE_PATH] FILE_PATH...\n";
 
 int main(int argc, char **argv)
 {
@@ -46,11 +48,13 @@ int main(int argc, char **argv)
     std::set<std::string> dependencies;
 
     std::vector<std::string> includeDirs;
+    std::string depsPath;
+    std::string cachePath;
 
     argc--;
     argv++;
 
-    while (argc > 1)
+    while (argc > 1 && argv[0][0] == '-')
     {
         std::string arg(argv[0]);
         if (arg.substr(0, 2) == "-I")
@@ -68,6 +72,18 @@ int main(int argc, char **argv)
             }
             includeDirs.push_back(includeDir);
         }
+        else if (arg == "-M")
+        {
+            argc--;
+            argv++;
+            depsPath = std::string(argv[0]);
+        }
+        else if (arg == "-cache")
+        {
+            argc--;
+            argv++;
+            cachePath = std::string(argv[0]);
+        }
         else
         {
             FATAL_ERROR(USAGE);
@@ -76,7 +92,13 @@ int main(int argc, char **argv)
         argv++;
     }
 
-    if (argc != 1) {
+    if (!depsPath.empty())
+    {
+        ScanBatch(includeDirs, std::vector<std::string>(argv, argv + argc), depsPath, cachePath);
+        return 0;
+    }
+
+    if (argc != 1 || !cachePath.empty()) {
         FATAL_ERROR(USAGE);
     }
 
@@ -23,6 +23,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <string>
 
 #ifdef _MSC_VER
 
@@ -56,4 +57,6 @@ do {                                        \
 
 #define SCANINC_MAX_PATH 255
 
+bool CanOpenFile(std::string path);
+
 #endif // SCANINC_H
@@ -0,0 +1,570 @@
+// textatlas.cpp
+//
+// Prerenders static strings into 4bpp tiles at build time, so that menus can
+// blit them straight into a window instead of running them through the text
+// printer every time they open.
+//
+// Each manifest line tags an existing string symbol with the font and colors
+// it is always drawn with:
+//
+//     STATIC_TEXT_SUMMARY_PKMN_INFO  FONT_NORMAL  0 3 4  gText_PkmnInfo
+//
+// The string is looked up in the given C sources and encoded with preproc's
+// charmap, then drawn with the glyphs from the font PNGs exactly the way
+// RenderText would draw it with TEXT_SKIP_DRAW.
+//
+// The manifest is also the only place the STATIC_TEXT_* ids are listed. They
+// are numbered in manifest order and written to a constants header.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <stdexcept>
+
+#include <algorithm>
+
+#include <string>
+using std::string;
+
+#include <vector>
+using std::vector;
+
+#include <map>
+using std::map;
+
+#include <fstream>
+using std::ifstream; using std::ofstream;
+
+#include <sstream>
+using std::ostringstream; using std::istringstream;
+
+#include <png.h>
+
+#include "preproc.h"
+#include "charmap.h"
+#include "string_parser.h"
+
+#define GLYPH_CELL_SIZE 16
+#define GLYPHS_PER_ROW 16
+
+#define CHAR_NEWLINE 0xFE
+#define EOS 0xFF
+// Everything from here up is a control code that the text printer handles
+// specially (keypad icons, placeholders, prompts, ...).
+#define FIRST_CONTROL_CHAR 0xF7
+
+Charmap *g_charmap;
+
+struct FontInfo
+{
+    const char *name;
+    const char *image;
+    const char *widths;
+    int glyphHeight; // gCurGlyph.height set by the font's DecompressGlyph function.
+    int lineHeight;  // The font's maxLetterHeight.
+};
+
+// Only the Latin fonts are supported. This mirrors DecompressGlyph_* and
+// sFontInfos in gflib/text.c.
+static const FontInfo kFonts[] =
+{
+    { "FONT_SMALL",          "latin_small.png",          "gFontSmallLatinGlyphWidths",          13, 12 },
+    { "FONT_NORMAL",         "latin_normal.png",         "gFontNormalLatinGlyphWidths",         15, 16 },
+    { "FONT_SHORT",          "latin_short.png",          "gFontShortLatinGlyphWidths",          14, 14 },
+    { "FONT_SHORT_COPY_1",   "latin_short.png",          "gFontShortLatinGlyphWidths",          14, 14 },
+    { "FONT_SHORT_COPY_2",   "latin_short.png",          "gFontShortLatinGlyphWidths",          14, 14 },
+    { "FONT_SHORT_COPY_3",   "latin_short.png",          "gFontShortLatinGlyphWidths",          14, 14 },
+    { "FONT_NARROW",         "latin_narrow.png",         "gFontNarrowLatinGlyphWidths",         15, 16 },
+    { "FONT_SMALL_NARROW",   "latin_small_narrow.png",   "gFontSmallNarrowLatinGlyphWidths",    12,  8 },
+    { "FONT_NARROWER",       "latin_narrower.png",       "gFontNarrowerLatinGlyphWidths",       15, 16 },
+    { "FONT_SMALL_NARROWER", "latin_small_narrower.png", "gFontSmallNarrowerLatinGlyphWidths",  15,  8 },
+    { "FONT_SHORT_NARROW",   "latin_short_narrow.png",   "gFontShortNarrowLatinGlyphWidths",    14, 14 },
+};
+
+struct Font
+{
+    const FontInfo *info;
+    int imageWidth;
+    int imageHeight;
+    vector<unsigned char> pixels; // One 2bpp color index per byte.
+    vector<int> widths;
+};
+
+struct Entry
+{
+    string id;
+    const FontInfo *font;
+    int bgColor;
+    int fgColor;
+    int shadowColor;
+    string symbol;
+    int line;
+};
+
+struct Rendered
+{
+    int width;
+    int height;
+    vector<unsigned char> pixels; // 4bpp color per byte, 0 is left untouched.
+};
+
+static string read_text_file(const string &path)
+{
+    ifstream in(path, std::ios::binary);
+
+    if (!in.is_open())
+        FATAL_ERROR("Cannot open file %s for reading.\n", path.c_str());
+
+    ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+static void write_text_file(const string &path, const string &text)
+{
+    ofstream out(path, std::ofstream::binary);
+
+    if (!out.is_open())
+        FATAL_ERROR("Cannot open file %s for writing.\n", path.c_str());
+
+    out << text;
+}
+
+// Leaves the file alone if it wouldn't change, so that everything including it
+// isn't rebuilt each time the tiles are regenerated.
+static void write_text_file_if_changed(const string &path, const string &text)
+{
+    ifstream in(path, std::ios::binary);
+
+    if (in.is_open())
+    {
+        ostringstream oldText;
+        oldText << in.rdbuf();
+        if (oldText.str() == text)
+            return;
+    }
+
+    write_text_file(path, text);
+}
+
+static const FontInfo *find_font_info(const string &name)
+{
+    for (const FontInfo &info : kFonts)
+        if (name == info.name)
+            return &info;
+    return nullptr;
+}
+
+static void read_png(const string &path, Font &font)
+{
+    FILE *fp = std::fopen(path.c_str(), "rb");
+
+    if (fp == nullptr)
+        FATAL_ERROR("Cannot open font image %s.\n", path.c_str());
+
+    png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    png_infop info = png ? png_create_info_struct(png) : nullptr;
+
+    if (png == nullptr || info == nullptr)
+        FATAL_ERROR("Failed to create PNG structs for %s.\n", path.c_str());
+
+    if (setjmp(png_jmpbuf(png)))
+        FATAL_ERROR("Failed to read font image %s.\n", path.c_str());
+
+    png_init_io(png, fp);
+    png_read_info(png, info);
+
+    if (png_get_color_type(png, info) != PNG_COLOR_TYPE_PALETTE)
+        FATAL_ERROR("Font image %s is not indexed.\n", path.c_str());
+
+    // Unpack to one palette index per byte.
+    png_set_packing(png);
+    png_read_update_info(png, info);
+
+    font.imageWidth = png_get_image_width(png, info);
+    font.imageHeight = png_get_image_height(png, info);
+    font.pixels.resize(font.imageWidth * font.imageHeight);
+
+    vector<png_bytep> rows(font.imageHeight);
+    for (int y = 0; y < font.imageHeight; y++)
+        rows[y] = &font.pixels[y * font.imageWidth];
+    png_read_image(png, rows.data());
+
+    png_destroy_read_struct(&png, &info, nullptr);
+    std::fclose(fp);
+
+    // The fonts are converted to 2bpp, so only the low two bits survive.
+    for (unsigned char &pixel : font.pixels)
+        pixel &= 3;
+}
+
+// Reads `const u8 <name>[] = { ... };` out of src/fonts.c.
+static vector<int> read_widths(const string &fontsSource, const string &path, const string &name)
+{
+    vector<int> widths;
+    size_t pos = fontsSource.find(" " + name + "[]");
+
+    if (pos == string::npos)
+        FATAL_ERROR("%s: cannot find glyph widths %s.\n", path.c_str(), name.c_str());
+
+    pos = fontsSource.find('{', pos);
+    size_t end = fontsSource.find('}', pos);
+
+    if (pos == string::npos || end == string::npos)
+        FATAL_ERROR("%s: malformed glyph widths %s.\n", path.c_str(), name.c_str());
+
+    const char *cursor = fontsSource.c_str() + pos + 1;
+    const char *last = fontsSource.c_str() + end;
+
+    while (cursor < last)
+    {
+        if (std::isdigit(static_cast<unsigned char>(*cursor)))
+        {
+            char *next;
+            widths.push_back(std::strtol(cursor, &next, 0));
+            cursor = next;
+        }
+        else
+        {
+            cursor++;
+        }
+    }
+
+    return widths;
+}
+
+static Font &load_font(map<string, Font> &fonts, const FontInfo *info, const string &fontDir, const string &fontsSource, const string &fontsPath)
+{
+    auto it = fonts.find(info->name);
+
+    if (it != fonts.end())
+        return it->second;
+
+    Font &font = fonts[info->name];
+    font.info = info;
+    read_png(fontDir + "/" + info->image, font);
+    font.widths = read_widths(fontsSource, fontsPath, info->widths);
+    return font;
+}
+
+static int parse_color(const string &token, const string &path, int line)
+{
+    char *end;
+    long color = std::strtol(token.c_str(), &end, 0);
+
+    if (token.empty() || *end != '\0' || color < 0 || color > 15)
+        FATAL_ERROR("%s:%d: invalid color '%s'.\n", path.c_str(), line, token.c_str());
+
+    return color;
+}
+
+static vector<Entry> read_manifest(const string &path)
+{
+    vector<Entry> entries;
+    istringstream text(read_text_file(path));
+    string lineText;
+    int line = 0;
+
+    while (std::getline(text, lineText))
+    {
+        line++;
+
+        size_t comment = lineText.find('#');
+        if (comment != string::npos)
+            lineText.erase(comment);
+
+        istringstream tokens(lineText);
+        vector<string> fields;
+        string field;
+        while (tokens >> field)
+            fields.push_back(field);
+
+        if (fields.empty())
+            continue;
+
+        if (fields.size() != 6)
+            FATAL_ERROR("%s:%d: expected '<id> <font> <bg> <fg> <shadow> <symbol>'.\n", path.c_str(), line);
+
+        Entry entry;
+        entry.id = fields[0];
+        entry.font = find_font_info(fields[1]);
+        if (entry.font == nullptr)
+            FATAL_ERROR("%s:%d: unsupported font '%s'.\n", path.c_str(), line, fields[1].c_str());
+        entry.bgColor = parse_color(fields[2], path, line);
+        entry.fgColor = parse_color(fields[3], path, line);
+        entry.shadowColor = parse_color(fields[4], path, line);
+        entry.symbol = fields[5];
+        entry.line = line;
+
+        for (const Entry &other : entries)
+            if (other.id == entry.id)
+                FATAL_ERROR("%s:%d: %s is listed twice.\n", path.c_str(), line, entry.id.c_str());
+
+        entries.push_back(entry);
+    }
+
+    return entries;
+}
+
+static bool is_identifier_char(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Finds `<symbol>[] = _("...")` in one of the sources and encodes it.
+static vector<unsigned char> find_string(const string &symbol, vector<string> &sources, const vector<string> &sourcePaths)
+{
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        string &source = sources[i];
+        size_t pos = 0;
+
+        while ((pos = source.find(symbol + "[]", pos)) != string::npos)
+        {
+            size_t start = pos;
+            pos += symbol.size();
+
+            if (start > 0 && is_identifier_char(source[start - 1]))
+                continue;
+
+            size_t equals = source.find_first_not_of(" \t", pos + 2);
+            if (equals == string::npos || source[equals] != '=')
+                continue;
+
+            size_t open = source.find_first_not_of(" \t", equals + 1);
+            if (open == string::npos || source.compare(open, 2, "_(") != 0)
+                FATAL_ERROR("%s: %s is not a single _(\"...\") string.\n", sourcePaths[i].c_str(), symbol.c_str());
+
+            size_t quote = source.find_first_not_of(" \t", open + 2);
+            unsigned char encoded[kMaxStringLength];
+            int length;
+
+            try
+            {
+                StringParser parser(&source[0], source.size());
+                size_t close = quote + parser.ParseString(quote, encoded, length);
+                close = source.find_first_not_of(" \t", close);
+                if (close == string::npos || source[close] != ')')
+                    FATAL_ERROR("%s: %s is not a single _(\"...\") string.\n", sourcePaths[i].c_str(), symbol.c_str());
+            }
+            catch (std::runtime_error &e)
+            {
+                FATAL_ERROR("%s: %s: %s\n", sourcePaths[i].c_str(), symbol.c_str(), e.what());
+            }
+
+            return vector<unsigned char>(encoded, encoded + length);
+        }
+    }
+
+    FATAL_ERROR("Cannot find the definition of %s.\n", symbol.c_str());
+}
+
+static void draw_glyph(Rendered &out, const Font &font, const Entry &entry, int glyphId, int x, int y, int width)
+{
+    int cellX = (glyphId % GLYPHS_PER_ROW) * GLYPH_CELL_SIZE;
+    int cellY = (glyphId / GLYPHS_PER_ROW) * GLYPH_CELL_SIZE;
+
+    if (cellY + GLYPH_CELL_SIZE > font.imageHeight)
+        FATAL_ERROR("%s: glyph 0x%X is outside of %s.\n", entry.id.c_str(), glyphId, font.info->image);
+
+    for (int row = 0; row < font.info->glyphHeight; row++)
+    {
+        for (int col = 0; col < width; col++)
+        {
+            int color;
+
+            switch (font.pixels[(cellY + row) * font.imageWidth + cellX + col])
+            {
+            case 1:
+                color = entry.fgColor;
+                break;
+            case 2:
+                color = entry.shadowColor;
+                break;
+            default:
+                color = entry.bgColor;
+                break;
+            }
+
+            // Transparent pixels don't overwrite what's already there.
+            if (color != 0)
+                out.pixels[(y + row) * out.width + x + col] = color;
+        }
+    }
+}
+
+// Matches RenderText for plain strings: glyphs advance by their width and
+// newlines move down by the font's line height.
+static Rendered render(const Entry &entry, const Font &font, const vector<unsigned char> &text)
+{
+    Rendered out;
+    int x = 0, y = 0;
+
+    out.width = 0;
+    out.height = 0;
+
+    for (unsigned char c : text)
+    {
+        if (c == EOS)
+            break;
+        if (c == CHAR_NEWLINE)
+        {
+            x = 0;
+            y += font.info->lineHeight;
+        }
+        else if (c >= FIRST_CONTROL_CHAR)
+        {
+            FATAL_ERROR("%s: control code 0x%02X can't be prerendered.\n", entry.id.c_str(), c);
+        }
+        else
+        {
+            if (c >= font.widths.size())
+                FATAL_ERROR("%s: glyph 0x%02X has no width in %s.\n", entry.id.c_str(), c, font.info->widths);
+            x += font.widths[c];
+            if (x > out.width)
+                out.width = x;
+            if (y + font.info->glyphHeight > out.height)
+                out.height = y + font.info->glyphHeight;
+        }
+    }
+
+    if (out.width == 0 || out.height == 0)
+        FATAL_ERROR("%s: %s is empty.\n", entry.id.c_str(), entry.symbol.c_str());
+    if (out.width > 255 || out.height > 255)
+        FATAL_ERROR("%s: %s is larger than 255x255 pixels.\n", entry.id.c_str(), entry.symbol.c_str());
+
+    out.pixels.assign(out.width * out.height, 0);
+    x = 0;
+    y = 0;
+
+    for (unsigned char c : text)
+    {
+        if (c == EOS)
+            break;
+        if (c == CHAR_NEWLINE)
+        {
+            x = 0;
+            y += font.info->lineHeight;
+            continue;
+        }
+        draw_glyph(out, font, entry, c, x, y, font.widths[c]);
+        x += font.widths[c];
+    }
+
+    return out;
+}
+
+// Tiles are stored left to right, top to bottom, with one word per row of a
+// tile like the window tile buffers.
+static void write_tiles(ostringstream &text, const string &name, const Rendered &rendered)
+{
+    int tilesWide = (rendered.width + 7) / 8;
+    int tilesHigh = (rendered.height + 7) / 8;
+    int words = 0;
+
+    text << "static const u32 " << name << "[] =\n{";
+
+    for (int tileY = 0; tileY < tilesHigh; tileY++)
+    {
+        for (int tileX = 0; tileX < tilesWide; tileX++)
+        {
+            for (int row = 0; row < 8; row++)
+            {
+                unsigned int word = 0;
+                int y = tileY * 8 + row;
+
+                for (int col = 0; col < 8; col++)
+                {
+                    int x = tileX * 8 + col;
+                    if (x < rendered.width && y < rendered.height)
+                        word |= rendered.pixels[y * rendered.width + x] << (col * 4);
+                }
+
+                char buffer[16];
+                std::snprintf(buffer, sizeof(buffer), "0x%08X,", word);
+                text << ((words++ % 8 == 0) ? "\n    " : " ") << buffer;
+            }
+        }
+    }
+
+    text << "\n};\n\n";
+}
+
+static string make_constants(const string &manifestPath, const vector<Entry> &entries)
+{
+    ostringstream text;
+    size_t nameWidth = std::strlen("STATIC_TEXT_COUNT");
+
+    for (const Entry &entry : entries)
+        nameWidth = std::max(nameWidth, entry.id.size());
+
+    text << "#ifndef GUARD_CONSTANTS_STATIC_TEXT_H\n"
+         << "#define GUARD_CONSTANTS_STATIC_TEXT_H\n\n"
+         << "//\n// DO NOT MODIFY THIS FILE! It is auto-generated from " << manifestPath << "\n//\n\n";
+
+    for (size_t i = 0; i < entries.size(); i++)
+        text << "#define " << entries[i].id << string(nameWidth + 1 - entries[i].id.size(), ' ') << i << "\n";
+
+    text << "\n#define STATIC_TEXT_COUNT" << string(nameWidth + 1 - std::strlen("STATIC_TEXT_COUNT"), ' ') << entries.size() << "\n\n"
+         << "#endif // GUARD_CONSTANTS_STATIC_TEXT_H\n";
+
+    return text.str();
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 8)
+        FATAL_ERROR("USAGE: textatlas <manifest> <charmap> <fonts_c_file> <font_dir> <output_file> <constants_file> <source_file>...\n");
+
+    string manifestPath(argv[1]);
+    string fontsPath(argv[3]);
+    string fontDir(argv[4]);
+    string outputPath(argv[5]);
+    string constantsPath(argv[6]);
+    vector<string> sourcePaths(argv + 7, argv + argc);
+    vector<string> sources;
+
+    g_charmap = new Charmap(argv[2]);
+
+    for (const string &path : sourcePaths)
+        sources.push_back(read_text_file(path));
+
+    string fontsSource = read_text_file(fontsPath);
+    vector<Entry> entries = read_manifest(manifestPath);
+    map<string, Font> fonts;
+    ostringstream text;
+    ostringstream table;
+
+    text << "//\n// DO NOT MODIFY THIS FILE! It is auto-generated from " << manifestPath << "\n//\n\n";
+    table << "const struct StaticText gStaticTexts[STATIC_TEXT_COUNT] =\n{\n";
+
+    for (const Entry &entry : entries)
+    {
+        const Font &font = load_font(fonts, entry.font, fontDir, fontsSource, fontsPath);
+        Rendered rendered = render(entry, font, find_string(entry.symbol, sources, sourcePaths));
+        string tilesName = "sStaticTextTiles_" + entry.id.substr(entry.id.compare(0, 12, "STATIC_TEXT_") == 0 ? 12 : 0);
+
+        write_tiles(text, tilesName, rendered);
+
+        table << "    [" << entry.id << "] =\n"
+              << "    {\n"
+              << "        .tiles = " << tilesName << ",\n"
+              << "        .text = " << entry.symbol << ",\n"
+              << "        .fontId = " << entry.font->name << ",\n"
+              << "        .bgColor = " << entry.bgColor << ",\n"
+              << "        .fgColor = " << entry.fgColor << ",\n"
+              << "        .shadowColor = " << entry.shadowColor << ",\n"
+              << "        .width = " << rendered.width << ",\n"
+              << "        .height = " << rendered.height << ",\n"
+              << "    },\n";
+    }
+
+    table << "};\n";
+    text << table.str();
+
+    write_text_file(outputPath, text.str());
+    write_text_file_if_changed(constantsPath, make_constants(manifestPath, entries));
+
+    return 0;
+}
@@ -1856,6 +1856,28 @@ static void fprint_trainers(const char *output_path, FILE *f, struct Parsed *par
     }
 }
 
+static bool same_contents(const char *path1, const char *path2)
+{
+    FILE *f1 = fopen(path1, "rb");
+    FILE *f2 = fopen(path2, "rb");
+    bool same = f1 && f2;
+
+    while (same)
+    {
+        char buffer1[4096], buffer2[4096];
+        size_t n1 = fread(buffer1, 1, sizeof(buffer1), f1);
+        size_t n2 = fread(buffer2, 1, sizeof(buffer2), f2);
+        if (n1 != n2 || memcmp(buffer1, buffer2, n1) != 0)
+            same = false;
+        else if (n1 == 0)
+            break;
+    }
+
+    if (f1) fclose(f1);
+    if (f2) fclose(f2);
+    return same;
+}
+
 static void usage(FILE *file, char *argv0)
 {
     fprintf(file, "Usage: %s -o <output> <source>\n", argv0);
@@ -1875,6 +1897,7 @@ int main(int argc, char *argv[])
     const char *source_path = NULL;
     const char *output_path = NULL;
     const char *real_source_path = NULL;
+    char *temp_path = NULL;
 
     int opt;
     while ((opt = getopt(argc, argv, "i:o:")) != -1)
@@ -1980,24 +2003,57 @@ int main(int argc, char *argv[])
 
     if (strcmp(output_path, "-") == 0)
     {
-        source_file = stdout;
+        output_file = stdout;
         output_path = "<stdout>";
     }
     else
     {
-        output_file = fopen(output_path, "w");
+        /* The rule for the output runs on every build, so it's written
+         * to a temporary file and only replaces the output if it
+         * changed. Otherwise everything that includes it would be
+         * recompiled every time. */
+        if (!(temp_path = malloc(strlen(output_path) + sizeof(".tmp"))))
+        {
+            fprintf(stderr, "could not allocate %zu bytes\n", strlen(output_path) + sizeof(".tmp"));
+            goto exit;
+        }
+        sprintf(temp_path, "%s.tmp", output_path);
+
+        output_file = fopen(temp_path, "w");
         if (output_file == NULL)
         {
-            fprintf(stderr, "could not open '%s' for writing\n", output_path);
+            fprintf(stderr, "could not open '%s' for writing\n", temp_path);
             goto exit;
         }
     }
     fprint_trainers(output_path, output_file, &parsed);
 
+    if (temp_path)
+    {
+        if (fclose(output_file) != 0)
+        {
+            output_file = NULL;
+            fprintf(stderr, "could not write '%s'\n", temp_path);
+            goto exit;
+        }
+        output_file = NULL;
+
+        if (same_contents(temp_path, output_path))
+        {
+            remove(temp_path);
+        }
+        else if (rename(temp_path, output_path) != 0)
+        {
+            fprintf(stderr, "could not rename '%s' to '%s'\n", temp_path, output_path);
+            goto exit;
+        }
+    }
+
     status = 0;
 
 exit:
     if (output_file) fclose(output_file);
+    if (temp_path) free(temp_path);
     if (parsed.trainers) free(parsed.trainers);
     if (source_buffer) free(source_buffer);
     if (source_file) fclose(source_file);